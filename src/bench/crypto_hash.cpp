@@ -11,12 +11,14 @@
 #include <crypto/sha3.h>
 #include <crypto/sha512.h>
 #include <crypto/siphash.h>
+#include <kernel/coinstats.h>
 #include <random.h>
 #include <span.h>
 #include <tinyformat.h>
 #include <uint256.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 /* Number of bytes to hash per iteration */
@@ -249,6 +251,38 @@ static void MuHashPrecompute(benchmark::Bench& bench)
     });
 }
 
+/* Number of set elements accumulated per iteration */
+static constexpr int MUHASH_ELEMENTS{4096};
+
+static void MuHashInsertMany(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    std::vector<unsigned char> data{rng.randbytes(MUHASH_ELEMENTS * 64)};
+
+    bench.batch(MUHASH_ELEMENTS).unit("element").run([&] {
+        MuHash3072 acc;
+        for (int i = 0; i < MUHASH_ELEMENTS; ++i) {
+            acc.Insert(std::span{data}.subspan(i * 64, 64));
+        }
+        ankerl::nanobench::doNotOptimizeAway(acc);
+    });
+}
+
+static void MuHashAccumulatorInsertMany(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    std::vector<unsigned char> data{rng.randbytes(MUHASH_ELEMENTS * 64)};
+    kernel::MuHashAccumulator acc;
+
+    bench.name(strprintf("%s using %d worker threads", __func__, kernel::MuHashAccumulator::DefaultWorkerThreads()));
+    bench.batch(MUHASH_ELEMENTS).unit("element").run([&] {
+        for (int i = 0; i < MUHASH_ELEMENTS; ++i) {
+            acc.Insert(std::span{data}.subspan(i * 64, 64));
+        }
+        ankerl::nanobench::doNotOptimizeAway(acc.Finish());
+    });
+}
+
 static void MuHashFinalize(benchmark::Bench& bench)
 {
     FastRandomContext rng(true);
@@ -286,3 +320,5 @@ BENCHMARK(MuHashMul, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashDiv, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashPrecompute, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashFinalize, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MuHashInsertMany, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MuHashAccumulatorInsertMany, benchmark::PriorityLevel::HIGH);
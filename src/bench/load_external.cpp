@@ -5,8 +5,10 @@
 #include <bench/bench.h>
 #include <bench/data/block413567.raw.h>
 #include <chainparams.h>
+#include <coordinate/signed_block.h>
 #include <flatfile.h>
 #include <node/blockstorage.h>
+#include <primitives/block.h>
 #include <span.h>
 #include <streams.h>
 #include <test/util/setup_common.h>
@@ -22,30 +24,20 @@
 #include <vector>
 
 /**
- * The LoadExternalBlockFile() function is used during -reindex and -loadblock.
- *
- * Create a test file that's similar to a datadir/blocks/blk?????.dat file,
- * It contains around 134 copies of the same block (typical size of real block files).
- * For each block in the file, LoadExternalBlockFile() won't find its parent,
- * and so will skip the block. (In the real system, it will re-read the block
- * from disk later when it encounters its parent.)
- *
- * This benchmark measures the performance of deserializing the block (or just
- * its header, beginning with PR 16981).
+ * Write a test file of about 128 MB holding copies of one serialized block
+ * and run LoadExternalBlockFile() over it.
  */
-static void LoadExternalBlockFile(benchmark::Bench& bench)
+static void RunLoadExternalBlockFile(benchmark::Bench& bench, const TestingSetup& testing_setup, std::span<const std::byte> block_data)
 {
-    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
-
     // Create a single block as in the blocks files (magic bytes, block size,
     // block data) as a stream object.
-    const fs::path blkfile{testing_setup.get()->m_path_root / "blk.dat"};
+    const fs::path blkfile{testing_setup.m_path_root / "blk.dat"};
     DataStream ss{};
-    auto params{testing_setup->m_node.chainman->GetParams()};
+    auto params{testing_setup.m_node.chainman->GetParams()};
     ss << params.MessageStart();
-    ss << static_cast<uint32_t>(benchmark::data::block413567.size());
+    ss << static_cast<uint32_t>(block_data.size());
     // Use span-serialization to avoid writing the size first.
-    ss << std::span{benchmark::data::block413567};
+    ss << block_data;
 
     // Create the test file.
     {
@@ -66,9 +58,71 @@ static void LoadExternalBlockFile(benchmark::Bench& bench)
         // "rb" is "binary, O_RDONLY", positioned to the start of the file.
         // The file will be closed by LoadExternalBlockFile().
         AutoFile file{fsbridge::fopen(blkfile, "rb")};
-        testing_setup->m_node.chainman->LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+        testing_setup.m_node.chainman->LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
     });
     fs::remove(blkfile);
 }
 
+/**
+ * The LoadExternalBlockFile() function is used during -reindex and -loadblock.
+ *
+ * Create a test file that's similar to a datadir/blocks/blk?????.dat file,
+ * It contains around 134 copies of the same block (typical size of real block files).
+ * For each block in the file, LoadExternalBlockFile() won't find its parent,
+ * and so will skip the block. (In the real system, it will re-read the block
+ * from disk later when it encounters its parent.)
+ *
+ * This benchmark measures the performance of deserializing the block (or just
+ * its header, beginning with PR 16981).
+ */
+static void LoadExternalBlockFile(benchmark::Bench& bench)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
+    RunLoadExternalBlockFile(bench, *testing_setup, benchmark::data::block413567);
+}
+
+/**
+ * Same as above, but every block builds on genesis and carries pegins and a
+ * preconfBlock of signed blocks, so each one is fully deserialized and put
+ * through the context-free checks (it then fails proof of work in
+ * AcceptBlock and is never stored, so every iteration does the same work).
+ *
+ * This benchmark measures decoding the Coordinate block payloads during
+ * -reindex and -loadblock.
+ */
+static void LoadExternalBlockFileCoordinate(benchmark::Bench& bench)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
+
+    // Reuse the transactions of block 413567 as a realistic payload.
+    SpanReader reader{benchmark::data::block413567};
+    CBlock block;
+    reader >> AsBase<CBlockHeader>(block);
+    std::vector<CTransactionRef> txs;
+    reader >> TX_WITH_WITNESS(txs);
+
+    block.hashPrevBlock = testing_setup->m_node.chainman->GetParams().GetConsensus().hashGenesisBlock;
+    // Split the transactions between the block itself, a handful of pegins
+    // and a preconfBlock of signed blocks.
+    constexpr size_t PEGINS{8};
+    constexpr size_t SIGNED_BLOCKS{10};
+    const size_t block_txs{txs.size() / 4};
+    block.vtx.assign(txs.begin(), txs.begin() + block_txs);
+    block.pegins.assign(txs.begin() + block_txs, txs.begin() + block_txs + PEGINS);
+    const size_t per_signed_block{(txs.size() - block_txs - PEGINS) / SIGNED_BLOCKS};
+    for (size_t i = 0; i < SIGNED_BLOCKS; ++i) {
+        SignedBlock signed_block;
+        signed_block.nHeight = i + 1;
+        const auto first{txs.begin() + block_txs + PEGINS + i * per_signed_block};
+        signed_block.vtx.assign(first, first + per_signed_block);
+        block.preconfBlock.push_back(std::move(signed_block));
+    }
+    block.currentIndex = 0;
+
+    DataStream block_data{};
+    block_data << TX_WITH_WITNESS(block);
+    RunLoadExternalBlockFile(bench, *testing_setup, block_data);
+}
+
 BENCHMARK(LoadExternalBlockFile, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LoadExternalBlockFileCoordinate, benchmark::PriorityLevel::HIGH);
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <compat/compat.h>
+#include <util/check.h>
+#include <util/fs_helpers.h>
+#include <util/sock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/socket.h>
+#endif
+
+// Peers connected to the node, of which only a few have sent something that is not
+// read yet, like the socket handler of a node with many mostly idle inbound peers.
+static constexpr int WAIT_PEERS{2000};
+static constexpr int WAIT_ACTIVE_PEERS{10};
+
+struct SockPairs {
+    /** The node's end of each connection, to wait on. */
+    std::vector<std::shared_ptr<const Sock>> local;
+    /** The peer's end of each connection. */
+    std::vector<std::unique_ptr<Sock>> remote;
+    Sock::EventsPerSock events_per_sock;
+
+    SockPairs()
+    {
+#ifndef WIN32
+        const int limit{RaiseFileDescriptorLimit(2 * WAIT_PEERS + 64)};
+        const int peers{std::min(WAIT_PEERS, (limit - 64) / 2)};
+        for (int i = 0; i < peers; ++i) {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) break;
+            local.push_back(std::make_shared<Sock>(fds[0]));
+            remote.push_back(std::make_unique<Sock>(fds[1]));
+            events_per_sock.emplace(local.back(), Sock::Events{Sock::RECV});
+        }
+        const unsigned char byte{0};
+        for (size_t i = 0; i < remote.size(); i += std::max<size_t>(remote.size() / WAIT_ACTIVE_PEERS, 1)) {
+            Assert(remote[i]->Send(&byte, 1, 0) == 1);
+        }
+#endif
+    }
+};
+
+static void SockWaitManyIdlePeers(benchmark::Bench& bench)
+{
+    SockPairs pairs;
+    if (pairs.local.empty()) return;
+    bench.run([&] {
+        Assert(pairs.local[0]->WaitMany(std::chrono::milliseconds{0}, pairs.events_per_sock));
+    });
+}
+
+static void SockWaitSetIdlePeers(benchmark::Bench& bench)
+{
+    SockPairs pairs;
+    auto wait_set{SockWaitSet::Make()};
+    if (pairs.local.empty() || !wait_set) return;
+    bench.run([&] {
+        Assert(wait_set->Update(pairs.events_per_sock));
+        Assert(wait_set->Wait(std::chrono::milliseconds{0}, pairs.events_per_sock));
+    });
+}
+
+BENCHMARK(SockWaitManyIdlePeers, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SockWaitSetIdlePeers, benchmark::PriorityLevel::HIGH);
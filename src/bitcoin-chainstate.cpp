@@ -124,6 +124,7 @@ int main(int argc, char* argv[])
             .path = abs_datadir / "blocks" / "index",
             .cache_bytes = cache_sizes.block_tree_db,
         },
+        .auxpow_cache_bytes = cache_sizes.auxpow,
     };
     util::SignalInterrupt interrupt;
     ChainstateManager chainman{interrupt, chainman_opts, blockman_opts};
@@ -21,13 +21,10 @@ CBlockHeader CBlockIndex::GetBlockHeader(const node::BlockManager& blockman) con
     block.nVersion = nVersion;
 
     /* The CBlockIndex object's block header is missing the auxpow.
-       So if this is an auxpow block, read it from disk instead.  We only
-       have to read the actual *header*, not the full block.  */
+       So if this is an auxpow block, take it from the block manager, which
+       only reads the header from disk when it is not cached.  */
     if (block.IsAuxpow())
-    {
-        blockman.ReadBlockHeader(block, *this);
-        return block;
-    }
+        block.auxpow = blockman.GetAuxpow(*this);
 
     if (pprev)
         block.hashPrevBlock = pprev->GetBlockHash();
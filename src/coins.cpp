@@ -5,6 +5,7 @@
 #include <coins.h>
 
 #include <consensus/consensus.h>
+#include <coordinate/coordinate_assets.h>
 #include <logging.h>
 #include <random.h>
 #include <util/trace.h>
@@ -130,51 +131,54 @@ void AddCoins(CCoinsViewCache& cache, const CTransaction& tx, int nHeight, const
         cache.AddCoin(tx.vin[0].prevout, Coin(CTxOut(value, CScript(stack[0].begin(), stack[0].end())), nHeight, fCoinbase, false, false, false, true, std::vector<unsigned char>{}), false);
     }
 
-    if (amountAssetIn > 0) {
-            
-        // One of the input coins is a BitAsset, coins adding up to the asset
-        // input amount will be marked as BitAssets
-        if(tx.version == TRANSACTION_PRECONF_VERSION && !tx.IsCoinBase()) {
-            bool overwrite = check_for_overwrite ? cache.HaveCoin(COutPoint(txid, 0)) : fCoinbase;
-            CTxOut refund(preconfRefund, tx.vout[0].scriptPubKey);
-            cache.AddCoin(COutPoint(txid, 0), Coin(refund, nHeight, fCoinbase, false, false, true, false, std::vector<unsigned char>{}), overwrite);
-        }
+    // The first two outputs of a BitAsset creation transaction are
+    // 0: controller output
+    // 1: genesis output
+    // If one of the input coins is a BitAsset, outputs adding up to the asset
+    // input amount are labelled as BitAssets instead
+    const bool fPreconf = tx.version == TRANSACTION_PRECONF_VERSION;
+    const std::vector<unsigned char>& nID = !nNewAssetID.empty() ? nNewAssetID : nAssetID;
+    const std::vector<std::pair<bool, bool>> flags{GetAssetOutputFlags(tx, amountAssetIn, nControlN)};
+    for (size_t i = 0; i < tx.vout.size(); ++i) {
+        const auto [fAsset, fControl] = flags[i];
+        bool overwrite = check_for_overwrite ? cache.HaveCoin(COutPoint(txid, i)) : fCoinbase;
+        Coin coin(tx.vout[i], nHeight, fCoinbase, fAsset, fControl, fPreconf, false, fAsset ? nID : std::vector<unsigned char>{});
+        // The first output of a preconf transaction holds the refund
+        if (fPreconf && i == 0 && !fCoinbase) coin.out.nValue = preconfRefund;
+        cache.AddCoin(COutPoint(txid, i), std::move(coin), overwrite);
+    }
+}
 
-        // Label BitAsset outputs until we account for all BitAsset input
+std::vector<std::pair<bool, bool>> GetAssetOutputFlags(const CTransaction& tx, const CAmount amountAssetIn, int nControlN)
+{
+    std::vector<std::pair<bool, bool>> flags(tx.vout.size(), {false, false});
+    if (amountAssetIn > 0) {
+        // The refund output of a preconf transaction is never an asset
         CAmount amountAssetOut = CAmount(0);
         size_t startValue = tx.version == TRANSACTION_PRECONF_VERSION ? 1 : 0;
         for (size_t i = startValue; i < tx.vout.size(); ++i) {
-            bool overwrite = check_for_overwrite ? cache.HaveCoin(COutPoint(txid, i)) : fCoinbase;
             bool fAsset = amountAssetIn > amountAssetOut;
-            bool fControl = nControlN >= 0 && (int)i == nControlN;
-            std::vector<unsigned char> nID = !nNewAssetID.empty() ? nNewAssetID : nAssetID;
-            cache.AddCoin(COutPoint(txid, i), Coin(tx.vout[i], nHeight, fCoinbase, fAsset, fControl, tx.version == TRANSACTION_PRECONF_VERSION ? true : false, false, fAsset ? nID : std::vector<unsigned char>{}), overwrite);
+            flags[i] = {fAsset, nControlN >= 0 && (int)i == nControlN};
             if (fAsset)
                 amountAssetOut += tx.vout[i].nValue;
         }
-    }
-    else
-    {
-        // The first two outputs of a BitAsset creation transaction are
-        // 0: controller output
-        // 1: genesis output
-        // The rest are normal outputs
-        bool fNewAsset = tx.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION;
-        for (size_t i = 0; i < tx.vout.size(); ++i) {
-            bool fAsset = fNewAsset && i < 2;
-            bool fControl = fNewAsset && i == 0;
-            std::vector<unsigned char> nID = !nNewAssetID.empty() ? nNewAssetID : nAssetID;
-            bool overwrite = check_for_overwrite ? cache.HaveCoin(COutPoint(txid, i)) : fCoinbase;
-            if(tx.version == TRANSACTION_PRECONF_VERSION && i == 0 && !tx.IsCoinBase()) {
-                CTxOut refund(preconfRefund, tx.vout[i].scriptPubKey);
-                cache.AddCoin(COutPoint(txid, i), Coin(refund, nHeight, fCoinbase, fAsset, fControl, tx.version == TRANSACTION_PRECONF_VERSION ? true : false, false, fAsset ? nID : std::vector<unsigned char>{}), overwrite);
-            } else {
-                cache.AddCoin(COutPoint(txid, i), Coin(tx.vout[i], nHeight, fCoinbase, fAsset, fControl, tx.version == TRANSACTION_PRECONF_VERSION ? true : false, false, fAsset ? nID : std::vector<unsigned char>{}), overwrite);
-            }
+    } else if (tx.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) {
+        // 0: controller output, 1: genesis output
+        for (size_t i = 0; i < tx.vout.size() && i < 2; ++i) {
+            flags[i] = {true, i == 0};
         }
     }
+    return flags;
 }
 
+std::vector<unsigned char> GetCreatedAssetId(const CTransaction& tx, int nHeight, uint16_t nAssetIndex, const std::vector<unsigned char>& nFirstInputAssetID, bool fFirstInputControl)
+{
+    // Only tokens can be minted again, by spending the asset controller as first input
+    if (tx.assetType != 0 || nFirstInputAssetID.empty()) {
+        return CreateAssetId(nHeight, nAssetIndex);
+    }
+    return fFirstInputControl ? nFirstInputAssetID : std::vector<unsigned char>{};
+}
 
 bool CCoinsViewCache::SpendCoin(const COutPoint& outpoint, bool& fBitAsset, bool& fBitAssetControl, bool& isPreconf, std::vector<unsigned char>& nAssetID, Coin* moveout)
 {
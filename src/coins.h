@@ -558,6 +558,16 @@ private:
 // (pre-BIP34) cases.
 void AddCoins(CCoinsViewCache& cache, const CTransaction& tx, int nHeight = 0, const CAmount preconfRefund = CAmount(0), std::vector<unsigned char> nAssetID = {}, const CAmount amountAssetIn = 0, int nControlN = -1, std::vector<unsigned char> nNewAssetID = {}, bool check = false);
 
+//! Asset flags (fBitAsset, fBitAssetControl) AddCoins gives to each output of a transaction,
+//! given the asset input amount and controller input position UpdateCoins collected.
+//! Indexes rebuilding asset outputs from block data use this to label outputs like the chainstate.
+std::vector<std::pair<bool, bool>> GetAssetOutputFlags(const CTransaction& tx, const CAmount amountAssetIn, int nControlN);
+
+//! Asset ID ConnectBlock assigns to the outputs of an asset creation transaction, the
+//! nAssetIndex-th one of its block. An additional token mint spending the asset controller
+//! as first input keeps the controlled asset ID, any other asset as first input mints nothing.
+std::vector<unsigned char> GetCreatedAssetId(const CTransaction& tx, int nHeight, uint16_t nAssetIndex, const std::vector<unsigned char>& nFirstInputAssetID, bool fFirstInputControl);
+
 //! Utility function to find any unspent output with a given txid.
 //! This function can be quite expensive because in the event of a transaction
 //! which is not found in the cache, it can cause up to MAX_OUTPUTS_PER_BLOCK
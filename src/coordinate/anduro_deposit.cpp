@@ -12,40 +12,72 @@
 #include <coordinate/anduro_deposit.h>
 #include <coordinate/anduro_validator.h>
 #include <coordinate/coordinate_pegin.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <atomic>
+#include <map>
 
 using node::BlockManager;
-// temporary storage for including precommitment signature on next block
-std::vector<AnduroPreCommitment> tCommitments;
+
+/**
+ * Precommitment signature held for an upcoming block, along with the hash of
+ * the block its signature was validated against (the block three below it).
+ */
+struct PendingCommitment {
+   AnduroPreCommitment commitment;
+   uint256 signedBlockHash; /*!< null when the commitment was not checked against a block (regtest) */
+};
+
+// guards the precommitment pool and the addresses taken from it
+static Mutex cs_commitments;
+// precommitment signatures for upcoming blocks, by block height. Every entry was validated on arrival.
+static std::map<int32_t, std::vector<PendingCommitment>> tCommitments GUARDED_BY(cs_commitments);
+// precommitment signatures of recently connected blocks, restored if the block is disconnected
+static std::map<int32_t, std::vector<PendingCommitment>> tExpiredCommitments GUARDED_BY(cs_commitments);
+// bumped whenever precommitments are added to the pool, so peers only get scanned for relay after a change
+static std::atomic<uint64_t> commitmentSequence{1};
 // check blocks are fully synced to active anduro presign validation
 bool isValidationActivate = false;
 // temporary storage for deposit address
-std::string depositAddress = "";
+static std::string depositAddress GUARDED_BY(cs_commitments) = "";
 // temporary storage for withdraw address
-std::string burnAddress = "";
+static std::string burnAddress GUARDED_BY(cs_commitments) = "";
 
 /**
  * Include precommitment signature from anduro.
  */
-void includePreCommitmentSignature(std::vector<AnduroPreCommitment> commitments) {
+bool includePreCommitmentSignature(const std::vector<AnduroPreCommitment>& commitments, ChainstateManager& chainman) {
    if (commitments.size() == 0) {
-      return;
+      return false;
    }
-   if(!isSignatureAlreadyExist(commitments[0])) {
-      for (const AnduroPreCommitment& commitment : commitments) {
-            tCommitments.push_back(commitment);
-            depositAddress = commitment.depositAddress;
-            burnAddress = commitment.burnAddress;
-      }
+   // peers keep answering with the same signatures; only validate new ones
+   if(isSignatureAlreadyExist(commitments[0])) {
+      return true;
    }
+   // hold cs_main so the chain the signatures are validated against can't change before they are stored
+   LOCK(cs_main);
+   if(!isPreCommitmentValid(commitments, chainman)) {
+      return false;
+   }
+   CChain& active_chain = chainman.ActiveChain();
+   LOCK(cs_commitments);
+   if(tCommitments.contains(commitments[0].block_height)) {
+      return true;
+   }
+   for (const AnduroPreCommitment& commitment : commitments) {
+      const int blockindex = commitment.block_height - 3;
+      const CBlockIndex* signedBlock = blockindex >= 0 ? active_chain[blockindex] : nullptr;
+      tCommitments[commitment.block_height].push_back({commitment, signedBlock ? signedBlock->GetBlockHash() : uint256{}});
+      depositAddress = commitment.depositAddress;
+      burnAddress = commitment.burnAddress;
+   }
+   ++commitmentSequence;
+   return true;
 }
 
-bool isSignatureAlreadyExist(AnduroPreCommitment commitment) {
-   bool isExist = false;
-   std::vector<AnduroPreCommitment> pending_commitments = listPendingCommitment(commitment.block_height);
-   if(pending_commitments.size() > 0) {
-      isExist = true;
-   }
-   return isExist;
+bool isSignatureAlreadyExist(const AnduroPreCommitment& commitment) {
+   return hasPendingCommitment(commitment.block_height);
 }
 
 bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, ChainstateManager& chainman) {
@@ -61,8 +93,7 @@ bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, Chainsta
    CChain& active_chain = chainman.ActiveChain();
 
    bool isValid = true;
-   
-   UniValue messages(UniValue::VARR);
+   const bool allowCompact = DeploymentActiveAfter(active_chain.Tip(), chainman, Consensus::DEPLOYMENT_COMPACT_WITNESS);
    // preparing message for signature verification
    for (const AnduroPreCommitment& commitment : commitments) {
       if(commitment.block_height <= active_chain.Height()) {
@@ -72,7 +103,7 @@ bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, Chainsta
       }
       int blockindex = commitment.block_height - 3;
       
-      if (blockindex < 0) {
+      if (blockindex < 0 || blockindex > active_chain.Height()) {
          LogPrintf("precommitment witness hold invalid block information\n");
          isValid = false;
          break;
@@ -83,7 +114,9 @@ bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, Chainsta
          LogPrintf("Error reading block from disk at index %d\n", active_chain[blockindex]->GetBlockHash().ToString());
          return false;
       }
-      isValid = validateAnduroSignature(commitment.witness,block.GetHash().ToString(),block.currentKeys);
+      const uint256 blockHash = block.GetHash();
+      isValid = validateFederationWitness(commitment.witness, [&blockHash] { return blockHash.ToString(); },
+                                          prepareCommitmentMessageHash(blockHash), block.currentKeys, /*majority=*/true, allowCompact);
       saveAddressInRegistry(chainman.ActiveChainstate(),commitment.depositAddress);
    }
 
@@ -99,35 +132,72 @@ bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, Chainsta
  * This function list all precommitment commitment details for upcoming blocks by height
  */
 std::vector<AnduroPreCommitment> listPendingCommitment(int32_t block_height) {
+    LOCK(cs_commitments);
+    std::vector<AnduroPreCommitment> tCommitmentsNew;
     if(block_height == -1) {
-        return tCommitments;
+        for (const auto& [height, pending] : tCommitments) {
+            for (const PendingCommitment& item : pending) {
+                tCommitmentsNew.push_back(item.commitment);
+            }
+        }
+        return tCommitmentsNew;
     }
-    std::vector<AnduroPreCommitment> tCommitmentsNew;
-    for (const AnduroPreCommitment& commitment : tCommitments) {
-        if(commitment.block_height == block_height) {
-            tCommitmentsNew.push_back(commitment);
+    const auto it = tCommitments.find(block_height);
+    if(it != tCommitments.end()) {
+        for (const PendingCommitment& item : it->second) {
+            tCommitmentsNew.push_back(item.commitment);
         }
     }
     return tCommitmentsNew;
 }
 
+/**
+ * Check whether precommitment signature exist for the block height
+ */
+bool hasPendingCommitment(int32_t block_height) {
+    LOCK(cs_commitments);
+    return tCommitments.contains(block_height);
+}
+
 /**
  * Used to reset precommitment signature for processed blocks
  */
-void resetCommitment(int32_t block_height, ChainstateManager& chainman) {
-   std::vector<AnduroPreCommitment> tCommitmentsNew;
-   for (const AnduroPreCommitment& commitment : tCommitments) {
-      if(commitment.block_height > block_height) {
-         tCommitmentsNew.push_back(commitment);
+void resetCommitment(int32_t block_height) {
+   LOCK(cs_commitments);
+   // commitments were validated on arrival, so the processed ones only need to move out of the pool
+   while (!tCommitments.empty() && tCommitments.begin()->first <= block_height) {
+      auto node = tCommitments.extract(tCommitments.begin());
+      tExpiredCommitments.insert_or_assign(node.key(), std::move(node.mapped()));
+   }
+   tExpiredCommitments.erase(tExpiredCommitments.begin(), tExpiredCommitments.lower_bound(block_height - MAX_COMMITMENT_REORG_DEPTH));
+}
+
+/**
+ * Used to restore precommitment signature when block disconnected from the active chain
+ */
+void reinsertCommitment(int32_t block_height, const uint256& block_hash) {
+   LOCK(cs_commitments);
+   // signatures made over the disconnected block no longer apply
+   if (auto it = tCommitments.find(block_height + 3); it != tCommitments.end()) {
+      std::erase_if(it->second, [&](const PendingCommitment& item) { return item.signedBlockHash == block_hash; });
+      if (it->second.empty()) {
+         tCommitments.erase(it);
       }
    }
-   if(isPreCommitmentValid(tCommitmentsNew,chainman)) {    
-      tCommitments = tCommitmentsNew;
-   } else {
-      tCommitments.clear();
+   // the disconnected block's signatures are needed again for its replacement
+   if (auto node = tExpiredCommitments.extract(block_height)) {
+      tCommitments.insert(std::move(node));
+      ++commitmentSequence;
    }
 }
 
+/**
+ * Used to get the precommitment pool sequence
+ */
+uint64_t getCommitmentSequence() {
+   return commitmentSequence;
+}
+
 /**
  * Used to get current keys to be signed for upcoming block
  */
@@ -180,7 +250,7 @@ bool verifyPreCommitment(ChainstateManager& chainman, const CBlock& block, int c
    }
    CChain& active_chain = chainman.ActiveChain();
    // activate precommitment signature checker after blocks fully synced in node
-   if(listPendingCommitment(currentHeight).size()>0) {
+   if(hasPendingCommitment(currentHeight)) {
          isValidationActivate = true;
    }
 
@@ -232,6 +302,7 @@ bool verifyPreCommitment(ChainstateManager& chainman, const CBlock& block, int c
  * Get recent bitcoin deposit address used to peg in
  */
 std::string getDepositAddress() {
+   LOCK(cs_commitments);
    return depositAddress;
 }
 
@@ -239,5 +310,6 @@ std::string getDepositAddress() {
  * Get sidechain withdrawal address used to peg out
  */
 std::string getBurnAddress() {
+   LOCK(cs_commitments);
    return burnAddress;
 }
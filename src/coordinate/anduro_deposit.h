@@ -18,6 +18,7 @@
 #include <primitives/transaction.h>
 #include <logging.h>
 #include <common/signmessage.h>
+#include <coordinate/federation_witness.h>
 
 /**
  *  This is call is used to receive or prepare anduro precommitment signature data along with anduro deposit and withdrawal address
@@ -55,7 +56,7 @@ public:
     }
 
     SERIALIZE_METHODS(AnduroPreCommitment, obj) {
-        READWRITE(obj.witness, obj.block_height, obj.nextKeys, obj.nextIndex, obj.depositAddress, obj.burnAddress);
+        READWRITE(Using<FederationWitnessFormatter>(obj.witness), obj.block_height, obj.nextKeys, obj.nextIndex, obj.depositAddress, obj.burnAddress);
     }
 
     void SetNull()
@@ -79,11 +80,16 @@ std::string getDepositAddress();
  */
 std::string getBurnAddress();
 
+/** Precommitment signatures of blocks this deep below the tip are dropped, they can no longer be restored on a reorg */
+static constexpr int32_t MAX_COMMITMENT_REORG_DEPTH{10};
+
 /**
- * This function include precommitments signature from anduro
+ * This function validate and include precommitments signature from anduro. Signatures already included are not validated again.
  * @param[in] commitments hold three block precommitment signature.
+ * @param[in] chainman  used to find the blocks the signatures belong to
+ * @return false if the signatures are invalid
  */
-void includePreCommitmentSignature(std::vector<AnduroPreCommitment> commitments);
+bool includePreCommitmentSignature(const std::vector<AnduroPreCommitment>& commitments, ChainstateManager& chainman);
 
 /**
  * This function check block are fully synced to start validating anduro new precommitment signature for upcoming blocks
@@ -109,14 +115,21 @@ bool isPreCommitmentValid(std::vector<AnduroPreCommitment> commitments, Chainsta
  * This function used to check whether precommitment signature already exist when received signature through peer message
  * @param[in] commitments  precommitment signature details
  */
-bool isSignatureAlreadyExist(AnduroPreCommitment commitments);
+bool isSignatureAlreadyExist(const AnduroPreCommitment& commitments);
 
 /**
  * This function used to reset presigned signature for processed blocks
- * @param[in] block_height  block height to clear presigned signature\
- * @param[in] chainman  used to find next block number and active chain state
+ * @param[in] block_height  block height to clear presigned signature
+ */
+void resetCommitment(int32_t block_height);
+
+/**
+ * This function used to restore presigned signature of a block disconnected from the active chain,
+ * and drop signatures that were validated against it
+ * @param[in] block_height  height of the disconnected block
+ * @param[in] block_hash  hash of the disconnected block
  */
-void resetCommitment(int32_t block_height, ChainstateManager& chainman);
+void reinsertCommitment(int32_t block_height, const uint256& block_hash);
 
 /**
  * This function used to get current keys to be signed for upcoming block
@@ -136,5 +149,16 @@ int32_t getCurrentIndex(ChainstateManager& chainman);
  */
 std::vector<AnduroPreCommitment> listPendingCommitment(int32_t block_height);
 
+/**
+ * This function check whether presigned details exist for upcoming block
+ * @param[in] block_height  block height to find pending pegin
+ */
+bool hasPendingCommitment(int32_t block_height);
+
+/**
+ * This function used to get a sequence number that changes whenever precommitments are added to the pool
+ */
+uint64_t getCommitmentSequence();
+
 
 #endif // BITCOIN_FEDERAITON_H
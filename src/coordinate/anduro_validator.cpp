@@ -5,6 +5,13 @@
 #include <rpc/util.h>
 #include <cmath>
 #include <secp256k1_schnorrsig.h>
+#include <hash.h>
+#include <limits>
+
+/** Leading byte of the compact federation witness and key set encodings */
+static constexpr unsigned char FEDERATION_COMPACT_VERSION{0x01};
+/** Size of a BIP340 signature in the compact witness */
+static constexpr size_t FEDERATION_SIGNATURE_SIZE{64};
 /**
  * Validate presigned signature
  */
@@ -149,3 +156,179 @@ bool getRedeemPathAvailable(std::vector<std::string> fullQuorum, std::string sig
 
     return isSignaturePathExist;
 }
+
+/**
+ * Compact encodings start with their version byte, hex encoded json always starts with '[' or '{'
+ */
+bool isCompactFederationEncoding(const std::string& hex) {
+    return hex.size() >= 2 && ParseHex(hex.substr(0, 2)) == std::vector<unsigned char>{FEDERATION_COMPACT_VERSION};
+}
+
+/**
+ * Prepare canonical message for preconf lists and signed blocks
+ */
+uint256 preparePreconfMessageHash(const std::vector<uint256>& txids, uint64_t signedBlockHeight, uint64_t minedBlockHeight) {
+    HashWriter hasher{TaggedHash("Coordinate/PreconfWitness")};
+    hasher << signedBlockHeight << minedBlockHeight << txids;
+    return hasher.GetSHA256();
+}
+
+/**
+ * Prepare canonical message for precommitments
+ */
+uint256 prepareCommitmentMessageHash(const uint256& blockHash) {
+    HashWriter hasher{TaggedHash("Coordinate/CommitmentWitness")};
+    hasher << blockHash;
+    return hasher.GetSHA256();
+}
+
+/**
+ * Read federation keys, compact key sets are the version byte, the key count and the x-only keys
+ */
+bool parseFederationKeys(const std::string& keysHex, bool allowCompact, std::vector<XOnlyPubKey>& keys) {
+    keys.clear();
+    if (isCompactFederationEncoding(keysHex)) {
+        if (!allowCompact) {
+            return false;
+        }
+        const std::vector<unsigned char> data(ParseHex(keysHex));
+        if (data.size() < 2 || data.size() != 2 + size_t{data[1]} * 32) {
+            LogPrintf("invalid compact federation keys \n");
+            return false;
+        }
+        for (size_t pos = 2; pos < data.size(); pos += 32) {
+            keys.emplace_back(std::span{data}.subspan(pos, 32));
+        }
+        return true;
+    }
+
+    std::vector<unsigned char> wData(ParseHex(keysHex));
+    const std::string keysStr(wData.begin(), wData.end());
+    UniValue keysVal(UniValue::VOBJ);
+    if (!keysVal.read(keysStr) || !keysVal.isObject() || !keysVal.find_value("all_keys").isArray()) {
+        LogPrintf("invalid witness params \n");
+        return false;
+    }
+    for (const UniValue& key : keysVal.find_value("all_keys").getValues()) {
+        if (!key.isStr() || !IsHex(key.get_str())) {
+            return false;
+        }
+        const CPubKey pubkey{ParseHex(key.get_str())};
+        if (!pubkey.IsFullyValid() || !pubkey.IsCompressed()) {
+            return false;
+        }
+        keys.emplace_back(pubkey);
+    }
+    return true;
+}
+
+/**
+ * Validate compact witness: version byte, a bitmap of signers in key order and their signatures in the same order
+ */
+bool validateCompactAnduroSignature(const std::string& witnessHex, const uint256& message, const std::vector<XOnlyPubKey>& keys, size_t threshold) {
+    const std::vector<unsigned char> data(ParseHex(witnessHex));
+    const size_t bitmapSize = (keys.size() + 7) / 8;
+    if (threshold == 0 || data.size() < 1 + bitmapSize || data[0] != FEDERATION_COMPACT_VERSION) {
+        LogPrintf("invalid compact witness \n");
+        return false;
+    }
+
+    std::vector<size_t> signers;
+    for (size_t i = 0; i < bitmapSize * 8; i++) {
+        if (data[1 + i / 8] & (1 << (i % 8))) {
+            // bits past the last key would make the encoding malleable
+            if (i >= keys.size()) return false;
+            signers.push_back(i);
+        }
+    }
+    if (signers.size() < threshold || data.size() != 1 + bitmapSize + signers.size() * FEDERATION_SIGNATURE_SIZE) {
+        LogPrintf("invalid compact witness signer count \n");
+        return false;
+    }
+
+    // every included signature has to be valid, so a witness has a single encoding
+    const std::span<const unsigned char> signatures = std::span{data}.subspan(1 + bitmapSize);
+    for (size_t s = 0; s < signers.size(); s++) {
+        if (!keys[signers[s]].VerifySchnorr(message, signatures.subspan(s * FEDERATION_SIGNATURE_SIZE, FEDERATION_SIGNATURE_SIZE))) {
+            LogPrintf("failed verfication \n");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Encode compact key set: version byte, the key count and the x-only keys
+ */
+bool encodeCompactFederationKeys(const std::vector<XOnlyPubKey>& keys, std::string& keysHex) {
+    if (keys.empty() || keys.size() > std::numeric_limits<uint8_t>::max()) {
+        return false;
+    }
+    std::vector<unsigned char> data{FEDERATION_COMPACT_VERSION, static_cast<unsigned char>(keys.size())};
+    for (const XOnlyPubKey& key : keys) {
+        data.insert(data.end(), key.begin(), key.end());
+    }
+    keysHex = HexStr(data);
+    return true;
+}
+
+/**
+ * Assemble compact witness, signatures are ordered by the position of their key in the federation
+ */
+bool encodeCompactAnduroWitness(const std::vector<XOnlyPubKey>& keys, const std::map<XOnlyPubKey, std::vector<unsigned char>>& signatures, std::string& witnessHex) {
+    const size_t bitmapSize = (keys.size() + 7) / 8;
+    std::vector<unsigned char> data(1 + bitmapSize, 0);
+    data[0] = FEDERATION_COMPACT_VERSION;
+    size_t included = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        const auto it = signatures.find(keys[i]);
+        if (it == signatures.end()) continue;
+        if (it->second.size() != FEDERATION_SIGNATURE_SIZE) {
+            return false;
+        }
+        data[1 + i / 8] |= 1 << (i % 8);
+        data.insert(data.end(), it->second.begin(), it->second.end());
+        included++;
+    }
+    // every signature has to belong to exactly one federation key
+    if (included == 0 || included != signatures.size()) {
+        return false;
+    }
+    witnessHex = HexStr(data);
+    return true;
+}
+
+/**
+ * Sign canonical message with the federation member keys and assemble compact witness
+ */
+bool signCompactAnduroWitness(const std::vector<XOnlyPubKey>& keys, const std::vector<CKey>& signers, const uint256& message, std::string& witnessHex) {
+    std::map<XOnlyPubKey, std::vector<unsigned char>> signatures;
+    for (const CKey& signer : signers) {
+        std::vector<unsigned char> sig(FEDERATION_SIGNATURE_SIZE);
+        if (!signer.IsValid() || !signer.SignSchnorr(message, sig, nullptr, uint256::ZERO)) {
+            return false;
+        }
+        signatures.emplace(XOnlyPubKey{signer.GetPubKey()}, std::move(sig));
+    }
+    return encodeCompactAnduroWitness(keys, signatures, witnessHex);
+}
+
+/**
+ * Validate federation witness in either encoding
+ */
+bool validateFederationWitness(const std::string& witnessHex, const std::function<std::string()>& legacyMessage, const uint256& compactMessage,
+                               const std::string& keysHex, bool majority, bool allowCompact) {
+    if (!isCompactFederationEncoding(witnessHex)) {
+        return majority ? validateAnduroSignature(witnessHex, legacyMessage(), keysHex) : validatePreconfSignature(witnessHex, legacyMessage(), keysHex);
+    }
+    if (!allowCompact) {
+        LogPrintf("compact witness not active \n");
+        return false;
+    }
+    std::vector<XOnlyPubKey> keys;
+    if (!parseFederationKeys(keysHex, allowCompact, keys)) {
+        return false;
+    }
+    const size_t threshold = majority ? keys.size() / 2 + 1 : 1;
+    return validateCompactAnduroSignature(witnessHex, compactMessage, keys, threshold);
+}
@@ -1,7 +1,10 @@
+#include <functional>
 #include <iostream>
 #include <util/strencodings.h>
 #include "pubkey.h"
+#include <key.h>
 #include <key_io.h>
+#include <map>
 
 /**
  * This function check witness signature path available in authorized anduro keys
@@ -30,4 +33,76 @@ bool validateAnduroSignature(std::string witnessHex, std::string message, std::s
  * @param[in] messageIn  sha256 presigned block message
  * @param[in] prevWitnessHex anduro current keys
 */
-bool validatePreconfSignature(std::string signatureHex, std::string messageIn, std::string prevWitnessHex);
\ No newline at end of file
+bool validatePreconfSignature(std::string signatureHex, std::string messageIn, std::string prevWitnessHex);
+/**
+ * This function check the witness or key set use the compact binary encoding instead of hex encoded json
+ * @param[in] hex  federation witness or key set
+ */
+bool isCompactFederationEncoding(const std::string& hex);
+
+/**
+ * This function prepare the canonical message signed in compact witness for preconf lists and signed blocks
+ * @param[in] txids  signed transaction ids, zero for the federation witness entry
+ * @param[in] signedBlockHeight  signed block height
+ * @param[in] minedBlockHeight  mined block height the federation keys are taken from
+ */
+uint256 preparePreconfMessageHash(const std::vector<uint256>& txids, uint64_t signedBlockHeight, uint64_t minedBlockHeight);
+
+/**
+ * This function prepare the canonical message signed in compact witness for precommitments
+ * @param[in] blockHash  mined block hash the precommitment refer to
+ */
+uint256 prepareCommitmentMessageHash(const uint256& blockHash);
+
+/**
+ * This function read federation keys in either encoding as x-only keys
+ * @param[in] keysHex  anduro current keys
+ * @param[in] allowCompact  accept the compact encoding
+ * @param[out] keys  federation keys in order
+ */
+bool parseFederationKeys(const std::string& keysHex, bool allowCompact, std::vector<XOnlyPubKey>& keys);
+
+/**
+ * This function validate compact witness, a signer bitmap followed by one 64 byte schnorr signature per signer
+ * @param[in] witnessHex  compact witness
+ * @param[in] message  canonical message hash
+ * @param[in] keys  federation keys the bitmap refers to
+ * @param[in] threshold  required number of signers
+ */
+bool validateCompactAnduroSignature(const std::string& witnessHex, const uint256& message, const std::vector<XOnlyPubKey>& keys, size_t threshold);
+
+/**
+ * This function encode federation keys as compact key set
+ * @param[in] keys  federation keys in order, at most 255
+ * @param[out] keysHex  compact key set
+ */
+bool encodeCompactFederationKeys(const std::vector<XOnlyPubKey>& keys, std::string& keysHex);
+
+/**
+ * This function assemble compact witness from federation signatures over the canonical message
+ * @param[in] keys  federation keys the bitmap refers to
+ * @param[in] signatures  64 byte schnorr signature of each signing federation key
+ * @param[out] witnessHex  compact witness
+ */
+bool encodeCompactAnduroWitness(const std::vector<XOnlyPubKey>& keys, const std::map<XOnlyPubKey, std::vector<unsigned char>>& signatures, std::string& witnessHex);
+
+/**
+ * This function sign the canonical message with federation keys and assemble compact witness
+ * @param[in] keys  federation keys the bitmap refers to
+ * @param[in] signers  private keys of the signing federation members
+ * @param[in] message  canonical message hash
+ * @param[out] witnessHex  compact witness
+ */
+bool signCompactAnduroWitness(const std::vector<XOnlyPubKey>& keys, const std::vector<CKey>& signers, const uint256& message, std::string& witnessHex);
+
+/**
+ * This function validate federation witness in either encoding, the compact one only once it is allowed
+ * @param[in] witnessHex  federation witness
+ * @param[in] legacyMessage  build the json message signed in the legacy encoding, only called for it
+ * @param[in] compactMessage  canonical message hash signed in the compact encoding
+ * @param[in] keysHex  anduro current keys
+ * @param[in] majority  require a majority of the federation, otherwise a single signer
+ * @param[in] allowCompact  compact federation witness deployment is active
+ */
+bool validateFederationWitness(const std::string& witnessHex, const std::function<std::string()>& legacyMessage, const uint256& compactMessage,
+                               const std::string& keysHex, bool majority, bool allowCompact);
@@ -1,3 +1,6 @@
+#ifndef BITCOIN_COORDINATEASSETS_H
+#define BITCOIN_COORDINATEASSETS_H
+
 #include <iostream>
 #include <serialize.h>
 #include <uint256.h>
@@ -79,4 +82,6 @@ public:
 
 std::vector<unsigned char> CreateAssetId(uint64_t blockNumber, uint16_t assetIndex);
 void ParseAssetId(const std::vector<unsigned char>& assetId, uint64_t &blockNumber, uint16_t &assetIndex);
-uint256 getAssetHash(const std::vector<unsigned char>& assetId);
\ No newline at end of file
+uint256 getAssetHash(const std::vector<unsigned char>& assetId);
+
+#endif // BITCOIN_COORDINATEASSETS_H
@@ -10,18 +10,47 @@
 #include <coordinate/coordinate_pegin.h>
 #include <undo.h>
 #include <merkleblock.h>
+#include <hash.h>
+#include <util/hasher.h>
+#include <util/signalinterrupt.h>
 #include <util/transaction_identifier.h>
+#include <validationinterface.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <optional>
+#include <unordered_set>
 
 using node::BlockManager;
 
 std::vector<CoordinatePreConfSig> coordinatePreConfSig;
-std::vector<SignedBlock> finalizedSignedBlocks;
+// sequence number of the last signature added to coordinatePreConfSig, never reused
+uint64_t preConfSigSequence{0};
+// finalized signed blocks and their relay state, both kept in the same order
+std::vector<SignedBlockRef> finalizedSignedBlocks;
 std::vector<SignedBlockPeer> finalizedSignedBlockPeers;
+// bumped whenever preconf signatures or signed blocks are added, so peers only get scanned for relay after a change
+std::atomic<uint64_t> preConfRelaySequence{1};
 
 CCoinsView coins_view;
 CCoinsViewCache preconfView(&coins_view);
 // temporary minfee
 CAmount preconfMinFee = DEFAULT_SIGNED_BLOCK_RESERVE;
+// clearing fees of the most recently connected signed blocks, oldest first, with the chain height they were connected at
+std::deque<std::pair<int, CAmount>> recentSignedBlockFees;
+// signed blocks whose federation witness already verified, see GetSignedBlockValidationKey
+std::unordered_set<uint256, BlockHasher> validatedSignedBlocks GUARDED_BY(cs_main);
+std::deque<uint256> validatedSignedBlockOrder GUARDED_BY(cs_main);
+
+// transaction fees of recently queried mined blocks, see getFeeForBlock
+struct MinedBlockFees {
+    // fee of each non-coinbase transaction, in block order
+    std::vector<std::pair<uint256, CAmount>> txFees;
+    CAmount peginFees{0};
+};
+std::unordered_map<uint256, MinedBlockFees, BlockHasher> minedBlockFees GUARDED_BY(cs_main);
+std::deque<uint256> minedBlockFeeOrder GUARDED_BY(cs_main);
 
 CoordinatePreConfBlock getNextPreConfSigList(ChainstateManager& chainman) {
     uint64_t signedBlockHeight = 0;
@@ -101,7 +130,7 @@ CoordinatePreConfBlock prepareRefunds(CTxMemPool& preconf_pool, CAmount finalFee
     return result;
 }
 
-bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, ChainstateManager& chainman) {
+bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, ChainstateManager& chainman, std::optional<int64_t> fromPeer) {
     LOCK(cs_main);
     CChain& active_chain = chainman.ActiveChain();
     CTxMemPool& preconf_pool{*chainman.ActiveChainstate().GetPreConfMempool()};
@@ -157,41 +186,45 @@ bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, Chainst
         LogPrintf("Error reading block from disk at index %d\n", active_chain[blockindex]->GetBlockHash().ToString());
     }
 
+    const bool allowCompact = DeploymentActiveAfter(active_chain.Tip(), chainman, Consensus::DEPLOYMENT_COMPACT_WITNESS);
     // check txid exist in preconf mempool
     for (const CoordinatePreConfSig& coordinatePreConfSigItem : preconf) {
-        UniValue messages(UniValue::VARR);
-        for (size_t i = 0; i < coordinatePreConfSigItem.txids.size(); i++){
-            UniValue message(UniValue::VOBJ);
-            if(coordinatePreConfSigItem.txids[i] != uint256::ZERO) {
-                if(!preconf_pool.exists(Txid::FromUint256(coordinatePreConfSigItem.txids[i]))) {
-                    LogPrintf("preconf txid not avilable in mempool \n");
-                    return false;
-                }
-                message.pushKV("txid",  coordinatePreConfSigItem.txids[i].ToString());
-            } else {
-                message.pushKV("txid", "");
-            }
-            message.pushKV("signed_block_height", coordinatePreConfSigItem.blockHeight);
-            message.pushKV("mined_block_height", coordinatePreConfSigItem.minedBlockHeight);
-            messages.push_back(message);
-        }
-        if(finalizedStatus == 1) {
-            if(!validateAnduroSignature(coordinatePreConfSigItem.witness,messages.write(),block.currentKeys)) {
+        for (const uint256& signedTxid : coordinatePreConfSigItem.txids) {
+            if(signedTxid != uint256::ZERO && !preconf_pool.exists(Txid::FromUint256(signedTxid))) {
+                LogPrintf("preconf txid not avilable in mempool \n");
                 return false;
             }
-        } else {
-            if(!validatePreconfSignature(coordinatePreConfSigItem.witness,messages.write(),block.currentKeys)) {
-                return false;
+        }
+        const auto legacyMessage = [&coordinatePreConfSigItem] {
+            UniValue messages(UniValue::VARR);
+            for (const uint256& signedTxid : coordinatePreConfSigItem.txids) {
+                UniValue message(UniValue::VOBJ);
+                message.pushKV("txid", signedTxid != uint256::ZERO ? signedTxid.ToString() : "");
+                message.pushKV("signed_block_height", coordinatePreConfSigItem.blockHeight);
+                message.pushKV("mined_block_height", coordinatePreConfSigItem.minedBlockHeight);
+                messages.push_back(message);
             }
+            return messages.write();
+        };
+        const uint256 compactMessage = preparePreconfMessageHash(coordinatePreConfSigItem.txids, coordinatePreConfSigItem.blockHeight, coordinatePreConfSigItem.minedBlockHeight);
+        if(!validateFederationWitness(coordinatePreConfSigItem.witness, legacyMessage, compactMessage, block.currentKeys, /*majority=*/finalizedStatus == 1, allowCompact)) {
+            return false;
         }
     }
 
 
 
     for (const CoordinatePreConfSig& preconfItem : preconf) {
-        coordinatePreConfSig.push_back(preconfItem);
+        insertPreConfSig(preconfItem);
+        if (fromPeer) {
+            coordinatePreConfSig.back().peerList.push_back(*fromPeer);
+        }
     }
-    
+
+    if (chainman.m_options.signals) {
+        chainman.m_options.signals->PreConfSignatureAccepted(preconf);
+    }
+
     return true;
 }
 
@@ -199,16 +232,18 @@ bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, Chainst
 bool includePreConfBlockFromNetwork(std::vector<SignedBlock> newFinalizedSignedBlocks, ChainstateManager& chainman) {
     for (const SignedBlock& newFinalizedSignedBlock : newFinalizedSignedBlocks) {
         uint64_t nHeight = newFinalizedSignedBlock.nHeight;
-        auto it = std::find_if(finalizedSignedBlocks.begin(), finalizedSignedBlocks.end(), 
-        [nHeight] (const SignedBlock& d) { 
-            return d.nHeight == nHeight;
+        // checked and connected under one lock, so the same height arriving from another
+        // peer or the RPC in between cannot be connected twice
+        LOCK(cs_main);
+        const bool known = std::any_of(finalizedSignedBlocks.begin(), finalizedSignedBlocks.end(),
+        [nHeight] (const SignedBlockRef& d) {
+            return d->nHeight == nHeight;
         });
-        if (it == finalizedSignedBlocks.end()) {
+        if (!known) {
             if (!checkSignedBlock(newFinalizedSignedBlock, chainman)) {
                 LogPrintf("signed block validity failed from network\n");
                 continue;
             }
-            LOCK(cs_main);
             if (!chainman.ActiveChainstate().ConnectSignedBlock(newFinalizedSignedBlock)) {
                 LogPrintf("signed block connect failed from network\n");
                 continue;
@@ -219,11 +254,22 @@ bool includePreConfBlockFromNetwork(std::vector<SignedBlock> newFinalizedSignedB
     return true;
 }
 
+void insertPreConfSig(CoordinatePreConfSig preconfItem) {
+    // relay state is local, don't keep the one sent by the peer
+    preconfItem.isBroadcasted = false;
+    preconfItem.peerList.clear();
+    preconfItem.nSequence = ++preConfSigSequence;
+    coordinatePreConfSig.push_back(std::move(preconfItem));
+    ++preConfRelaySequence;
+}
+
 void insertNewSignedBlock(const SignedBlock& newFinalizedSignedBlock) {
-    finalizedSignedBlocks.push_back(newFinalizedSignedBlock);
+    SignedBlockRef block = MakeSignedBlockRef(newFinalizedSignedBlock);
     SignedBlockPeer newPeer;
-    newPeer.hash = newFinalizedSignedBlock.GetHash();
+    newPeer.hash = block->GetHash();
+    finalizedSignedBlocks.push_back(std::move(block));
     finalizedSignedBlockPeers.push_back(newPeer);
+    ++preConfRelaySequence;
 }
 
 
@@ -232,28 +278,27 @@ void removePreConfWitness() {
 }
 
 void removePreConfFinalizedBlock(uint64_t blockHeight) {
-    std::vector<SignedBlock> newFinalizedSignedBlocks;
+    std::vector<SignedBlockRef> newFinalizedSignedBlocks;
     std::vector<SignedBlockPeer> newFinalizedSignedBlockPeers;
-    for (SignedBlock finalizedSignedBlock : finalizedSignedBlocks) {
-        if(static_cast<uint64_t>(finalizedSignedBlock.nHeight) > blockHeight) {
-            newFinalizedSignedBlocks.push_back(finalizedSignedBlock);
-            SignedBlockPeer newPeer;
-            newPeer.hash = finalizedSignedBlock.GetHash();
-            newFinalizedSignedBlockPeers.push_back(newPeer);
+    for (size_t i = 0; i < finalizedSignedBlocks.size(); i++) {
+        if(static_cast<uint64_t>(finalizedSignedBlocks[i]->nHeight) > blockHeight) {
+            newFinalizedSignedBlocks.push_back(std::move(finalizedSignedBlocks[i]));
+            // keep the relay state of the remaining blocks so they are not sent to the same peers again
+            newFinalizedSignedBlockPeers.push_back(std::move(finalizedSignedBlockPeers[i]));
         }
     }
-    finalizedSignedBlocks = newFinalizedSignedBlocks;
-    finalizedSignedBlockPeers = newFinalizedSignedBlockPeers;
+    finalizedSignedBlocks = std::move(newFinalizedSignedBlocks);
+    finalizedSignedBlockPeers = std::move(newFinalizedSignedBlockPeers);
 }
 /**
  * This is the function which used to get unbroadcasted preconfirmation signatures
  */
-std::vector<CoordinatePreConfSig> getUnBroadcastedPreConfSig() {
+std::vector<CoordinatePreConfSig> getUnBroadcastedPreConfSig(int64_t peerId) {
     std::vector<CoordinatePreConfSig> sigData;
-    for (CoordinatePreConfSig coordinatePreConfSigItem : coordinatePreConfSig) {
-        if(!coordinatePreConfSigItem.isBroadcasted) {
+    for (const CoordinatePreConfSig& coordinatePreConfSigItem : coordinatePreConfSig) {
+        if (std::find(coordinatePreConfSigItem.peerList.begin(), coordinatePreConfSigItem.peerList.end(), peerId) == coordinatePreConfSigItem.peerList.end()) {
             sigData.push_back(coordinatePreConfSigItem);
-        } 
+        }
     }
 
     return sigData;
@@ -262,16 +307,13 @@ std::vector<CoordinatePreConfSig> getUnBroadcastedPreConfSig() {
 /**
  * This is the function which used to get unbroadcasted preconfirmation signed block
  */
-std::vector<SignedBlock> getUnBroadcastedPreConfSignedBlock() {
-    std::vector<SignedBlock> sigData;
-    for (SignedBlockPeer finalizedSignedBlockPeer : finalizedSignedBlockPeers) {
-        if(!finalizedSignedBlockPeer.isBroadcasted) {
-            for (SignedBlock finalizedSignedBlock : finalizedSignedBlocks) {
-                if(finalizedSignedBlockPeer.hash == finalizedSignedBlock.GetHash()) {
-                    sigData.push_back(finalizedSignedBlock);
-                }
-            }
-        } 
+std::vector<SignedBlockRef> getUnBroadcastedPreConfSignedBlock(int64_t peerId) {
+    std::vector<SignedBlockRef> sigData;
+    for (size_t i = 0; i < finalizedSignedBlockPeers.size(); i++) {
+        const SignedBlockPeer& finalizedSignedBlockPeer = finalizedSignedBlockPeers[i];
+        if (std::find(finalizedSignedBlockPeer.peerList.begin(), finalizedSignedBlockPeer.peerList.end(), peerId) == finalizedSignedBlockPeer.peerList.end()) {
+            sigData.push_back(finalizedSignedBlocks[i]);
+        }
     }
     return sigData;
 }
@@ -284,15 +326,22 @@ std::vector<CoordinatePreConfSig> getPreConfSig() {
    return coordinatePreConfSig;
 }
 
+/**
+ * This is the function which used to visit preconfirmation signatures without copying them
+ */
+void forEachPreConfSig(const std::function<bool(const CoordinatePreConfSig&)>& visitor) {
+    for (const CoordinatePreConfSig& coordinatePreConfSigItem : coordinatePreConfSig) {
+        if (!visitor(coordinatePreConfSigItem)) break;
+    }
+}
+
 /**
  * This is the function which used change status for broadcasted preconf
  */
-void updateBroadcastedPreConf(CoordinatePreConfSig& preconfItem, int64_t peerId) {
+void updateBroadcastedPreConf(const CoordinatePreConfSig& preconfItem, int64_t peerId) {
     for (CoordinatePreConfSig& coordinatePreConfSigItem : coordinatePreConfSig) {
-        if(coordinatePreConfSigItem.witness.compare(preconfItem.witness)==0 && !coordinatePreConfSigItem.isBroadcasted) {
-            if (std::find(preconfItem.peerList.begin(), preconfItem.peerList.end(), peerId) != preconfItem.peerList.end()) {
-                coordinatePreConfSigItem.isBroadcasted = true;
-            } else {
+        if(coordinatePreConfSigItem.witness.compare(preconfItem.witness)==0) {
+            if (std::find(coordinatePreConfSigItem.peerList.begin(), coordinatePreConfSigItem.peerList.end(), peerId) == coordinatePreConfSigItem.peerList.end()) {
                 coordinatePreConfSigItem.peerList.push_back(peerId);
             }
             break;
@@ -303,12 +352,11 @@ void updateBroadcastedPreConf(CoordinatePreConfSig& preconfItem, int64_t peerId)
 /**
  * This is the function which used change status for broadcasted signed block
  */
-void updateBroadcastedSignedBlock(SignedBlock& signedBlockItem, int64_t peerId) {
+void updateBroadcastedSignedBlock(const SignedBlock& signedBlockItem, int64_t peerId) {
+    const uint256 hash = signedBlockItem.GetHash();
     for (SignedBlockPeer& finalizedSignedBlockPeer : finalizedSignedBlockPeers) {
-        if(signedBlockItem.GetHash() == finalizedSignedBlockPeer.hash && !finalizedSignedBlockPeer.isBroadcasted) {
-            if (std::find(finalizedSignedBlockPeer.peerList.begin(), finalizedSignedBlockPeer.peerList.end(), peerId) != finalizedSignedBlockPeer.peerList.end()) {
-                finalizedSignedBlockPeer.isBroadcasted = true;
-            } else {
+        if(hash == finalizedSignedBlockPeer.hash) {
+            if (std::find(finalizedSignedBlockPeer.peerList.begin(), finalizedSignedBlockPeer.peerList.end(), peerId) == finalizedSignedBlockPeer.peerList.end()) {
                 finalizedSignedBlockPeer.peerList.push_back(peerId);
             }
             break;
@@ -316,6 +364,13 @@ void updateBroadcastedSignedBlock(SignedBlock& signedBlockItem, int64_t peerId)
     }
 }
 
+/**
+ * This is the function which used to get the preconf relay sequence
+ */
+uint64_t getPreConfRelaySequence() {
+    return preConfRelaySequence;
+}
+
 /**
  * This is the function which used to get preconf vote information
  */
@@ -323,6 +378,40 @@ CAmount getPreConfMinFee() {
    return preconfMinFee;
 }
 
+/**
+ * This function record the clearing fee of a connected signed block
+ */
+void recordSignedBlockFee(int chainHeight, CAmount fee) {
+    AssertLockHeld(cs_main);
+    recentSignedBlockFees.emplace_back(chainHeight, fee);
+    while (recentSignedBlockFees.size() > PRECONF_FEE_HISTORY) {
+        recentSignedBlockFees.pop_front();
+    }
+}
+
+/**
+ * This function return clearing fees of the most recent signed blocks, newest first
+ */
+std::vector<CAmount> getRecentSignedBlockFees(size_t count) {
+    AssertLockHeld(cs_main);
+    std::vector<CAmount> fees;
+    fees.reserve(std::min(count, recentSignedBlockFees.size()));
+    for (auto it = recentSignedBlockFees.rbegin(); it != recentSignedBlockFees.rend() && fees.size() < count; ++it) {
+        fees.push_back(it->second);
+    }
+    return fees;
+}
+
+/**
+ * This function drop clearing fees of signed blocks connected on top of a disconnected block
+ */
+void rollbackSignedBlockFees(int chainHeight) {
+    AssertLockHeld(cs_main);
+    while (!recentSignedBlockFees.empty() && recentSignedBlockFees.back().first >= chainHeight) {
+        recentSignedBlockFees.pop_back();
+    }
+}
+
 /**
  * This function get new block template for signed block
  */
@@ -397,30 +486,36 @@ std::unique_ptr<SignedBlock> CreateNewSignedBlock(ChainstateManager& chainman, u
     return pblocktemplate;
 }
 
+/**
+ * The signed block hash only covers the header, so the key also commits to every transaction
+ * (the federation witness lives in the first one), to the mined block the keys are read from
+ * and to whether compact witnesses were accepted, which a reorg across their activation changes.
+ */
+static uint256 GetSignedBlockValidationKey(const SignedBlock& block, const uint256& minedBlockHash, bool allowCompact) {
+    HashWriter hasher{};
+    hasher << block.GetHash() << minedBlockHash << allowCompact;
+    for (const CTransactionRef& tx : block.vtx) {
+        hasher << tx->GetWitnessHash();
+    }
+    return hasher.GetSHA256();
+}
+
 bool checkSignedBlock(const SignedBlock& block, ChainstateManager& chainman) {
     LOCK(cs_main);
     CChain& active_chain = chainman.ActiveChain();
     int blockindex = block.blockIndex;
 
-    // check txid exist in preconf mempool
-    UniValue messages(UniValue::VARR);
-    //check signature is valid and include to queue
-    for (unsigned int i = 0; i < block.vtx.size(); i++) {
-        UniValue message(UniValue::VOBJ);
-        if(i == 0) {
-            message.pushKV("txid", "");
-        } else {
-            message.pushKV("txid", block.vtx[i]->GetHash().ToString());
-        }
-        message.pushKV("signed_block_height", block.nHeight);
-        message.pushKV("mined_block_height", block.blockIndex);
-
-        messages.push_back(message);
-    }
-    
-    if(blockindex < 0) {
+    if(blockindex < 0 || blockindex > active_chain.Height() || block.vtx.empty()) {
         return false;
     }
+
+    // a signed block is usually verified on arrival and again once a mined block includes it
+    const bool allowCompact = DeploymentActiveAfter(active_chain.Tip(), chainman, Consensus::DEPLOYMENT_COMPACT_WITNESS);
+    const uint256 validationKey = GetSignedBlockValidationKey(block, active_chain[blockindex]->GetBlockHash(), allowCompact);
+    if (validatedSignedBlocks.contains(validationKey)) {
+        return true;
+    }
+
     // get block to find the eligible anduro keys to be signed on presigned block
     CBlock minedblock;
     if (!chainman.m_blockman.ReadBlock(minedblock, *active_chain[blockindex])) {
@@ -438,10 +533,39 @@ bool checkSignedBlock(const SignedBlock& block, ChainstateManager& chainman) {
     }
     
     LogPrintf("validating signed block... \n");
-    if(!validateAnduroSignature(witnessStr,messages.write(),minedblock.currentKeys)) {
+    // the federation witness entry signs an empty txid
+    std::vector<uint256> signedTxids{uint256::ZERO};
+    for (unsigned int i = 1; i < block.vtx.size(); i++) {
+        signedTxids.push_back(block.vtx[i]->GetHash().ToUint256());
+    }
+    const auto legacyMessage = [&block] {
+        UniValue messages(UniValue::VARR);
+        for (unsigned int i = 0; i < block.vtx.size(); i++) {
+            UniValue message(UniValue::VOBJ);
+            if(i == 0) {
+                message.pushKV("txid", "");
+            } else {
+                message.pushKV("txid", block.vtx[i]->GetHash().ToString());
+            }
+            message.pushKV("signed_block_height", block.nHeight);
+            message.pushKV("mined_block_height", block.blockIndex);
+            messages.push_back(message);
+        }
+        return messages.write();
+    };
+    if(!validateFederationWitness(witnessStr, legacyMessage, preparePreconfMessageHash(signedTxids, block.nHeight, block.blockIndex),
+                                  minedblock.currentKeys, /*majority=*/true, allowCompact)) {
        removePreConfWitness();
        return false;
     }
+
+    if (validatedSignedBlocks.insert(validationKey).second) {
+        validatedSignedBlockOrder.push_back(validationKey);
+        if (validatedSignedBlockOrder.size() > MAX_VALIDATED_SIGNED_BLOCKS) {
+            validatedSignedBlocks.erase(validatedSignedBlockOrder.front());
+            validatedSignedBlockOrder.pop_front();
+        }
+    }
     return true;
 }
 
@@ -610,7 +734,7 @@ CAmount getPreconfFeeForBlock(ChainstateManager& chainman, int blockHeight) {
 
     for (size_t i = 0; i < prevblock.preconfBlock.size(); i++)
     {  
-        SignedBlock block = prevblock.preconfBlock[i];
+        const SignedBlock& block = prevblock.preconfBlock[i];
         for (size_t i = 0; i < block.vtx.size(); i++) {
             if(i==0) {
                 continue;
@@ -634,77 +758,52 @@ CAmount getPreconfFeeForFederation(std::vector<CTransactionRef> vtx, CAmount cur
      return fee;
 }
 
-CAmount getFeeForBlock(ChainstateManager& chainman, int blockHeight) {
-    LOCK(cs_main);
-    CChain& active_chain = chainman.ActiveChain();
-    if(blockHeight<3) {
-        return 0;
-    }
-
-    int currentHeight = blockHeight - 3;
-
+/**
+ * This function compute the fee of every transaction and pegin in a mined block
+ */
+static std::optional<MinedBlockFees> computeFeeForBlock(ChainstateManager& chainman, const CBlockIndex& index) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     CBlock prevblock;
-    if (!chainman.m_blockman.ReadBlock(prevblock, *active_chain[currentHeight])) {
-        return 0;
-    } 
-
-
-    CBlockUndo blockUndo;
-    if(!chainman.m_blockman.ReadBlockUndo(blockUndo, *active_chain[currentHeight])) {
-       return 0;
+    if (!chainman.m_blockman.ReadBlock(prevblock, index)) {
+        return std::nullopt;
     }
 
-    InvalidTx invalidTx;
-    chainman.ActiveChainstate().psignedblocktree->GetInvalidTx(currentHeight,invalidTx); 
-    CAmount totalFee = 0; 
+    const auto blockUndo{chainman.m_blockman.GetBlockUndo(index)};
+    if (!blockUndo) {
+        return std::nullopt;
+    }
 
-    for (size_t i = 0; i < prevblock.vtx.size(); ++i) {
+    MinedBlockFees fees;
+    fees.txFees.reserve(prevblock.vtx.size());
+    for (size_t i = 1; i < prevblock.vtx.size(); ++i) {
         const CTransactionRef& tx = prevblock.vtx.at(i);
         CAmount amt_total_in = 0;
         CAmount amt_total_out = 0;
-        if(i > 0) {
-            const CTxUndo* txundo = &blockUndo.vtxundo.at(i - 1);
-            const bool have_undo = txundo != nullptr;
-            if(invalidTx.invalidTxs.size()>0) {
-                uint256 invHash = tx->GetHash();
-                auto it = std::find_if(invalidTx.invalidTxs.begin(), invalidTx.invalidTxs.end(), 
-                [invHash] (const ReconciliationInvalidTx& d) { 
-                    return d.txHash == invHash;
-                });
-                if(it != invalidTx.invalidTxs.end()) {
-                    continue;
-                }
-            }
+        const CTxUndo& txundo = blockUndo->vtxundo.at(i - 1);
 
-
-            for (unsigned int ix = 0; ix < tx->vin.size(); ix++) {
-                if (have_undo) {
-                    const Coin& prev_coin = txundo->vprevout[ix];
-                    const CTxOut& prev_txout = prev_coin.out;
-                    if(!(tx->version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION && prev_coin.IsBitAssetController())) {
-                        amt_total_in += prev_txout.nValue;
-                    } 
-                }
+        for (unsigned int ix = 0; ix < tx->vin.size(); ix++) {
+            const Coin& prev_coin = txundo.vprevout[ix];
+            const CTxOut& prev_txout = prev_coin.out;
+            if(!(tx->version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION && prev_coin.IsBitAssetController())) {
+                amt_total_in += prev_txout.nValue;
             }
+        }
 
-            for (unsigned int ix = 0; ix < tx->vout.size(); ix++) {
-                const CTxOut& txout = tx->vout[ix];
-                if(tx->version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) {
-                    if(ix > 1) {
-                        amt_total_out += txout.nValue;
-                    }
-                } else if(tx->version == TRANSACTION_PRECONF_VERSION) {
-                    if(ix > 0) {
-                        amt_total_out += txout.nValue;
-                    }
-                } else {
+        for (unsigned int ix = 0; ix < tx->vout.size(); ix++) {
+            const CTxOut& txout = tx->vout[ix];
+            if(tx->version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) {
+                if(ix > 1) {
+                    amt_total_out += txout.nValue;
+                }
+            } else if(tx->version == TRANSACTION_PRECONF_VERSION) {
+                if(ix > 0) {
                     amt_total_out += txout.nValue;
                 }
+            } else {
+                amt_total_out += txout.nValue;
             }
-        
         }
 
-        totalFee = totalFee + (amt_total_in - amt_total_out);
+        fees.txFees.emplace_back(tx->GetHash(), amt_total_in - amt_total_out);
     }
 
     for (size_t i = 0; i < prevblock.pegins.size(); ++i) {
@@ -714,8 +813,56 @@ CAmount getFeeForBlock(ChainstateManager& chainman, int blockHeight) {
         stream >> value;
         const CTransaction& tx = *prevblock.pegins[i];
         CAmount fee = GetVirtualTransactionSize(tx) * PEGIN_FEE;
+        fees.peginFees = fees.peginFees + fee;
+    }
+    return fees;
+}
+
+CAmount getFeeForBlock(ChainstateManager& chainman, int blockHeight) {
+    LOCK(cs_main);
+    CChain& active_chain = chainman.ActiveChain();
+    if(blockHeight<3) {
+        return 0;
+    }
+
+    int currentHeight = blockHeight - 3;
+    const CBlockIndex& index = *active_chain[currentHeight];
+
+    // the fees of a block only change when it is reorged out, and then its hash is no longer queried;
+    // the template builder, block validation and signed block creation all ask for the same few blocks
+    auto it = minedBlockFees.find(index.GetBlockHash());
+    if (it == minedBlockFees.end()) {
+        std::optional<MinedBlockFees> fees = computeFeeForBlock(chainman, index);
+        if (!fees) {
+            return 0;
+        }
+        it = minedBlockFees.emplace(index.GetBlockHash(), std::move(*fees)).first;
+        minedBlockFeeOrder.push_back(index.GetBlockHash());
+        if (minedBlockFeeOrder.size() > MINED_BLOCK_FEE_CACHE_SIZE) {
+            minedBlockFees.erase(minedBlockFeeOrder.front());
+            minedBlockFeeOrder.pop_front();
+        }
+    }
+    const MinedBlockFees& fees = it->second;
+
+    // transactions found invalid by the federation may be recorded after the fees were computed
+    InvalidTx invalidTx;
+    chainman.ActiveChainstate().psignedblocktree->GetInvalidTx(currentHeight,invalidTx);
+    CAmount totalFee = 0;
+
+    for (const auto& [txHash, fee] : fees.txFees) {
+        if(invalidTx.invalidTxs.size()>0) {
+            auto invalid = std::find_if(invalidTx.invalidTxs.begin(), invalidTx.invalidTxs.end(),
+            [&txHash] (const ReconciliationInvalidTx& d) {
+                return d.txHash == txHash;
+            });
+            if(invalid != invalidTx.invalidTxs.end()) {
+                continue;
+            }
+        }
         totalFee = totalFee + fee;
     }
+    totalFee = totalFee + fees.peginFees;
 
     if(!MoneyRange(totalFee)) {
         return 0;
@@ -723,7 +870,14 @@ CAmount getFeeForBlock(ChainstateManager& chainman, int blockHeight) {
 
     return totalFee;
 
-} 
+}
+
+void removeFeeForBlock(const uint256& blockHash) {
+    LOCK(cs_main);
+    if (minedBlockFees.erase(blockHash)) {
+        std::erase(minedBlockFeeOrder, blockHash);
+    }
+}
 
 CScript getMinerScript(ChainstateManager& chainman, int blockHeight) {
     LOCK(cs_main);
@@ -767,10 +921,110 @@ CScript getFederationScript(ChainstateManager& chainman, int blockHeight) {
 /**
  * This is the function which used to get all finalized signed block
  */
-std::vector<SignedBlock> getFinalizedSignedBlocks() {
+std::vector<SignedBlockRef> getFinalizedSignedBlocks() {
     return finalizedSignedBlocks;
 }
 
+/**
+ * This is the function which used to get a page of finalized signed blocks
+ */
+std::vector<SignedBlockRef> getFinalizedSignedBlocks(uint64_t startHeight, size_t count) {
+    std::vector<SignedBlockRef> page;
+    for (const SignedBlockRef& finalizedSignedBlock : finalizedSignedBlocks) {
+        if (page.size() >= count) break;
+        if (finalizedSignedBlock->nHeight >= startHeight) {
+            page.push_back(finalizedSignedBlock);
+        }
+    }
+    return page;
+}
+
+bool getSignedBlockByHash(ChainstateManager& chainman, const uint256& hash, SignedBlock& block, CBlock& minedBlock) {
+    uint256 minedBlockHash;
+    if (chainman.ActiveChainstate().psignedblocktree->GetSignedBlockHash(hash, minedBlockHash)) {
+        bool haveMinedBlock = !minedBlock.IsNull() && minedBlock.GetHash() == minedBlockHash;
+        if (!haveMinedBlock) {
+            const CBlockIndex* pindex = WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(minedBlockHash));
+            haveMinedBlock = pindex && chainman.m_blockman.ReadBlock(minedBlock, *pindex);
+        }
+        if (haveMinedBlock) {
+            for (const SignedBlock& preconfBlockItem : minedBlock.preconfBlock) {
+                if (preconfBlockItem.GetHash() == hash) {
+                    block = preconfBlockItem;
+                    return true;
+                }
+            }
+        }
+    }
+
+    // signed block not yet included in a mined block
+    LOCK(cs_main);
+    auto it = std::find_if(finalizedSignedBlocks.begin(), finalizedSignedBlocks.end(),
+        [&hash] (const SignedBlockRef& d) {
+            return d->GetHash() == hash;
+        });
+    if (it == finalizedSignedBlocks.end()) {
+        return false;
+    }
+    block = **it;
+    return true;
+}
+
+bool getSignedBlockByHeight(ChainstateManager& chainman, uint64_t nHeight, SignedBlock& block, CBlock& minedBlock) {
+    uint256 signedBlockHash;
+    if (chainman.ActiveChainstate().psignedblocktree->GetSignedBlockHashByHeight(nHeight, signedBlockHash)) {
+        return getSignedBlockByHash(chainman, signedBlockHash, block, minedBlock);
+    }
+
+    LOCK(cs_main);
+    auto it = std::find_if(finalizedSignedBlocks.begin(), finalizedSignedBlocks.end(),
+        [nHeight] (const SignedBlockRef& d) {
+            return d->nHeight == nHeight;
+        });
+    if (it == finalizedSignedBlocks.end()) {
+        return false;
+    }
+    block = **it;
+    return true;
+}
+
+bool backfillSignedBlockHeights(ChainstateManager& chainman) {
+    SignedBlocksDB& signedBlockDB = *chainman.ActiveChainstate().psignedblocktree;
+    if (signedBlockDB.IsHeightIndexComplete()) {
+        return true;
+    }
+    const std::set<uint256> minedBlocks = signedBlockDB.GetSignedBlockMinedBlocks();
+    LogInfo("Indexing signed blocks by height, reading %u blocks\n", minedBlocks.size());
+    for (const uint256& minedBlockHash : minedBlocks) {
+        if (chainman.m_interrupt) {
+            return false;
+        }
+        const CBlockIndex* pindex = WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(minedBlockHash));
+        CBlock minedBlock;
+        // blocks that are pruned can't serve their signed blocks anyway
+        if (!pindex || !chainman.m_blockman.ReadBlock(minedBlock, *pindex)) {
+            continue;
+        }
+        std::vector<std::pair<uint64_t, uint256>> signedBlockHashes;
+        for (const SignedBlock& signedBlock : minedBlock.preconfBlock) {
+            signedBlockHashes.emplace_back(signedBlock.nHeight, signedBlock.GetHash());
+        }
+        // only the active chain decides which signed block a height maps to
+        LOCK(cs_main);
+        if (chainman.ActiveChain().Contains(pindex)) {
+            signedBlockDB.WriteSignedBlockHash(signedBlockHashes, minedBlockHash);
+        }
+        if (signedBlockDB.ShouldFlush() && !signedBlockDB.Flush()) {
+            return false;
+        }
+    }
+    if (!signedBlockDB.WriteHeightIndexComplete()) {
+        return false;
+    }
+    LogInfo("Indexed signed blocks by height\n");
+    return true;
+}
+
 CAmount getRefundForPreconfTx(const CTransaction& ptx, CAmount blockFee, CCoinsViewCache& inputs) {
     if(ptx.IsCoinBase()) {
         return 0;
@@ -1,4 +1,10 @@
+#ifndef BITCOIN_COORDINATEPRECONF_H
+#define BITCOIN_COORDINATEPRECONF_H
+
+#include <coordinate/federation_witness.h>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <uint256.h>
 #include <serialize.h>
 #include <validation.h>
@@ -62,7 +68,7 @@ inline void UnserializeCoordinatePreConfSig(CoordinatePreConfSigType& preconfDat
     s >> preconfData.txids;
     s >> preconfData.blockHeight;
     s >> preconfData.minedBlockHeight;
-    s >> preconfData.witness;
+    s >> Using<FederationWitnessFormatter>(preconfData.witness);
     s >> preconfData.isBroadcasted;
     s >> preconfData.peerList;
     s >> preconfData.federationKey;
@@ -74,7 +80,7 @@ inline void SerializeCoordinatePreConfSig(const CoordinatePreConfSigType& precon
     s << preconfData.txids;
     s << preconfData.blockHeight;
     s << preconfData.minedBlockHeight;
-    s << preconfData.witness;
+    s << Using<FederationWitnessFormatter>(preconfData.witness);
     s << preconfData.isBroadcasted;
     s << preconfData.peerList;
     s << preconfData.federationKey;
@@ -91,6 +97,7 @@ public:
     uint32_t finalized; /*!< 0 - not finalized by federation, 1 - finalized by federation */
     bool isBroadcasted; /*!< identify that it was broadcasted to the peers */
     std::vector<int64_t> peerList;  /*!< connected peer array that federation signed list sent through network*/
+    uint64_t nSequence{0}; /*!< local insertion order, not serialized, used as a stable paging cursor */
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -120,6 +127,7 @@ public:
         isBroadcasted = false;
         static_cast<void>(peerList.empty());
         federationKey = "";
+        nSequence = 0;
     }
 };
 
@@ -133,8 +141,9 @@ CoordinatePreConfBlock getNextPreConfSigList(ChainstateManager& chainman);
  * This function include preconf witness from anduro
  * @param[in] preconf hold three block presigned signature.
  * @param[in] chainman  used to find previous blocks based on active chain state to valid preconf signatures
+ * @param[in] fromPeer  peer the signatures were received from, they are not announced back to it once accepted
  */
-bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, ChainstateManager& chainman);
+bool includePreConfSigWitness(std::vector<CoordinatePreConfSig> preconf, ChainstateManager& chainman, std::optional<int64_t> fromPeer = std::nullopt);
 
 /**
  * This function include preconf witness from anduro
@@ -150,29 +159,37 @@ bool includePreConfBlockFromNetwork(std::vector<SignedBlock> newFinalizedSignedB
 void removePreConfSigWitness(ChainstateManager& chainman);
 
 /**
- * This is the function which used to get unbroadcasted preconfirmation signatures
+ * This is the function which used to get preconfirmation signatures not yet sent to or received from a peer
+ * @param[in] peerId  peer id to relay the signatures to
  */
-std::vector<CoordinatePreConfSig> getUnBroadcastedPreConfSig();
+std::vector<CoordinatePreConfSig> getUnBroadcastedPreConfSig(int64_t peerId);
 
 /**
- * This is the function which used to get unbroadcasted preconfirmation signed block
+ * This is the function which used to get preconfirmation signed blocks not yet sent to or received from a peer
+ * @param[in] peerId  peer id to relay the signed blocks to
  */
-std::vector<SignedBlock> getUnBroadcastedPreConfSignedBlock();
+std::vector<SignedBlockRef> getUnBroadcastedPreConfSignedBlock(int64_t peerId);
 
 /**
- * This is the function which used change status for broadcasted preconf
- * @param[in] preconfItem current preconf list send to network
- * @param[in] peerId  current preconf received peer id
+ * This is the function which used to record that a peer has the preconf signature
+ * @param[in] preconfItem preconf signature sent to or received from the network
+ * @param[in] peerId  peer id the preconf signature was exchanged with
  */
-void updateBroadcastedPreConf(CoordinatePreConfSig& preconfItem, int64_t peerId);
+void updateBroadcastedPreConf(const CoordinatePreConfSig& preconfItem, int64_t peerId);
 
 
 /**
- * This is the function which used change status for broadcasted signed block
- * @param[in] signedBlockItem current signed block list send to network
- * @param[in] peerId  current preconf received peer id
+ * This is the function which used to record that a peer has the signed block
+ * @param[in] signedBlockItem signed block sent to or received from the network
+ * @param[in] peerId  peer id the signed block was exchanged with
  */
-void updateBroadcastedSignedBlock(SignedBlock& signedBlockItem, int64_t peerId);
+void updateBroadcastedSignedBlock(const SignedBlock& signedBlockItem, int64_t peerId);
+
+/**
+ * This is the function which used to get a sequence number that changes whenever preconf signatures or
+ * signed blocks are added, so relay only needs to look for unsent entries after a change
+ */
+uint64_t getPreConfRelaySequence();
 
 
 
@@ -195,6 +212,18 @@ CoordinatePreConfBlock prepareRefunds(CTxMemPool& preconf_pool, CAmount finalFee
  */
 std::vector<CoordinatePreConfSig> getPreConfSig();
 
+/**
+ * This function visit preconfirmation signatures in place without copying the list
+ * @param[in] visitor called for each signature in order until it returns false
+ */
+void forEachPreConfSig(const std::function<bool(const CoordinatePreConfSig&)>& visitor);
+
+/**
+ * This function add a verified preconfirmation signature to the vote list
+ * @param[in] preconfItem signature to add, it gets the next sequence number and a fresh relay state
+ */
+void insertPreConfSig(CoordinatePreConfSig preconfItem);
+
 /**
  * This function remove old federation signature for memmory
  */
@@ -211,6 +240,34 @@ void removePreConfFinalizedBlock(uint64_t blockHeight);
  */
 CAmount getPreConfMinFee();
 
+/** Number of verified signed blocks remembered so they are not verified again when mined */
+static constexpr size_t MAX_VALIDATED_SIGNED_BLOCKS{1000};
+
+/** Number of mined blocks whose transaction fees are remembered by getFeeForBlock */
+static constexpr size_t MINED_BLOCK_FEE_CACHE_SIZE{8};
+
+/** Number of signed block clearing fees kept for preconf fee estimation */
+static constexpr size_t PRECONF_FEE_HISTORY{144};
+
+/**
+ * This function record the clearing fee of a connected signed block for fee estimation
+ * @param[in] chainHeight active chain height the signed block was connected at
+ * @param[in] fee clearing fee paid by preconf transactions in the signed block
+ */
+void recordSignedBlockFee(int chainHeight, CAmount fee) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+/**
+ * This function return clearing fees of the most recent signed blocks, newest first
+ * @param[in] count maximum number of signed blocks to return
+ */
+std::vector<CAmount> getRecentSignedBlockFees(size_t count) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+/**
+ * This function drop the clearing fees of signed blocks connected at or above a disconnected block
+ * @param[in] chainHeight height of the block being disconnected
+ */
+void rollbackSignedBlockFees(int chainHeight) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
 /**
  * This function get new block template for signed block
  * @param[in] chainman  used to find previous blocks based on active chain state
@@ -254,6 +311,12 @@ CAmount getPreconfFeeForBlock(ChainstateManager& chainman, int blockHeight);
  */
 CAmount getFeeForBlock(ChainstateManager& chainman, int blockHeight);
 
+/**
+ * This function forget the remembered transaction fees of a mined block, when it is disconnected
+ * @param[in] blockHash hash of the mined block
+ */
+void removeFeeForBlock(const uint256& blockHash);
+
 /**
  * This function will get miner details who solved the block using auxpow
  * @param[in] chainman  used to find previous blocks based on active chain state
@@ -271,7 +334,41 @@ CScript getFederationScript(ChainstateManager& chainman, int blockHeight);
 /**
  * This is the function which used to get all finalized signed block
  */
-std::vector<SignedBlock> getFinalizedSignedBlocks();
+std::vector<SignedBlockRef> getFinalizedSignedBlocks();
+
+/**
+ * This is the function which used to get a page of finalized signed blocks
+ * @param[in] startHeight lowest signed block height to return
+ * @param[in] count maximum number of signed blocks to return
+ */
+std::vector<SignedBlockRef> getFinalizedSignedBlocks(uint64_t startHeight, size_t count);
+
+/**
+ * This function find signed block by hash from the mined blocks or the finalized list
+ * @param[in] chainman  used to read the mined block which included the signed block
+ * @param[in] hash signed block hash
+ * @param[out] block signed block details
+ * @param[in,out] minedBlock last mined block read from disk, reused when it already holds the signed block
+ */
+bool getSignedBlockByHash(ChainstateManager& chainman, const uint256& hash, SignedBlock& block, CBlock& minedBlock);
+
+/**
+ * This function find signed block by height from the mined blocks or the finalized list
+ * @param[in] chainman  used to read the mined block which included the signed block
+ * @param[in] nHeight signed block height
+ * @param[out] block signed block details
+ * @param[in,out] minedBlock last mined block read from disk, reused when it already holds the signed block
+ */
+bool getSignedBlockByHeight(ChainstateManager& chainman, uint64_t nHeight, SignedBlock& block, CBlock& minedBlock);
+
+/**
+ * Write the height entries of signed blocks mined before the signed block
+ * database had them. Runs once, and can be interrupted and resumed.
+ *
+ * @param[in] chainman chainstate manager
+ * @return false on a read or write error, or when interrupted
+ */
+bool backfillSignedBlockHeights(ChainstateManager& chainman);
 
 /**
  * This function will insert new signed block in memory
@@ -300,4 +397,6 @@ CAmount getRefundForPreconfTx(const CTransaction& ptx, CAmount blockFee, CCoinsV
  * @param[in] blockFee signed block current fee
  * @param[in] inputs active coin tip
  */
-CAmount getRefundForPreconfCurrentTx(const CTransaction& ptx, CAmount blockFee, CCoinsViewCache& inputs);
\ No newline at end of file
+CAmount getRefundForPreconfCurrentTx(const CTransaction& ptx, CAmount blockFee, CCoinsViewCache& inputs);
+
+#endif // BITCOIN_COORDINATEPRECONF_H
@@ -0,0 +1,47 @@
+#ifndef BITCOIN_FEDERATIONWITNESS_H
+#define BITCOIN_FEDERATIONWITNESS_H
+
+#include <serialize.h>
+#include <util/strencodings.h>
+
+#include <string>
+#include <vector>
+
+/** Encoding of federation witnesses in serialized preconf signatures and precommitments */
+struct FederationWitnessSerParams {
+    const bool binary; /*!< raw witness bytes instead of the hex string */
+    SER_PARAMS_OPFUNC
+};
+static constexpr FederationWitnessSerParams FEDERATION_WITNESS_HEX{.binary = false};
+static constexpr FederationWitnessSerParams FEDERATION_WITNESS_BINARY{.binary = true};
+
+/**
+ * Formatter for a hex encoded federation witness, written as raw bytes when the stream uses
+ * FEDERATION_WITNESS_BINARY. Witnesses are kept as lowercase hex in memory, a witness that is
+ * not valid hex has no binary form and is written empty.
+ */
+struct FederationWitnessFormatter {
+    template <typename Stream>
+    void Ser(Stream& s, const std::string& witness)
+    {
+        if (s.template GetParams<FederationWitnessSerParams>().binary) {
+            s << TryParseHex<unsigned char>(witness).value_or(std::vector<unsigned char>{});
+        } else {
+            s << witness;
+        }
+    }
+
+    template <typename Stream>
+    void Unser(Stream& s, std::string& witness)
+    {
+        if (s.template GetParams<FederationWitnessSerParams>().binary) {
+            std::vector<unsigned char> bytes;
+            s >> bytes;
+            witness = HexStr(bytes);
+        } else {
+            s >> witness;
+        }
+    }
+};
+
+#endif // BITCOIN_FEDERATIONWITNESS_H
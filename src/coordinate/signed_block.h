@@ -7,6 +7,8 @@
 #include <consensus/amount.h>
 #include <primitives/transaction.h>
 
+#include <memory>
+
 class ReconciliationInvalidTx {
     public:
         uint256 txHash; /*!< invalid transaction hash */
@@ -73,13 +75,37 @@ class SignedBlockHeader {
         uint256 GetHash() const;
 };
 
+class SignedBlock;
+typedef std::shared_ptr<const SignedBlock> SignedBlockRef;
+
 class SignedBlock : public SignedBlockHeader{
+    private:
+        /** Only set for blocks that can no longer change, see MakeSignedBlockRef. Copies start without it. */
+        uint256 m_hash;
+
     public:
         std::vector<CTransactionRef> vtx; /*!< signed bock transaction list */
         SignedBlock() {
          SetNull();
         }
 
+        SignedBlock(const SignedBlock& other) : SignedBlockHeader{other}, vtx{other.vtx} {}
+        SignedBlock(SignedBlock&& other) noexcept : SignedBlockHeader{std::move(other)}, vtx{std::move(other.vtx)} {}
+        SignedBlock& operator=(const SignedBlock& other)
+        {
+            SignedBlockHeader::operator=(other);
+            vtx = other.vtx;
+            m_hash.SetNull();
+            return *this;
+        }
+        SignedBlock& operator=(SignedBlock&& other) noexcept
+        {
+            SignedBlockHeader::operator=(std::move(other));
+            vtx = std::move(other.vtx);
+            m_hash.SetNull();
+            return *this;
+        }
+
         SERIALIZE_METHODS(SignedBlock, obj) {  
             READWRITE(AsBase<SignedBlockHeader>(obj), obj.vtx);
         }
@@ -88,9 +114,22 @@ class SignedBlock : public SignedBlockHeader{
         {
             SignedBlockHeader::SetNull();
             vtx.clear();
+            m_hash.SetNull();
         }
+
+        uint256 GetHash() const { return m_hash.IsNull() ? SignedBlockHeader::GetHash() : m_hash; }
+
+        friend SignedBlockRef MakeSignedBlockRef(SignedBlock block);
 };
 
+/** Freeze a signed block for sharing, its hash is computed once here */
+inline SignedBlockRef MakeSignedBlockRef(SignedBlock block)
+{
+    auto ref = std::make_shared<SignedBlock>(std::move(block));
+    ref->m_hash = ref->SignedBlockHeader::GetHash();
+    return ref;
+}
+
 
 class SignedBlockPeer {
     public:
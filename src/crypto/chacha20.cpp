@@ -7,6 +7,7 @@
 
 #include <crypto/common.h>
 #include <crypto/chacha20.h>
+#include <compat/cpuid.h>
 #include <support/cleanse.h>
 #include <span.h>
 
@@ -14,6 +15,54 @@
 #include <bit>
 #include <cstring>
 
+#if defined(ENABLE_AVX2)
+namespace chacha20_avx2 {
+void Crypt8(const uint32_t* input, const std::byte* in, std::byte* out, size_t blocks);
+} // namespace chacha20_avx2
+#endif
+
+namespace {
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+bool HaveAVX2()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(0, 0, eax, ebx, ecx, edx);
+    if (eax < 7) return false;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    // AVX state must be enabled by the OS (OSXSAVE and XCR0 bits 1 and 2).
+    if (!((ecx >> 27) & 1) || !((ecx >> 28) & 1)) return false;
+    uint32_t xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 6) != 6) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+
+/** Minimum number of blocks for which the 8-way AVX2 code beats the scalar code. */
+constexpr size_t AVX2_MIN_BLOCKS{4};
+
+/** Produce the leading blocks of a request with the 8-way AVX2 code, advancing
+ * the block counter in input[8..9]. Returns the number of blocks done. */
+size_t CryptAVX2(uint32_t (&input)[12], const std::byte* in, std::byte* out, size_t blocks)
+{
+    static const bool use_avx2{HaveAVX2()};
+    if (!use_avx2) return 0;
+    size_t done{0};
+    while (blocks - done >= AVX2_MIN_BLOCKS) {
+        const size_t n{std::min<size_t>(blocks - done, 8)};
+        chacha20_avx2::Crypt8(input, in ? in + done * ChaCha20Aligned::BLOCKLEN : nullptr, out + done * ChaCha20Aligned::BLOCKLEN, n);
+        const uint64_t counter{(input[8] | (uint64_t{input[9]} << 32)) + n};
+        input[8] = counter;
+        input[9] = counter >> 32;
+        done += n;
+    }
+    return done;
+}
+#else
+size_t CryptAVX2(uint32_t (&)[12], const std::byte*, std::byte*, size_t) { return 0; }
+#endif
+} // namespace
+
 #define QUARTERROUND(a,b,c,d) \
   a += b; d = std::rotl(d ^ a, 16); \
   c += d; b = std::rotl(b ^ c, 12); \
@@ -63,6 +112,10 @@ inline void ChaCha20Aligned::Keystream(std::span<std::byte> output) noexcept
     size_t blocks = output.size() / BLOCKLEN;
     assert(blocks * BLOCKLEN == output.size());
 
+    const size_t vector_blocks = CryptAVX2(input, nullptr, c, blocks);
+    blocks -= vector_blocks;
+    c += vector_blocks * BLOCKLEN;
+
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
@@ -166,6 +219,11 @@ inline void ChaCha20Aligned::Crypt(std::span<const std::byte> in_bytes, std::spa
     size_t blocks = out_bytes.size() / BLOCKLEN;
     assert(blocks * BLOCKLEN == out_bytes.size());
 
+    const size_t vector_blocks = CryptAVX2(input, m, c, blocks);
+    blocks -= vector_blocks;
+    m += vector_blocks * BLOCKLEN;
+    c += vector_blocks * BLOCKLEN;
+
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
@@ -279,6 +337,14 @@ inline void ChaCha20Aligned::Crypt(std::span<const std::byte> in_bytes, std::spa
     }
 }
 
+std::span<std::byte> ChaCha20::RefillBuffer() noexcept
+{
+    const auto refill{std::span{m_buffer}.last(m_refill_blocks * m_aligned.BLOCKLEN)};
+    m_aligned.Keystream(refill);
+    m_refill_blocks = std::min(m_refill_blocks * 2, BUFFER_BLOCKS);
+    return refill;
+}
+
 void ChaCha20::Keystream(std::span<std::byte> out) noexcept
 {
     if (out.empty()) return;
@@ -294,9 +360,9 @@ void ChaCha20::Keystream(std::span<std::byte> out) noexcept
         out = out.subspan(blocks * m_aligned.BLOCKLEN);
     }
     if (!out.empty()) {
-        m_aligned.Keystream(m_buffer);
-        std::copy(m_buffer.begin(), m_buffer.begin() + out.size(), out.begin());
-        m_bufleft = m_aligned.BLOCKLEN - out.size();
+        const auto refill{RefillBuffer()};
+        std::copy(refill.begin(), refill.begin() + out.size(), out.begin());
+        m_bufleft = refill.size() - out.size();
     }
 }
 
@@ -308,7 +374,7 @@ void ChaCha20::Crypt(std::span<const std::byte> input, std::span<std::byte> outp
     if (m_bufleft) {
         unsigned reuse = std::min<size_t>(m_bufleft, input.size());
         for (unsigned i = 0; i < reuse; i++) {
-            output[i] = input[i] ^ m_buffer[m_aligned.BLOCKLEN - m_bufleft + i];
+            output[i] = input[i] ^ m_buffer[m_buffer.size() - m_bufleft + i];
         }
         m_bufleft -= reuse;
         output = output.subspan(reuse);
@@ -321,11 +387,11 @@ void ChaCha20::Crypt(std::span<const std::byte> input, std::span<std::byte> outp
         input = input.subspan(blocks * m_aligned.BLOCKLEN);
     }
     if (!input.empty()) {
-        m_aligned.Keystream(m_buffer);
+        const auto refill{RefillBuffer()};
         for (unsigned i = 0; i < input.size(); i++) {
-            output[i] = input[i] ^ m_buffer[i];
+            output[i] = input[i] ^ refill[i];
         }
-        m_bufleft = m_aligned.BLOCKLEN - input.size();
+        m_bufleft = refill.size() - input.size();
     }
 }
 
@@ -338,6 +404,7 @@ void ChaCha20::SetKey(std::span<const std::byte> key) noexcept
 {
     m_aligned.SetKey(key);
     m_bufleft = 0;
+    m_refill_blocks = 1;
     memory_cleanse(m_buffer.data(), m_buffer.size());
 }
 
@@ -77,9 +77,22 @@ public:
 class ChaCha20
 {
 private:
+    /** Maximum number of blocks of keystream generated at once for requests
+     * that end mid-block, so that many small reads (like FastRandomContext's)
+     * use the multi-block code. */
+    static constexpr unsigned BUFFER_BLOCKS{8};
+
     ChaCha20Aligned m_aligned;
-    std::array<std::byte, ChaCha20Aligned::BLOCKLEN> m_buffer;
+    /** Buffered keystream, of which the last m_bufleft bytes are unused. */
+    std::array<std::byte, ChaCha20Aligned::BLOCKLEN * BUFFER_BLOCKS> m_buffer;
     unsigned m_bufleft{0};
+    /** Blocks to generate on the next refill of m_buffer. This starts at one
+     * after a key or position change and doubles up to BUFFER_BLOCKS, so a
+     * few small reads do not pay for a full buffer. */
+    unsigned m_refill_blocks{1};
+
+    /** Refill the end of m_buffer with new keystream. Returns the refilled part. */
+    std::span<std::byte> RefillBuffer() noexcept;
 
 public:
     /** Expected key length in constructor and SetKey. */
@@ -105,6 +118,7 @@ public:
     {
         m_aligned.Seek(nonce, block_counter);
         m_bufleft = 0;
+        m_refill_blocks = 1;
     }
 
     /** en/deciphers the message <in_bytes> and write the result into <out_bytes>
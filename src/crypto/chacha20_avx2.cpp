@@ -0,0 +1,123 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace chacha20_avx2 {
+namespace {
+
+/** Vector i holds word i of the state of 8 consecutive blocks, one per lane. */
+__m256i inline K(uint32_t x) { return _mm256_set1_epi32(x); }
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+__m256i inline RotL(__m256i x, int n) { return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n)); }
+__m256i inline RotL16(__m256i x)
+{
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                                   2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+}
+__m256i inline RotL8(__m256i x)
+{
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                                   3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14));
+}
+
+void inline QuarterRound(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+{
+    a = Add(a, b); d = RotL16(Xor(d, a));
+    c = Add(c, d); b = RotL(Xor(b, c), 12);
+    a = Add(a, b); d = RotL8(Xor(d, a));
+    c = Add(c, d); b = RotL(Xor(b, c), 7);
+}
+
+/** Transpose 8 vectors of 8 words, so that out[i] holds lane i of every input. */
+void inline Transpose(const __m256i (&in)[8], __m256i (&out)[8])
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(in[0], in[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(in[0], in[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(in[2], in[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(in[2], in[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(in[4], in[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(in[4], in[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(in[6], in[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(in[6], in[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+void inline Write(std::byte* out, const std::byte* in, __m256i x)
+{
+    if (in) x = Xor(x, _mm256_loadu_si256((const __m256i*)in));
+    _mm256_storeu_si256((__m256i*)out, x);
+}
+
+} // namespace
+
+/** Compute the first `blocks` (at most 8) of 8 consecutive ChaCha20 blocks
+ * starting at the block counter in input[8..9], XORed with in unless it is
+ * nullptr. input holds the key, counter and nonce words as in ChaCha20Aligned.
+ */
+void Crypt8(const uint32_t* input, const std::byte* in, std::byte* out, size_t blocks)
+{
+    // The block counter is 64 bits wide here, carrying from word 12 into 13.
+    alignas(32) uint32_t counter_lo[8], counter_hi[8];
+    const uint64_t counter{input[8] | (uint64_t{input[9]} << 32)};
+    for (int i = 0; i < 8; ++i) {
+        counter_lo[i] = uint32_t(counter + i);
+        counter_hi[i] = uint32_t((counter + i) >> 32);
+    }
+
+    const __m256i j[16] = {
+        K(0x61707865), K(0x3320646e), K(0x79622d32), K(0x6b206574),
+        K(input[0]), K(input[1]), K(input[2]), K(input[3]),
+        K(input[4]), K(input[5]), K(input[6]), K(input[7]),
+        _mm256_load_si256((const __m256i*)counter_lo), _mm256_load_si256((const __m256i*)counter_hi),
+        K(input[10]), K(input[11]),
+    };
+    __m256i x[16];
+    for (int i = 0; i < 16; ++i) x[i] = j[i];
+
+    for (int round = 0; round < 10; ++round) {
+        QuarterRound(x[0], x[4], x[8], x[12]);
+        QuarterRound(x[1], x[5], x[9], x[13]);
+        QuarterRound(x[2], x[6], x[10], x[14]);
+        QuarterRound(x[3], x[7], x[11], x[15]);
+        QuarterRound(x[0], x[5], x[10], x[15]);
+        QuarterRound(x[1], x[6], x[11], x[12]);
+        QuarterRound(x[2], x[7], x[8], x[13]);
+        QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) x[i] = Add(x[i], j[i]);
+
+    // Turn the vectors of words into blocks: words 0..7 and 8..15 of block i.
+    __m256i lo[8], hi[8];
+    Transpose({x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]}, lo);
+    Transpose({x[8], x[9], x[10], x[11], x[12], x[13], x[14], x[15]}, hi);
+    for (size_t i = 0; i < blocks && i < 8; ++i) {
+        Write(out + 64 * i, in ? in + 64 * i : nullptr, lo[i]);
+        Write(out + 64 * i + 32, in ? in + 64 * i + 32 : nullptr, hi[i]);
+    }
+}
+
+} // namespace chacha20_avx2
+
+#endif // ENABLE_AVX2
@@ -6,9 +6,12 @@
 
 #include <crypto/chacha20.h>
 #include <crypto/common.h>
+#include <compat/cpuid.h>
 #include <hash.h>
 #include <util/check.h>
 
+#include <algorithm>
+#include <atomic>
 #include <bit>
 #include <cassert>
 #include <cstdio>
@@ -109,6 +112,88 @@ inline void addnextract2(limb_t& c0, limb_t& c1, const limb_t& a, limb_t& n)
     c1 = c2;
 }
 
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__) && defined(HAVE_GETCPUID)
+#define HAVE_MULX_ADX_MULTIPLY
+
+/** Whether the CPU supports MULX (BMI2) and ADCX/ADOX (ADX). */
+bool HaveMulxAdx()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(0, 0, eax, ebx, ecx, edx);
+    if (eax < 7) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return ((ebx >> 8) & 1) && ((ebx >> 19) & 1);
+}
+
+/* One step of MulAddRow: the high limb of the previous product is carried on
+ * the OF chain, the addition of the accumulator limb on the CF chain. */
+#define MULADD_STEP(j, hin, hout) \
+    "mulxq " #j "*8(%[b]), %[lo], %[" #hout "]\n\t" \
+    "adoxq %[" #hin "], %[lo]\n\t" \
+    "adcxq " #j "*8(%[t]), %[lo]\n\t" \
+    "movq %[lo], " #j "*8(%[t])\n\t"
+#define MULADD_STEP2(j0, j1) MULADD_STEP(j0, h0, h1) MULADD_STEP(j1, h1, h0)
+#define MULADD_STEP8(j0, j1, j2, j3, j4, j5, j6, j7) \
+    MULADD_STEP2(j0, j1) MULADD_STEP2(j2, j3) MULADD_STEP2(j4, j5) MULADD_STEP2(j6, j7)
+
+static_assert(LIMBS == 48, "MulAddRow is unrolled for 48 limbs");
+
+/** t[0..LIMBS] = t[0..LIMBS-1] + n * b, overwriting t[LIMBS]. */
+inline void MulAddRow(limb_t* t, const limb_t* b, limb_t n)
+{
+    limb_t lo, h0, h1;
+    __asm__ __volatile__(
+        "xorl %k[h0], %k[h0]\n\t" // also clears CF and OF
+        MULADD_STEP8(0, 1, 2, 3, 4, 5, 6, 7)
+        MULADD_STEP8(8, 9, 10, 11, 12, 13, 14, 15)
+        MULADD_STEP8(16, 17, 18, 19, 20, 21, 22, 23)
+        MULADD_STEP8(24, 25, 26, 27, 28, 29, 30, 31)
+        MULADD_STEP8(32, 33, 34, 35, 36, 37, 38, 39)
+        MULADD_STEP8(40, 41, 42, 43, 44, 45, 46, 47)
+        "movl $0, %k[lo]\n\t"
+        "adoxq %[lo], %[h0]\n\t"
+        "adcxq %[lo], %[h0]\n\t"
+        "movq %[h0], 48*8(%[t])\n\t"
+        : [lo] "=&r"(lo), [h0] "=&r"(h0), [h1] "=&r"(h1)
+        : [t] "r"(t), [b] "r"(b), "d"(n)
+        : "cc", "memory");
+}
+
+#undef MULADD_STEP8
+#undef MULADD_STEP2
+#undef MULADD_STEP
+
+/** r = a * b, reduced to LIMBS limbs but possibly not below the modulus.
+ *
+ * The full 6144-bit product is computed one row at a time with two
+ * independent carry chains, then folded once using
+ * 2^3072 = MAX_PRIME_DIFF (mod 2^3072 - MAX_PRIME_DIFF).
+ */
+void MultiplyMulxAdx(limb_t* r, const limb_t* a, const limb_t* b)
+{
+    limb_t t[2 * LIMBS + 1] = {0};
+    for (int i = 0; i < LIMBS; ++i) MulAddRow(t + i, b, a[i]);
+
+    limb_t hi[LIMBS];
+    std::copy(t + LIMBS, t + 2 * LIMBS, hi);
+    MulAddRow(t, hi, MAX_PRIME_DIFF);
+
+    /* Fold the limb above bit 3072 back in. If that overflows again, the
+     * low limbs have wrapped to a small value, so a final add cannot. */
+    double_limb_t acc = (double_limb_t)t[LIMBS] * MAX_PRIME_DIFF + t[0];
+    r[0] = acc;
+    limb_t carry = acc >> LIMB_SIZE;
+    for (int i = 1; i < LIMBS; ++i) {
+        r[i] = t[i] + carry;
+        carry = carry && r[i] == 0;
+    }
+    if (carry) r[0] += MAX_PRIME_DIFF;
+}
+
+/** Whether Num3072::Multiply uses MultiplyMulxAdx. */
+std::atomic<bool> g_use_mulx_adx{HaveMulxAdx()};
+#endif // __x86_64__ && __SIZEOF_INT128__ && HAVE_GETCPUID
+
 } // namespace
 
 /** Indicates whether d is larger than the modulus. */
@@ -452,8 +537,27 @@ Num3072 Num3072::GetInverse() const
     return ret;
 }
 
+bool Num3072::UseOptimizedMultiply(bool enable)
+{
+#ifdef HAVE_MULX_ADX_MULTIPLY
+    const bool use{enable && HaveMulxAdx()};
+    g_use_mulx_adx = use;
+    return use;
+#else
+    return false;
+#endif
+}
+
 void Num3072::Multiply(const Num3072& a)
 {
+#ifdef HAVE_MULX_ADX_MULTIPLY
+    if (g_use_mulx_adx.load(std::memory_order_relaxed)) {
+        MultiplyMulxAdx(this->limbs, this->limbs, a.limbs);
+        if (this->IsOverflow()) this->FullReduce();
+        return;
+    }
+#endif
+
     limb_t c0 = 0, c1 = 0, c2 = 0;
     Num3072 tmp;
 
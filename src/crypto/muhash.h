@@ -52,6 +52,10 @@ public:
     static_assert(sizeof(limb_t) == 4 || sizeof(limb_t) == 8, "bad size for limb_t");
 
     void Multiply(const Num3072& a);
+    /** Select whether Multiply uses a CPU specific implementation where one is
+     * supported, which is the default. Returns whether one is used. Only meant
+     * for comparing the implementations in tests and benchmarks. */
+    static bool UseOptimizedMultiply(bool enable);
     void Divide(const Num3072& a);
     void SetToOne();
     void ToBytes(unsigned char (&out)[BYTE_SIZE]);
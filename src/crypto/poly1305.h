@@ -16,12 +16,19 @@
 namespace poly1305_donna {
 
 // Based on the public domain implementation by Andrew Moon
-// poly1305-donna-32.h from https://github.com/floodyberry/poly1305-donna
+// poly1305-donna-64.h (where 128-bit integers are available, using 44-bit
+// limbs) or poly1305-donna-32.h from https://github.com/floodyberry/poly1305-donna
 
 typedef struct {
+#ifdef __SIZEOF_INT128__
+    uint64_t r[3];
+    uint64_t h[3];
+    uint64_t pad[2];
+#else
     uint32_t r[5];
     uint32_t h[5];
     uint32_t pad[4];
+#endif
     size_t leftover;
     unsigned char buffer[POLY1305_BLOCK_SIZE];
     unsigned char final;
@@ -10,6 +10,13 @@
 #include <tinyformat.h>
 #include <util/fs_helpers.h>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 FlatFileSeq::FlatFileSeq(fs::path dir, const char* prefix, size_t chunk_size) :
     m_dir(std::move(dir)),
     m_prefix(prefix),
@@ -112,3 +119,36 @@ bool FlatFileSeq::Flush(const FlatFilePos& pos, bool finalize) const
     }
     return true;
 }
+
+std::shared_ptr<const MappedFlatFile> MappedFlatFile::Open(const fs::path& path)
+{
+#ifndef WIN32
+    // Keeping many large files mapped needs a 64-bit address space.
+    if constexpr (sizeof(void*) < 8) return nullptr;
+
+    const int fd{open(path.c_str(), O_RDONLY)};
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat st;
+    void* addr{MAP_FAILED};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::shared_ptr<const MappedFlatFile>{new MappedFlatFile{{static_cast<const std::byte*>(addr), static_cast<size_t>(st.st_size)}}};
+#else
+    return nullptr;
+#endif
+}
+
+MappedFlatFile::~MappedFlatFile()
+{
+#ifndef WIN32
+    munmap(const_cast<std::byte*>(m_data.data()), m_data.size());
+#endif
+}
@@ -6,6 +6,9 @@
 #ifndef BITCOIN_FLATFILE_H
 #define BITCOIN_FLATFILE_H
 
+#include <cstddef>
+#include <memory>
+#include <span>
 #include <string>
 
 #include <serialize.h>
@@ -86,4 +89,31 @@ public:
     bool Flush(const FlatFilePos& pos, bool finalize = false) const;
 };
 
+/**
+ * A read-only memory mapping of a whole flat file. The mapping covers the file
+ * as it was when mapped, so this is only meant for files that are no longer
+ * appended to. Writes to the mapped range (in place) are visible through it.
+ */
+class MappedFlatFile
+{
+private:
+    const std::span<const std::byte> m_data;
+
+    explicit MappedFlatFile(std::span<const std::byte> data) : m_data{data} {}
+
+public:
+    /**
+     * Map the file at path into memory. Returns nullptr if that fails, or is not
+     * supported on this platform.
+     */
+    static std::shared_ptr<const MappedFlatFile> Open(const fs::path& path);
+
+    ~MappedFlatFile();
+    MappedFlatFile(const MappedFlatFile&) = delete;
+    MappedFlatFile& operator=(const MappedFlatFile&) = delete;
+
+    /** The contents of the file. */
+    std::span<const std::byte> Data() const { return m_data; }
+};
+
 #endif // BITCOIN_FLATFILE_H
@@ -11,6 +11,7 @@
 #include <netaddress.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
+#include <sync.h>
 #include <util/fs.h>
 #include <util/fs_helpers.h>
 #include <util/strencodings.h>
@@ -18,12 +19,15 @@
 #include <walletinitinterface.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 using util::SplitString;
@@ -101,7 +105,80 @@ static bool RPCAuthorized(const std::string& strAuth, std::string& strAuthUserna
     return CheckUserAuthorized(user, pass);
 }
 
-static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
+/** Execute a single element of a batch request. Batches never throw HTTP
+ * errors, they are always just included in "HTTP OK" responses.
+ * Notifications never get any response, which is returned as std::nullopt.
+ */
+static std::optional<UniValue> ExecuteBatchElement(JSONRPCRequest jreq, const UniValue& request)
+{
+    UniValue response;
+    try {
+        jreq.parse(request);
+        response = JSONRPCExec(jreq, /*catch_errors=*/true);
+    } catch (UniValue& e) {
+        response = JSONRPCReplyObj(NullUniValue, std::move(e), jreq.id, jreq.m_json_version);
+    } catch (const std::exception& e) {
+        response = JSONRPCReplyObj(NullUniValue, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id, jreq.m_json_version);
+    }
+    if (jreq.IsNotification()) return std::nullopt;
+    return response;
+}
+
+/** Shared state of a batch request whose elements are spread over the HTTP
+ * worker thread that received it and the batch helper threads. Helpers may still be queued after the batch has completed,
+ * so they hold a reference to this state and must not touch the requests
+ * unless they claimed an element before the batch completed.
+ */
+struct BatchExecution
+{
+    const JSONRPCRequest& jreq;
+    const UniValue& requests;
+    const size_t size;
+    std::vector<std::optional<UniValue>> responses;
+    std::atomic<size_t> next{0};
+    Mutex mutex;
+    std::condition_variable cond;
+    size_t done GUARDED_BY(mutex){0};
+
+    BatchExecution(const JSONRPCRequest& _jreq, const UniValue& _requests)
+        : jreq(_jreq), requests(_requests), size(_requests.size()), responses(size) {}
+
+    /** Execute unclaimed elements until there are none left */
+    void Run() EXCLUSIVE_LOCKS_REQUIRED(!mutex)
+    {
+        size_t executed{0};
+        for (size_t i{next++}; i < size; i = next++) {
+            responses[i] = ExecuteBatchElement(jreq, requests[i]);
+            ++executed;
+        }
+        if (executed == 0) return;
+        LOCK(mutex);
+        done += executed;
+        if (done == size) cond.notify_all();
+    }
+};
+
+/** Execute the elements of a batch request, using up to max_threads threads
+ * including the calling one. The calling thread executes elements too and only
+ * waits for those claimed by helpers, so the batch completes even if no helper
+ * can be queued or all helpers are busy with other batches.
+ */
+static std::vector<std::optional<UniValue>> ExecuteBatch(const JSONRPCRequest& jreq, const UniValue& requests, int max_threads)
+{
+    auto batch{std::make_shared<BatchExecution>(jreq, requests)};
+    const size_t helpers{std::min<size_t>(std::max(max_threads, 1) - 1, requests.size() > 0 ? requests.size() - 1 : 0)};
+    for (size_t i{0}; i < helpers; ++i) {
+        if (!EnqueueHTTPBatchWork([batch] { batch->Run(); })) break;
+    }
+    batch->Run();
+    {
+        WAIT_LOCK(batch->mutex, lock);
+        batch->cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(batch->mutex) { return batch->done == batch->size; });
+    }
+    return std::move(batch->responses);
+}
+
+static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req, int batch_threads)
 {
     // JSONRPC handles only POST
     if (req->GetRequestMethod() != HTTPRequest::POST) {
@@ -142,6 +219,8 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
         jreq.URI = req->GetURI();
 
         UniValue reply;
+        // Set by RPCs that write a large result incrementally
+        JSONRPCResultWriter result_writer;
         bool user_has_whitelist = g_rpc_whitelist.count(jreq.authUser);
         if (!user_has_whitelist && g_rpc_whitelist_default) {
             LogPrintf("RPC User %s not allowed to call any methods\n", jreq.authUser);
@@ -162,6 +241,7 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
             // 2.0 behavior is to catch exceptions and return HTTP success with
             // RPC errors, as long as there is not an actual HTTP server error.
             const bool catch_errors{jreq.m_json_version == JSONRPCVersion::V2};
+            jreq.m_result_writer = &result_writer;
             reply = JSONRPCExec(jreq, catch_errors);
 
             if (jreq.IsNotification()) {
@@ -190,22 +270,12 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
                 }
             }
 
-            // Execute each request
+            // Execute each request. Batch elements are independent, so they
+            // may run concurrently; responses keep the order of the requests.
             reply = UniValue::VARR;
-            for (size_t i{0}; i < valRequest.size(); ++i) {
-                // Batches never throw HTTP errors, they are always just included
-                // in "HTTP OK" responses. Notifications never get any response.
-                UniValue response;
-                try {
-                    jreq.parse(valRequest[i]);
-                    response = JSONRPCExec(jreq, /*catch_errors=*/true);
-                } catch (UniValue& e) {
-                    response = JSONRPCReplyObj(NullUniValue, std::move(e), jreq.id, jreq.m_json_version);
-                } catch (const std::exception& e) {
-                    response = JSONRPCReplyObj(NullUniValue, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id, jreq.m_json_version);
-                }
-                if (!jreq.IsNotification()) {
-                    reply.push_back(std::move(response));
+            for (std::optional<UniValue>& response : ExecuteBatch(jreq, valRequest, batch_threads)) {
+                if (response) {
+                    reply.push_back(std::move(*response));
                 }
             }
             // Return no response for an all-notification batch, but only if the
@@ -225,8 +295,23 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
         else
             throw JSONRPCError(RPC_PARSE_ERROR, "Top-level object parse error");
 
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, reply.write() + "\n");
+        if (result_writer && reply.find_value("error").isNull()) {
+            // The reply holds a null result in place of the one written here
+            req->WriteJSONReply(HTTP_OK, [&](UniValueWriter& writer) {
+                writer.beginObject();
+                for (size_t i{0}; i < reply.size(); ++i) {
+                    writer.key(reply.getKeys()[i]);
+                    if (reply.getKeys()[i] == "result") {
+                        result_writer(writer);
+                    } else {
+                        writer.value(reply.getValues()[i]);
+                    }
+                }
+                writer.endObject();
+            });
+        } else {
+            req->WriteJSONReply(HTTP_OK, reply);
+        }
     } catch (UniValue& e) {
         JSONErrorReply(req, std::move(e), jreq);
         return false;
@@ -334,7 +419,8 @@ bool StartHTTPRPC(const std::any& context)
     if (!InitRPCAuthentication())
         return false;
 
-    auto handle_rpc = [context](HTTPRequest* req, const std::string&) { return HTTPReq_JSONRPC(context, req); };
+    const int batch_threads{static_cast<int>(gArgs.GetIntArg("-rpcbatchthreads", DEFAULT_HTTP_BATCH_THREADS))};
+    auto handle_rpc = [context, batch_threads](HTTPRequest* req, const std::string&) { return HTTPReq_JSONRPC(context, req, batch_threads); };
     RegisterHTTPHandler("/", true, handle_rpc);
     if (g_wallet_init_interface.HasWalletSupport()) {
         RegisterHTTPHandler("/wallet/", false, handle_rpc);
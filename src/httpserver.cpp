@@ -19,6 +19,9 @@
 #include <util/threadnames.h>
 #include <util/translation.h>
 
+#include <univalue.h>
+
+#include <chrono>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
@@ -49,6 +52,9 @@ using common::InvalidPortErrMsg;
 /** Maximum size of http request (request line + headers) */
 static const size_t MAX_HEADERS_SIZE = 8192;
 
+/** Maximum number of bytes of a chunked reply waiting to be sent to the client */
+static const size_t MAX_CHUNKED_REPLY_BUFFER = 1 << 20;
+
 /** HTTP request work item */
 class HTTPWorkItem final : public HTTPClosure
 {
@@ -69,6 +75,20 @@ private:
     HTTPRequestHandler func;
 };
 
+/** Work item that runs an arbitrary function on an HTTP worker thread */
+class HTTPFunctionItem final : public HTTPClosure
+{
+public:
+    explicit HTTPFunctionItem(std::function<void()> _func) : func(std::move(_func)) {}
+    void operator()() override
+    {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+
 /** Simple work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
  */
@@ -147,6 +167,9 @@ static struct evhttp* eventHTTP = nullptr;
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
 static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
+//! Work queue for helpers executing the elements of batch requests, separate
+//! from g_work_queue so that batches do not take the place of new requests
+static std::unique_ptr<WorkQueue<HTTPClosure>> g_batch_queue{nullptr};
 //! Handlers for (sub)paths
 static GlobalMutex g_httppathhandlers_mutex;
 static std::vector<HTTPPathHandler> pathHandlers GUARDED_BY(g_httppathhandlers_mutex);
@@ -340,6 +363,15 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
     }
 }
 
+bool EnqueueHTTPBatchWork(std::function<void()> func)
+{
+    if (!g_batch_queue) return false;
+    auto item{std::make_unique<HTTPFunctionItem>(std::move(func))};
+    if (!g_batch_queue->Enqueue(item.get())) return false;
+    item.release(); /* queue took ownership */
+    return true;
+}
+
 /** Callback to reject HTTP requests after shutdown. */
 static void http_reject_request_cb(struct evhttp_request* req, void*)
 {
@@ -413,9 +445,9 @@ static bool HTTPBindAddresses(struct evhttp* http)
 }
 
 /** Simple wrapper to set thread name and run work queue */
-static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num)
+static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, const char* name, int worker_num)
 {
-    util::ThreadRename(strprintf("httpworker.%i", worker_num));
+    util::ThreadRename(strprintf("%s.%i", name, worker_num));
     queue->Run();
 }
 
@@ -481,6 +513,12 @@ bool InitHTTPServer(const util::SignalInterrupt& interrupt)
     LogDebug(BCLog::HTTP, "creating work queue of depth %d\n", workQueueDepth);
 
     g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    // The thread receiving a batch executes elements itself, helpers are only needed beyond one thread
+    const int batchHelpers = std::max((long)gArgs.GetIntArg("-rpcbatchthreads", DEFAULT_HTTP_BATCH_THREADS), 1L) - 1;
+    if (batchHelpers > 0) {
+        LogDebug(BCLog::HTTP, "creating batch work queue of depth %d\n", batchHelpers);
+        g_batch_queue = std::make_unique<WorkQueue<HTTPClosure>>(batchHelpers);
+    }
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -497,6 +535,7 @@ void UpdateHTTPServerLogging(bool enable) {
 
 static std::thread g_thread_http;
 static std::vector<std::thread> g_thread_http_workers;
+static std::vector<std::thread> g_thread_http_batch_workers;
 
 void StartHTTPServer()
 {
@@ -505,7 +544,13 @@ void StartHTTPServer()
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
-        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i);
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), "httpworker", i);
+    }
+    if (g_batch_queue) {
+        const int batchHelpers = std::max((long)gArgs.GetIntArg("-rpcbatchthreads", DEFAULT_HTTP_BATCH_THREADS), 1L) - 1;
+        for (int i = 0; i < batchHelpers; i++) {
+            g_thread_http_batch_workers.emplace_back(HTTPWorkQueueRun, g_batch_queue.get(), "httpbatch", i);
+        }
     }
 }
 
@@ -519,6 +564,9 @@ void InterruptHTTPServer()
     if (g_work_queue) {
         g_work_queue->Interrupt();
     }
+    if (g_batch_queue) {
+        g_batch_queue->Interrupt();
+    }
 }
 
 void StopHTTPServer()
@@ -531,6 +579,13 @@ void StopHTTPServer()
         }
         g_thread_http_workers.clear();
     }
+    if (g_batch_queue) {
+        LogDebug(BCLog::HTTP, "Waiting for HTTP batch worker threads to exit\n");
+        for (auto& thread : g_thread_http_batch_workers) {
+            thread.join();
+        }
+        g_thread_http_batch_workers.clear();
+    }
     // Unlisten sockets, these are what make the event loop running, which means
     // that after this and all connections are closed the event loop will quit.
     for (evhttp_bound_socket *socket : boundSockets) {
@@ -559,6 +614,7 @@ void StopHTTPServer()
         eventBase = nullptr;
     }
     g_work_queue.reset();
+    g_batch_queue.reset();
     LogDebug(BCLog::HTTP, "Stopped HTTP server\n");
 }
 
@@ -600,6 +656,10 @@ HTTPRequest::HTTPRequest(struct evhttp_request* _req, const util::SignalInterrup
 
 HTTPRequest::~HTTPRequest()
 {
+    if (m_chunked && !replySent) {
+        // Handler bailed out in the middle of a chunked reply, terminate it
+        EndReplyChunked();
+    }
     if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
@@ -646,6 +706,22 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
     evhttp_add_header(headers, hdr.c_str(), value.c_str());
 }
 
+/** Re-enable reading from the socket once a reply has been handed to libevent.
+ * This is the second part of the libevent workaround above.
+ */
+static void ReenableReading(evhttp_request* req)
+{
+    if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02010900) {
+        evhttp_connection* conn = evhttp_request_get_connection(req);
+        if (conn) {
+            bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+            if (bev) {
+                bufferevent_enable(bev, EV_READ | EV_WRITE);
+            }
+        }
+    }
+}
+
 /** Closure sent to main thread to request a reply to be sent to
  * a HTTP request.
  * Replies must be sent in the main loop in the main http thread,
@@ -664,17 +740,141 @@ void HTTPRequest::WriteReply(int nStatus, std::span<const std::byte> reply)
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
-        // Re-enable reading from the socket. This is the second part of the libevent
-        // workaround above.
-        if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02010900) {
-            evhttp_connection* conn = evhttp_request_get_connection(req_copy);
-            if (conn) {
-                bufferevent* bev = evhttp_connection_get_bufferevent(conn);
-                if (bev) {
-                    bufferevent_enable(bev, EV_READ | EV_WRITE);
-                }
+        ReenableReading(req_copy);
+    });
+    ev->trigger(nullptr);
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
+void HTTPRequest::WriteJSONReply(int nStatus, const UniValue& reply)
+{
+    WriteJSONReply(nStatus, [&](UniValueWriter& writer) { writer.value(reply); });
+}
+
+void HTTPRequest::WriteJSONReply(int nStatus, const std::function<void(UniValueWriter&)>& write_json)
+{
+    WriteHeader("Content-Type", "application/json");
+    bool chunked{false};
+    bool finished{false};
+    UniValueWriter writer{[&](std::string_view chunk) {
+        if (finished && !chunked) {
+            // The whole reply fit into the writer buffer
+            WriteReply(nStatus, std::string{chunk} + "\n");
+            return;
+        }
+        if (!chunked) {
+            StartReplyChunked(nStatus);
+            chunked = true;
+        }
+        WriteReplyChunk(chunk);
+    }};
+    write_json(writer);
+    finished = true;
+    writer.flush();
+    if (chunked) {
+        WriteReplyChunk("\n");
+        EndReplyChunked();
+    }
+}
+
+/** Send buffer state of a chunked reply, shared with the events sending it */
+struct HTTPChunkedReplyState
+{
+    Mutex mutex;
+    std::condition_variable cond;
+    //! Bytes of chunks queued to the http thread
+    size_t queued GUARDED_BY(mutex){0};
+    //! Bytes in the send buffer of the connection when last looked at
+    size_t buffered GUARDED_BY(mutex){0};
+    //! Whether the http thread has been asked to look at the send buffer
+    bool probing GUARDED_BY(mutex){false};
+    //! Whether the connection is gone
+    bool closed GUARDED_BY(mutex){false};
+
+    /** Record the send buffer of the connection of req. Call from the http thread. */
+    void Update(evhttp_request* req) EXCLUSIVE_LOCKS_REQUIRED(mutex)
+    {
+        evhttp_connection* conn = evhttp_request_get_connection(req);
+        bufferevent* bev = conn ? evhttp_connection_get_bufferevent(conn) : nullptr;
+        buffered = bev ? evbuffer_get_length(bufferevent_get_output(bev)) : 0;
+        closed = !bev;
+        cond.notify_all();
+    }
+};
+
+/** Chunked replies are queued to the main http thread in order, as events
+ * triggered with the same priority run in activation order. If the client
+ * disconnects before the reply is ended, libevent detaches the request from
+ * the connection and the queued chunk sends become no-ops; the final
+ * evhttp_send_reply_end then frees the request. Once a chunk send finds the
+ * connection gone, no further chunks are queued.
+ */
+void HTTPRequest::StartReplyChunked(int nStatus)
+{
+    assert(!replySent && !m_chunked && req);
+    if (m_interrupt) {
+        WriteHeader("Connection", "close");
+    }
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+    });
+    ev->trigger(nullptr);
+    m_chunked = true;
+    m_chunk_state = std::make_shared<HTTPChunkedReplyState>();
+}
+
+void HTTPRequest::WriteReplyChunk(std::span<const std::byte> chunk)
+{
+    assert(m_chunked && !replySent && req);
+    if (chunk.empty()) return;
+    auto req_copy = req;
+    auto state = m_chunk_state;
+    {
+        // Wait for the client to take some of the reply before queueing more.
+        // The send buffer is only looked at from the http thread, so ask it
+        // again every so often while the buffer stays full.
+        WAIT_LOCK(state->mutex, lock);
+        auto full = [&]() EXCLUSIVE_LOCKS_REQUIRED(state->mutex) {
+            return !state->closed && !m_interrupt && state->queued + state->buffered >= MAX_CHUNKED_REPLY_BUFFER;
+        };
+        while (full()) {
+            if (!state->probing) {
+                state->probing = true;
+                HTTPEvent* probe = new HTTPEvent(eventBase, true, [req_copy, state]{
+                    LOCK(state->mutex);
+                    state->probing = false;
+                    state->Update(req_copy);
+                });
+                probe->trigger(nullptr);
             }
+            state->cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(state->mutex) { return !state->probing; });
+            if (full()) state->cond.wait_for(lock, std::chrono::milliseconds{10});
         }
+        if (state->closed) return;
+        state->queued += chunk.size();
+    }
+    struct evbuffer* evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, chunk.data(), chunk.size());
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, evb, state, size = chunk.size()]{
+        evhttp_send_reply_chunk(req_copy, evb);
+        evbuffer_free(evb);
+        LOCK(state->mutex);
+        state->queued -= size;
+        state->Update(req_copy);
+    });
+    ev->trigger(nullptr);
+}
+
+void HTTPRequest::EndReplyChunked()
+{
+    assert(m_chunked && !replySent && req);
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy]{
+        evhttp_send_reply_end(req_copy);
+        ReenableReading(req_copy);
     });
     ev->trigger(nullptr);
     replySent = true;
@@ -6,6 +6,7 @@
 #define BITCOIN_HTTPSERVER_H
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -25,12 +26,21 @@ static const int DEFAULT_HTTP_THREADS=16;
  */
 static const int DEFAULT_HTTP_WORKQUEUE=64;
 
+/**
+ * The default value for `-rpcbatchthreads`. This is the maximum number of
+ * elements of a single JSON-RPC batch request that are executed concurrently.
+ */
+static const int DEFAULT_HTTP_BATCH_THREADS=1;
+
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
 
 struct evhttp_request;
 struct event_base;
 class CService;
 class HTTPRequest;
+class UniValue;
+class UniValueWriter;
+struct HTTPChunkedReplyState;
 
 /** Initialize HTTP server.
  * Call this before RegisterHTTPHandler or EventBase().
@@ -59,6 +69,13 @@ void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPR
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
 
+/** Queue a function on the HTTP batch helper threads, which do not take
+ * requests from the HTTP work queue.
+ * Returns false if the batch queue is full or not running, in which case the
+ * function is not run and the caller is expected to do the work itself.
+ */
+bool EnqueueHTTPBatchWork(std::function<void()> func);
+
 /** Return evhttp event base. This can be used by submodules to
  * queue timers or custom events.
  */
@@ -73,6 +90,8 @@ private:
     struct evhttp_request* req;
     const util::SignalInterrupt& m_interrupt;
     bool replySent;
+    bool m_chunked{false};
+    std::shared_ptr<HTTPChunkedReplyState> m_chunk_state;
 
 public:
     explicit HTTPRequest(struct evhttp_request* req, const util::SignalInterrupt& interrupt, bool replySent = false);
@@ -143,6 +162,47 @@ public:
         WriteReply(nStatus, std::as_bytes(std::span{reply}));
     }
     void WriteReply(int nStatus, std::span<const std::byte> reply);
+
+    /**
+     * Write a JSON HTTP reply followed by a newline, with a JSON Content-Type.
+     * The reply is serialized incrementally; once it outgrows one writer
+     * buffer it is sent as a chunked reply, so it is never held in full as a
+     * string.
+     *
+     * @note Use instead of WriteReply, with the same caveats.
+     */
+    void WriteJSONReply(int nStatus, const UniValue& reply);
+    /** Write a JSON HTTP reply like above, with the JSON written by write_json. */
+    void WriteJSONReply(int nStatus, const std::function<void(UniValueWriter&)>& write_json);
+
+    /**
+     * Start a chunked HTTP reply.
+     * nStatus is the HTTP status code to send. The body is then sent piecewise
+     * with WriteReplyChunk, so large responses need not be buffered in full.
+     *
+     * @note Use instead of WriteReply. Headers must be written before this.
+     */
+    void StartReplyChunked(int nStatus);
+
+    /**
+     * Write one chunk of a reply started with StartReplyChunked.
+     * Empty chunks are ignored, as an empty chunk terminates the body.
+     * Blocks while the client is not taking the reply as fast as it is written,
+     * and drops the chunk if the client has disconnected.
+     */
+    void WriteReplyChunk(std::string_view chunk)
+    {
+        WriteReplyChunk(std::as_bytes(std::span{chunk}));
+    }
+    void WriteReplyChunk(std::span<const std::byte> chunk);
+
+    /**
+     * Finish a chunked reply.
+     *
+     * @note As this will give the request back to the main thread, do not
+     * call any other HTTPRequest methods after calling this.
+     */
+    void EndReplyChunked();
 };
 
 /** Get the query parameter value from request uri for a specified key, or std::nullopt if the key
@@ -0,0 +1,297 @@
+// Copyright (c) 2017-2022 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/assetindex.h>
+
+#include <coins.h>
+#include <common/args.h>
+#include <coordinate/coordinate_assets.h>
+#include <coordinate/signed_block.h>
+#include <hash.h>
+#include <logging.h>
+#include <primitives/block.h>
+
+#include <map>
+#include <set>
+
+constexpr uint8_t DB_ASSET_COIN{'c'};
+constexpr uint8_t DB_ASSET_HOLDER{'h'};
+constexpr uint8_t DB_ASSET_SUPPLY{'s'};
+constexpr uint8_t DB_ASSET_BLOCK_UNDO{'u'};
+
+std::unique_ptr<AssetIndex> g_asset_index;
+
+namespace {
+
+/** Asset outputs spent and created by one block, used to rewind it on a reorg. */
+struct AssetBlockUndo {
+    std::vector<std::pair<COutPoint, AssetIndexCoin>> spent;
+    std::vector<COutPoint> created;
+
+    SERIALIZE_METHODS(AssetBlockUndo, obj) { READWRITE(obj.spent, obj.created); }
+};
+
+struct DBHolderKey {
+    uint256 asset_hash;
+    uint256 script_hash;
+    COutPoint outpoint;
+
+    DBHolderKey() = default;
+    DBHolderKey(const uint256& asset_hash_in, const uint256& script_hash_in, const COutPoint& outpoint_in)
+        : asset_hash(asset_hash_in), script_hash(script_hash_in), outpoint(outpoint_in) {}
+
+    SERIALIZE_METHODS(DBHolderKey, obj)
+    {
+        uint8_t prefix{DB_ASSET_HOLDER};
+        READWRITE(prefix);
+        if (prefix != DB_ASSET_HOLDER) {
+            throw std::ios_base::failure("Invalid format for assetindex DB holder key");
+        }
+
+        READWRITE(obj.asset_hash, obj.script_hash, obj.outpoint);
+    }
+};
+
+uint256 GetScriptHash(const CScript& script)
+{
+    return (HashWriter{} << script).GetSHA256();
+}
+
+/** Outputs are keyed by transaction and index alone, inputs spending an asset also name it in their outpoint. */
+COutPoint KeyOutPoint(const COutPoint& outpoint)
+{
+    return COutPoint{outpoint.hash, outpoint.n};
+}
+
+DBHolderKey MakeHolderKey(const COutPoint& outpoint, const AssetIndexCoin& coin)
+{
+    return DBHolderKey(getAssetHash(coin.nAssetID), GetScriptHash(coin.scriptPubKey), KeyOutPoint(outpoint));
+}
+
+} // namespace
+
+/** Access to the assetindex database (indexes/assetindex/) */
+class AssetIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+AssetIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "assetindex", n_cache_size, f_memory, f_wipe)
+{}
+
+namespace {
+
+/** Pending changes of one block, applied to the index in a single batch. */
+class AssetIndexUpdate
+{
+private:
+    const CDBWrapper& m_db;
+    CDBBatch m_batch;
+    std::map<COutPoint, std::optional<AssetIndexCoin>> m_coins;
+    std::map<uint256, AssetIndexSupply> m_supply;
+
+    AssetIndexSupply& Supply(const std::vector<unsigned char>& asset_id)
+    {
+        const uint256 asset_hash{getAssetHash(asset_id)};
+        auto it = m_supply.find(asset_hash);
+        if (it == m_supply.end()) {
+            AssetIndexSupply supply;
+            m_db.Read(std::make_pair(DB_ASSET_SUPPLY, asset_hash), supply);
+            it = m_supply.emplace(asset_hash, supply).first;
+        }
+        return it->second;
+    }
+
+public:
+    explicit AssetIndexUpdate(const CDBWrapper& db) : m_db(db), m_batch(db) {}
+
+    std::optional<AssetIndexCoin> GetCoin(const COutPoint& outpoint) const
+    {
+        auto it = m_coins.find(outpoint);
+        if (it != m_coins.end()) return it->second;
+        AssetIndexCoin coin;
+        if (!m_db.Read(std::make_pair(DB_ASSET_COIN, KeyOutPoint(outpoint)), coin)) return std::nullopt;
+        return coin;
+    }
+
+    void AddCoin(const COutPoint& outpoint, const AssetIndexCoin& coin)
+    {
+        m_batch.Write(std::make_pair(DB_ASSET_COIN, KeyOutPoint(outpoint)), coin);
+        m_batch.Write(MakeHolderKey(outpoint, coin), coin);
+        AssetIndexSupply& supply = Supply(coin.nAssetID);
+        if (!coin.fControl) supply.nAmount += coin.nValue;
+        supply.nOutputs++;
+        m_coins[outpoint] = coin;
+    }
+
+    void SpendCoin(const COutPoint& outpoint, const AssetIndexCoin& coin)
+    {
+        m_batch.Erase(std::make_pair(DB_ASSET_COIN, KeyOutPoint(outpoint)));
+        m_batch.Erase(MakeHolderKey(outpoint, coin));
+        AssetIndexSupply& supply = Supply(coin.nAssetID);
+        if (!coin.fControl) supply.nAmount -= coin.nValue;
+        supply.nOutputs--;
+        m_coins[outpoint] = std::nullopt;
+    }
+
+    CDBBatch& Finish()
+    {
+        for (const auto& [asset_hash, supply] : m_supply) {
+            if (supply.nOutputs == 0) {
+                m_batch.Erase(std::make_pair(DB_ASSET_SUPPLY, asset_hash));
+            } else {
+                m_batch.Write(std::make_pair(DB_ASSET_SUPPLY, asset_hash), supply);
+            }
+        }
+        return m_batch;
+    }
+};
+
+/**
+ * Label the outputs of a transaction the way UpdateCoins does and record the
+ * asset outputs it spends and creates.
+ */
+void ApplyTransaction(AssetIndexUpdate& update, AssetBlockUndo& undo, std::set<COutPoint>& created,
+                      const CTransaction& tx, uint32_t nHeight, const std::vector<unsigned char>& nNewAssetID)
+{
+    if (tx.version == TRANSACTION_PEGIN_VERSION) return;
+
+    CAmount amountAssetIn{0};
+    int nControlN{-1};
+    std::vector<unsigned char> nAssetID;
+    if (!tx.IsCoinBase()) {
+        for (size_t x = 0; x < tx.vin.size(); x++) {
+            const COutPoint& prevout = tx.vin[x].prevout;
+            const std::optional<AssetIndexCoin> coin{update.GetCoin(prevout)};
+            if (!coin) continue;
+            update.SpendCoin(prevout, *coin);
+            if (created.erase(prevout) == 0) {
+                undo.spent.emplace_back(prevout, *coin);
+            }
+
+            nAssetID = coin->nAssetID;
+            if (coin->fControl) {
+                nControlN = x;
+            } else {
+                amountAssetIn += coin->nValue;
+            }
+        }
+    }
+
+    const std::vector<unsigned char>& nID = !nNewAssetID.empty() ? nNewAssetID : nAssetID;
+    const std::vector<std::pair<bool, bool>> flags{GetAssetOutputFlags(tx, amountAssetIn, nControlN)};
+    for (size_t i = 0; i < tx.vout.size(); ++i) {
+        const auto [fAsset, fControl] = flags[i];
+        if (!fAsset) continue;
+        const COutPoint outpoint(tx.GetHash(), i);
+        update.AddCoin(outpoint, {nID, tx.vout[i].scriptPubKey, tx.vout[i].nValue, nHeight, fControl});
+        created.insert(outpoint);
+    }
+}
+
+} // namespace
+
+AssetIndex::AssetIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "assetindex"), m_db(std::make_unique<AssetIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+AssetIndex::~AssetIndex() = default;
+
+bool AssetIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    // Exclude genesis block transaction because outputs are not spendable.
+    if (block.height == 0) return true;
+
+    assert(block.data);
+    AssetIndexUpdate update(*m_db);
+    AssetBlockUndo undo;
+    std::set<COutPoint> created;
+
+    // Same order as ConnectBlock: signed block transactions first, then the block itself
+    for (const SignedBlock& signedBlock : block.data->preconfBlock) {
+        for (const CTransactionRef& tx : signedBlock.vtx) {
+            ApplyTransaction(update, undo, created, *tx, block.height, {});
+        }
+    }
+
+    uint16_t assetIncr{0};
+    for (const CTransactionRef& tx : block.data->vtx) {
+        std::vector<unsigned char> nNewAssetID;
+        if (tx->version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) {
+            assetIncr++;
+            std::optional<AssetIndexCoin> coin;
+            if (tx->assetType == 0 && !tx->vin.empty()) {
+                coin = update.GetCoin(tx->vin[0].prevout);
+            }
+            nNewAssetID = GetCreatedAssetId(*tx, block.height, assetIncr, coin ? coin->nAssetID : std::vector<unsigned char>{}, coin && coin->fControl);
+        }
+        ApplyTransaction(update, undo, created, *tx, block.height, nNewAssetID);
+    }
+
+    CDBBatch& batch = update.Finish();
+    undo.created.assign(created.begin(), created.end());
+    if (!undo.spent.empty() || !undo.created.empty()) {
+        batch.Write(std::make_pair(DB_ASSET_BLOCK_UNDO, block.hash), undo);
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AssetIndex::CustomRemove(const interfaces::BlockInfo& block)
+{
+    AssetBlockUndo undo;
+    if (!m_db->Read(std::make_pair(DB_ASSET_BLOCK_UNDO, block.hash), undo)) {
+        // Block did not touch any asset output
+        return true;
+    }
+
+    AssetIndexUpdate update(*m_db);
+    for (const COutPoint& outpoint : undo.created) {
+        const std::optional<AssetIndexCoin> coin{update.GetCoin(outpoint)};
+        if (!coin) {
+            LogError("%s: asset output %s of block %s not found\n", __func__, outpoint.ToString(), block.hash.ToString());
+            return false;
+        }
+        update.SpendCoin(outpoint, *coin);
+    }
+    for (const auto& [outpoint, coin] : undo.spent) {
+        update.AddCoin(outpoint, coin);
+    }
+
+    CDBBatch& batch = update.Finish();
+    batch.Erase(std::make_pair(DB_ASSET_BLOCK_UNDO, block.hash));
+    return m_db->WriteBatch(batch);
+}
+
+BaseIndex::DB& AssetIndex::GetDB() const { return *m_db; }
+
+bool AssetIndex::FindAssetCoins(const std::vector<unsigned char>& asset_id, const std::optional<CScript>& script, std::vector<std::pair<COutPoint, AssetIndexCoin>>& coins) const
+{
+    const uint256 asset_hash{getAssetHash(asset_id)};
+    const uint256 script_hash{script ? GetScriptHash(*script) : uint256::ZERO};
+
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    db_it->Seek(DBHolderKey(asset_hash, script_hash, COutPoint(Txid{}, 0)));
+    for (; db_it->Valid(); db_it->Next()) {
+        DBHolderKey key;
+        if (!db_it->GetKey(key) || key.asset_hash != asset_hash) break;
+        if (script && key.script_hash != script_hash) break;
+
+        AssetIndexCoin coin;
+        if (!db_it->GetValue(coin)) {
+            LogError("%s: cannot read asset output %s\n", __func__, key.outpoint.ToString());
+            return false;
+        }
+        coins.emplace_back(key.outpoint, std::move(coin));
+    }
+    return true;
+}
+
+bool AssetIndex::LookUpSupply(const std::vector<unsigned char>& asset_id, AssetIndexSupply& supply) const
+{
+    supply = {};
+    const auto key{std::make_pair(DB_ASSET_SUPPLY, getAssetHash(asset_id))};
+    return !m_db->Exists(key) || m_db->Read(key, supply);
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2017-2022 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_ASSETINDEX_H
+#define BITCOIN_INDEX_ASSETINDEX_H
+
+#include <consensus/amount.h>
+#include <index/base.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <serialize.h>
+
+#include <optional>
+#include <vector>
+
+static constexpr bool DEFAULT_ASSETINDEX{false};
+
+/** Unspent asset output as tracked by the asset index. */
+struct AssetIndexCoin {
+    std::vector<unsigned char> nAssetID; /*!< asset the output carries */
+    CScript scriptPubKey;                /*!< holder script */
+    CAmount nValue{0};                   /*!< asset amount */
+    uint32_t nHeight{0};                 /*!< height of the block that created the output */
+    bool fControl{false};                /*!< asset controller output, not counted in the supply */
+
+    SERIALIZE_METHODS(AssetIndexCoin, obj) { READWRITE(obj.nAssetID, obj.scriptPubKey, obj.nValue, obj.nHeight, obj.fControl); }
+};
+
+/** Circulating supply of one asset as tracked by the asset index. */
+struct AssetIndexSupply {
+    CAmount nAmount{0};   /*!< sum of all unspent asset outputs excluding controller outputs */
+    uint64_t nOutputs{0}; /*!< number of unspent asset outputs including controller outputs */
+
+    SERIALIZE_METHODS(AssetIndexSupply, obj) { READWRITE(obj.nAmount, obj.nOutputs); }
+};
+
+/**
+ * AssetIndex keeps the unspent asset outputs of the chain keyed by asset and
+ * holder script, so balances, holders and supply can be looked up without
+ * scanning the UTXO set. Outputs are labelled with the same rules UpdateCoins
+ * uses, applied to the preconf transactions of the included signed blocks
+ * followed by the block transactions. Spent outputs are kept per block in the
+ * index so reorgs do not depend on block undo data, which does not cover
+ * preconf transactions.
+ */
+class AssetIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    bool AllowPrune() const override { return true; }
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    bool CustomRemove(const interfaces::BlockInfo& block) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit AssetIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~AssetIndex() override;
+
+    /// Look up the unspent outputs of an asset.
+    ///
+    /// @param[in]   asset_id  The asset to look up.
+    /// @param[in]   script  Only return outputs held by this script, if set.
+    /// @param[out]  coins  The unspent outputs, ordered by holder script hash.
+    /// @return  true if the index could be read, false otherwise
+    bool FindAssetCoins(const std::vector<unsigned char>& asset_id, const std::optional<CScript>& script, std::vector<std::pair<COutPoint, AssetIndexCoin>>& coins) const;
+
+    /// Look up the circulating supply of an asset.
+    ///
+    /// @param[in]   asset_id  The asset to look up.
+    /// @param[out]  supply  The supply, zero if the asset has no unspent outputs.
+    /// @return  true if the index could be read, false otherwise
+    bool LookUpSupply(const std::vector<unsigned char>& asset_id, AssetIndexSupply& supply) const;
+};
+
+/// The global asset index, used by the asset balance RPCs. May be null.
+extern std::unique_ptr<AssetIndex> g_asset_index;
+
+#endif // BITCOIN_INDEX_ASSETINDEX_H
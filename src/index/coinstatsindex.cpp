@@ -5,6 +5,7 @@
 #include <chainparams.h>
 #include <coins.h>
 #include <common/args.h>
+#include <coordinate/coordinate_assets.h>
 #include <crypto/muhash.h>
 #include <index/coinstatsindex.h>
 #include <kernel/coinstats.h>
@@ -23,6 +24,13 @@ using kernel::RemoveCoinHash;
 static constexpr uint8_t DB_BLOCK_HASH{'s'};
 static constexpr uint8_t DB_BLOCK_HEIGHT{'t'};
 static constexpr uint8_t DB_MUHASH{'M'};
+static constexpr uint8_t DB_ASSET_AMOUNT{'a'};
+static constexpr uint8_t DB_VERSION{'V'};
+
+//! Version of the stored index data. Version 1 commits the asset state of coins
+//! to the MuHash, adds total_assets and keeps per-asset amounts. Data written by
+//! an older version can not be extended or rewound, so the index is rebuilt.
+static constexpr int COINSTATSINDEX_VERSION{1};
 
 namespace {
 
@@ -101,6 +109,80 @@ struct DBHashKey {
     }
 };
 
+/** Per-asset amount key. Heights are stored inverted so a seek finds the latest entry at or below a height. */
+struct DBAssetKey {
+    uint256 asset_hash;
+    int height;
+
+    DBAssetKey(const uint256& asset_hash_in, int height_in) : asset_hash(asset_hash_in), height(height_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_ASSET_AMOUNT);
+        s << asset_hash;
+        ser_writedata32be(s, std::numeric_limits<uint32_t>::max() - static_cast<uint32_t>(height));
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_ASSET_AMOUNT) {
+            throw std::ios_base::failure("Invalid format for coinstatsindex DB asset key");
+        }
+        s >> asset_hash;
+        height = std::numeric_limits<uint32_t>::max() - ser_readdata32be(s);
+    }
+};
+
+/**
+ * Coins created by a block transaction, labelled with the asset state
+ * UpdateCoins gives them. asset_incr counts the asset creations of the block
+ * the same way ConnectBlock does.
+ */
+std::vector<Coin> GetOutputCoins(const CTransaction& tx, const CTxUndo* tx_undo, int height, uint16_t& asset_incr)
+{
+    CAmount amountAssetIn{0};
+    int nControlN{-1};
+    std::vector<unsigned char> nAssetID;
+    if (tx_undo) {
+        for (size_t x = 0; x < tx_undo->vprevout.size(); ++x) {
+            const Coin& prev{tx_undo->vprevout[x]};
+            if (!prev.nAssetID.empty()) nAssetID = prev.nAssetID;
+            if (prev.fBitAsset && !prev.fBitAssetControl) amountAssetIn += prev.out.nValue;
+            if (prev.fBitAssetControl) nControlN = x;
+        }
+    }
+
+    std::vector<unsigned char> nNewAssetID;
+    if (tx.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) {
+        asset_incr++;
+        const bool has_first_input{tx_undo && !tx_undo->vprevout.empty()};
+        nNewAssetID = GetCreatedAssetId(tx, height, asset_incr, has_first_input ? tx_undo->vprevout[0].nAssetID : std::vector<unsigned char>{},
+                                        has_first_input && tx_undo->vprevout[0].fBitAssetControl);
+    }
+    const std::vector<unsigned char>& nID = !nNewAssetID.empty() ? nNewAssetID : nAssetID;
+
+    const std::vector<std::pair<bool, bool>> flags{GetAssetOutputFlags(tx, amountAssetIn, nControlN)};
+    std::vector<Coin> coins;
+    coins.reserve(tx.vout.size());
+    for (size_t i = 0; i < tx.vout.size(); ++i) {
+        const auto [fAsset, fControl] = flags[i];
+        coins.emplace_back(tx.vout[i], height, tx.IsCoinBase(), fAsset, fControl, tx.version == TRANSACTION_PRECONF_VERSION, false,
+                           fAsset ? nID : std::vector<unsigned char>{});
+    }
+    return coins;
+}
+
+//! Track the change of a coin to the circulating amount of its asset.
+void UpdateAssetDelta(std::map<std::vector<unsigned char>, CAmount>& asset_deltas, const Coin& coin, CAmount sign)
+{
+    if (coin.IsBitAsset() && !coin.IsBitAssetController()) {
+        asset_deltas[coin.nAssetID] += sign * coin.out.nValue;
+    }
+}
+
 }; // namespace
 
 std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
@@ -112,6 +194,15 @@ CoinStatsIndex::CoinStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t
     fs::create_directories(path);
 
     m_db = std::make_unique<CoinStatsIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+
+    int version{0};
+    CBlockLocator locator;
+    if (m_db->ReadBestBlock(locator) && !locator.IsNull() && (!m_db->Read(DB_VERSION, version) || version != COINSTATSINDEX_VERSION)) {
+        LogInfo("%s was built by an incompatible version (%d), rebuilding it\n", GetName(), version);
+        m_db.reset();
+        m_db = std::make_unique<CoinStatsIndex::DB>(path / "db", n_cache_size, f_memory, /*f_wipe=*/true);
+    }
+    m_db->Write(DB_VERSION, COINSTATSINDEX_VERSION);
 }
 
 bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
@@ -119,6 +210,8 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
     const CAmount block_subsidy{GetBlockSubsidy(block.height, Params().GetConsensus())};
     m_total_subsidy += block_subsidy;
 
+    std::map<std::vector<unsigned char>, CAmount> asset_deltas;
+
     // Ignore genesis block
     if (block.height > 0) {
         std::pair<uint256, DBVal> read_out;
@@ -140,8 +233,12 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 
         // Add the new utxos created from the block
         assert(block.data);
+        uint16_t asset_incr{0};
         for (size_t i = 0; i < block.data->vtx.size(); ++i) {
             const auto& tx{block.data->vtx.at(i)};
+            // The coinbase tx has no undo data since no former output is spent
+            const CTxUndo* tx_undo{tx->IsCoinBase() ? nullptr : &Assert(block.undo_data)->vtxundo.at(i - 1)};
+            const std::vector<Coin> out_coins{GetOutputCoins(*tx, tx_undo, block.height, asset_incr)};
 
             // Skip duplicate txid coinbase transactions (BIP30).
             if (IsBIP30Unspendable(block.hash, block.height) && tx->IsCoinBase()) {
@@ -151,8 +248,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
             }
 
             for (uint32_t j = 0; j < tx->vout.size(); ++j) {
-                const CTxOut& out{tx->vout[j]};
-                Coin coin{out, block.height, tx->IsCoinBase(), false, false, false, false, std::vector<unsigned char>{}};
+                const Coin& coin{out_coins[j]};
                 COutPoint outpoint{tx->GetHash(), j};
 
                 // Skip unspendable coins
@@ -162,7 +258,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     continue;
                 }
 
-                ApplyCoinHash(m_muhash, outpoint, coin);
+                ApplyCoinHash(m_muhash_updates, outpoint, coin);
 
                 if (tx->IsCoinBase()) {
                     m_total_coinbase_amount += coin.out.nValue;
@@ -178,18 +274,16 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                         m_total_assets += coin.out.nValue;
                     }
                 }
+                UpdateAssetDelta(asset_deltas, coin, 1);
                 m_bogo_size += GetBogoSize(coin.out.scriptPubKey);
             }
 
-            // The coinbase tx has no undo data since no former output is spent
-            if (!tx->IsCoinBase()) {
-                const auto& tx_undo{Assert(block.undo_data)->vtxundo.at(i - 1)};
-
-                for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
-                    Coin coin{tx_undo.vprevout[j]};
+            if (tx_undo) {
+                for (size_t j = 0; j < tx_undo->vprevout.size(); ++j) {
+                    const Coin& coin{tx_undo->vprevout[j]};
                     COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
 
-                    RemoveCoinHash(m_muhash, outpoint, coin);
+                    RemoveCoinHash(m_muhash_updates, outpoint, coin);
 
                     m_total_prevout_spent_amount += coin.out.nValue;
 
@@ -201,10 +295,12 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                             m_total_assets -= coin.out.nValue;
                         }
                     }
+                    UpdateAssetDelta(asset_deltas, coin, -1);
                     m_bogo_size -= GetBogoSize(coin.out.scriptPubKey);
                 }
             }
         }
+        m_muhash *= m_muhash_updates.Finish();
     } else {
         // genesis block
         m_total_unspendable_amount += block_subsidy;
@@ -239,9 +335,36 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
     m_muhash.Finalize(out);
     value.second.muhash = out;
 
+    CDBBatch batch(*m_db);
+    batch.Write(DBHeightKey(block.height), value);
+
+    // Store the new amount of every asset the block changed, so the supply at
+    // any height is found with a single seek.
+    for (const auto& [asset_id, delta] : asset_deltas) {
+        if (delta == 0) continue;
+        const uint256 asset_hash{getAssetHash(asset_id)};
+        const CAmount previous{ReadAssetAmount(asset_hash, block.height - 1)};
+        batch.Write(DBAssetKey(asset_hash, block.height), previous + delta);
+    }
+
     // Intentionally do not update DB_MUHASH here so it stays in sync with
     // DB_BEST_BLOCK, and the index is not corrupted if there is an unclean shutdown.
-    return m_db->Write(DBHeightKey(block.height), value);
+    return m_db->WriteBatch(batch);
+}
+
+CAmount CoinStatsIndex::ReadAssetAmount(const uint256& asset_hash, int height) const
+{
+    if (height < 0) return 0;
+
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    db_it->Seek(DBAssetKey(asset_hash, height));
+
+    DBAssetKey key{asset_hash, height};
+    CAmount amount{0};
+    if (!db_it->Valid() || !db_it->GetKey(key) || key.asset_hash != asset_hash || !db_it->GetValue(amount)) {
+        return 0;
+    }
+    return amount;
 }
 
 [[nodiscard]] static bool CopyHeightIndexToHashIndex(CDBIterator& db_it, CDBBatch& batch,
@@ -334,6 +457,16 @@ std::optional<CCoinsStats> CoinStatsIndex::LookUpStats(const CBlockIndex& block_
     return stats;
 }
 
+std::optional<CAmount> CoinStatsIndex::LookUpAssetAmount(const std::vector<unsigned char>& asset_id, const CBlockIndex& block_index) const
+{
+    // Per-asset amounts are only kept for the blocks of the indexed chain
+    std::pair<uint256, DBVal> read_out;
+    if (!m_db->Read(DBHeightKey(block_index.nHeight), read_out) || read_out.first != block_index.GetBlockHash()) {
+        return std::nullopt;
+    }
+    return ReadAssetAmount(getAssetHash(asset_id), block_index.nHeight);
+}
+
 bool CoinStatsIndex::CustomInit(const std::optional<interfaces::BlockRef>& block)
 {
     if (!m_db->Read(DB_MUHASH, m_muhash)) {
@@ -428,13 +561,17 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
     // Remove the new UTXOs that were created from the block
     assert(block.data);
     assert(block.undo_data);
+    std::map<std::vector<unsigned char>, CAmount> asset_deltas;
+    uint16_t asset_incr{0};
     for (size_t i = 0; i < block.data->vtx.size(); ++i) {
         const auto& tx{block.data->vtx.at(i)};
+        // The coinbase tx has no undo data since no former output is spent
+        const CTxUndo* tx_undo{tx->IsCoinBase() ? nullptr : &block.undo_data->vtxundo.at(i - 1)};
+        const std::vector<Coin> out_coins{GetOutputCoins(*tx, tx_undo, block.height, asset_incr)};
 
         for (uint32_t j = 0; j < tx->vout.size(); ++j) {
-            const CTxOut& out{tx->vout[j]};
             COutPoint outpoint{tx->GetHash(), j};
-            Coin coin{out, block.height, tx->IsCoinBase(), false, false, false, false, std::vector<unsigned char>{}};
+            const Coin& coin{out_coins[j]};
 
             // Skip unspendable coins
             if (coin.out.scriptPubKey.IsUnspendable()) {
@@ -443,7 +580,7 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
                 continue;
             }
 
-            RemoveCoinHash(m_muhash, outpoint, coin);
+            RemoveCoinHash(m_muhash_updates, outpoint, coin);
 
             if (tx->IsCoinBase()) {
                 m_total_coinbase_amount -= coin.out.nValue;
@@ -459,18 +596,16 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
                    m_total_assets -= coin.out.nValue;
                 }
             }
+            UpdateAssetDelta(asset_deltas, coin, -1);
             m_bogo_size -= GetBogoSize(coin.out.scriptPubKey);
         }
 
-        // The coinbase tx has no undo data since no former output is spent
-        if (!tx->IsCoinBase()) {
-            const auto& tx_undo{block.undo_data->vtxundo.at(i - 1)};
-
-            for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
-                Coin coin{tx_undo.vprevout[j]};
+        if (tx_undo) {
+            for (size_t j = 0; j < tx_undo->vprevout.size(); ++j) {
+                const Coin& coin{tx_undo->vprevout[j]};
                 COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
 
-                ApplyCoinHash(m_muhash, outpoint, coin);
+                ApplyCoinHash(m_muhash_updates, outpoint, coin);
 
                 m_total_prevout_spent_amount -= coin.out.nValue;
 
@@ -482,10 +617,19 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
                         m_total_assets += coin.out.nValue;
                    }
                 }
+                UpdateAssetDelta(asset_deltas, coin, 1);
                 m_bogo_size += GetBogoSize(coin.out.scriptPubKey);
             }
         }
     }
+    m_muhash *= m_muhash_updates.Finish();
+
+    // Drop the per-asset amounts written for this height
+    CDBBatch batch(*m_db);
+    for (const auto& [asset_id, delta] : asset_deltas) {
+        if (delta != 0) batch.Erase(DBAssetKey(getAssetHash(asset_id), block.height));
+    }
+    if (!m_db->WriteBatch(batch)) return false;
 
     const CAmount unclaimed_rewards{(m_total_new_outputs_ex_coinbase_amount + m_total_coinbase_amount + m_total_unspendable_amount) - (m_total_prevout_spent_amount + m_total_subsidy)};
     m_total_unspendable_amount -= unclaimed_rewards;
@@ -7,12 +7,13 @@
 
 #include <crypto/muhash.h>
 #include <index/base.h>
+#include <kernel/coinstats.h>
+
+#include <optional>
+#include <vector>
 
 class CBlockIndex;
 class CDBBatch;
-namespace kernel {
-struct CCoinsStats;
-}
 
 static constexpr bool DEFAULT_COINSTATSINDEX{false};
 
@@ -25,6 +26,8 @@ private:
     std::unique_ptr<BaseIndex::DB> m_db;
 
     MuHash3072 m_muhash;
+    //! Hashes the coins created and spent by a block in parallel before they are applied to m_muhash
+    kernel::MuHashAccumulator m_muhash_updates;
     uint64_t m_transaction_output_count{0};
     uint64_t m_bogo_size{0};
     CAmount m_total_amount{0};
@@ -41,6 +44,9 @@ private:
 
     [[nodiscard]] bool ReverseBlock(const interfaces::BlockInfo& block);
 
+    //! Amount of an asset as of the latest entry at or below the given height, zero if none.
+    CAmount ReadAssetAmount(const uint256& asset_hash, int height) const;
+
     bool AllowPrune() const override { return true; }
 
 protected:
@@ -62,6 +68,10 @@ public:
 
     // Look up stats for a specific block using CBlockIndex
     std::optional<kernel::CCoinsStats> LookUpStats(const CBlockIndex& block_index) const;
+
+    // Look up the circulating amount of an asset (excluding controller outputs) at a block of the
+    // indexed chain. Returns nullopt for blocks that are not indexed or no longer in the chain.
+    std::optional<CAmount> LookUpAssetAmount(const std::vector<unsigned char>& asset_id, const CBlockIndex& block_index) const;
 };
 
 /// The global UTXO set hash object.
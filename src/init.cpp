@@ -25,6 +25,7 @@
 #include <httprpc.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
+#include <index/assetindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <init/common.h>
@@ -67,6 +68,7 @@
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <coordinate/coordinate_pegin.h>
+#include <coordinate/coordinate_preconf.h>
 #include <scheduler.h>
 #include <script/sigcache.h>
 #include <sync.h>
@@ -356,6 +358,7 @@ void Shutdown(NodeContext& node)
     for (auto* index : node.indexes) index->Stop();
     if (g_txindex) g_txindex.reset();
     if (g_coin_stats_index) g_coin_stats_index.reset();
+    if (g_asset_index) g_asset_index.reset();
     DestroyAllBlockFilterIndexes();
     node.indexes.clear(); // all instances are nullptr now
 
@@ -373,6 +376,7 @@ void Shutdown(NodeContext& node)
                 chainstate->ResetCoinsViews();
             }
         }
+        node.chainman->m_blockman.DumpAuxpowCache();
     }
     for (const auto& client : node.chain_clients) {
         client->stop();
@@ -469,8 +473,15 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
 #if HAVE_SYSTEM
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
+    argsman.AddArg("-assetindex", strprintf("Maintain an index of unspent asset outputs, used by the getassetbalance, listassetholders and getassetsupply RPCs (default: %u)", DEFAULT_ASSETINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet4: %s, signet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnet4ChainParams->GetConsensus().defaultAssumeValid.GetHex(), signetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blocksmmap",
+                   strprintf("Whether to memory-map blocksdir blk*.dat files that are no longer written to, and serve "
+                             "blocks from them without reading them into a buffer first. Only supported on 64-bit "
+                             "non-Windows systems. (default: %u)",
+                             kernel::DEFAULT_MMAP_BLOCKSDIR),
+                   ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksxor",
                    strprintf("Whether an XOR-key applies to blocksdir *.dat files. "
                              "The created XOR-key will be zeros for an existing blocksdir or when `-blocksxor=0` is "
@@ -493,6 +504,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-allowignoredconf", strprintf("For backwards compatibility, treat an unused %s file in the datadir as a warning, not an error.", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-loadblock=<file>", "Imports blocks from external file on startup", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u)", DEFAULT_MAX_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-maxpreconfmempool=<n>", strprintf("Keep the preconf transaction memory pool below <n> megabytes, evicting the lowest preconf fee rate transactions first (default: %u)", DEFAULT_MAX_PRECONF_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     // TODO: remove in v31.0
     argsman.AddArg("-maxorphantx=<n>", strprintf("(Removed option, see release notes)"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mempoolexpiry=<n>", strprintf("Do not keep transactions in the mempool longer than <n> hours (default: %u)", DEFAULT_MEMPOOL_EXPIRY_HOURS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -604,6 +616,20 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-zmqpubrawblockhwm=<n>", strprintf("Set publish raw block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtxhwm=<n>", strprintf("Set publish raw transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequencehwm=<n>", strprintf("Set publish hash sequence message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubhashsignedblock=<address>", "Enable publish hash signed block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawsignedblock=<address>", "Enable publish raw signed block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubpreconfsig=<address>", "Enable publish preconf federation signature in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubpreconftx=<address>", "Enable publish raw preconf mempool transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassetcreate=<address>", "Enable publish asset creation in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassetdisconnect=<address>", "Enable publish disconnected asset creation in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassettransfer=<address>", "Enable publish raw asset transfer transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubhashsignedblockhwm=<n>", strprintf("Set publish hash signed block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawsignedblockhwm=<n>", strprintf("Set publish raw signed block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubpreconfsighwm=<n>", strprintf("Set publish preconf federation signature outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubpreconftxhwm=<n>", strprintf("Set publish raw preconf mempool transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassetcreatehwm=<n>", strprintf("Set publish asset creation outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassetdisconnecthwm=<n>", strprintf("Set publish disconnected asset creation outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubassettransferhwm=<n>", strprintf("Set publish raw asset transfer transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     hidden_args.emplace_back("-zmqpubhashblock=<address>");
     hidden_args.emplace_back("-zmqpubhashtx=<address>");
@@ -615,6 +641,20 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     hidden_args.emplace_back("-zmqpubrawblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
+    hidden_args.emplace_back("-zmqpubhashsignedblock=<address>");
+    hidden_args.emplace_back("-zmqpubrawsignedblock=<address>");
+    hidden_args.emplace_back("-zmqpubpreconfsig=<address>");
+    hidden_args.emplace_back("-zmqpubpreconftx=<address>");
+    hidden_args.emplace_back("-zmqpubassetcreate=<address>");
+    hidden_args.emplace_back("-zmqpubassetdisconnect=<address>");
+    hidden_args.emplace_back("-zmqpubassettransfer=<address>");
+    hidden_args.emplace_back("-zmqpubhashsignedblockhwm=<n>");
+    hidden_args.emplace_back("-zmqpubrawsignedblockhwm=<n>");
+    hidden_args.emplace_back("-zmqpubpreconfsighwm=<n>");
+    hidden_args.emplace_back("-zmqpubpreconftxhwm=<n>");
+    hidden_args.emplace_back("-zmqpubassetcreatehwm=<n>");
+    hidden_args.emplace_back("-zmqpubassetdisconnecthwm=<n>");
+    hidden_args.emplace_back("-zmqpubassettransferhwm=<n>");
 #endif
 
     argsman.AddArg("-checkblocks=<n>", strprintf("How many blocks to check at startup (default: %u, 0 = all)", DEFAULT_CHECKBLOCKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -671,6 +711,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-rest", strprintf("Accept public REST requests (default: %u)", DEFAULT_REST_ENABLE), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid values for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0), a network/CIDR (e.g. 1.2.3.4/24), all ipv4 (0.0.0.0/0), or all ipv6 (::/0). RFC4193 is allowed only if -cjdnsreachable=0. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcauth=<userpw>", "Username and HMAC-SHA-256 hashed password for JSON-RPC connections. The field <userpw> comes in the format: <USERNAME>:<SALT>$<HASH>. A canonical python script is included in share/rpcauth. The client then connects normally using the rpcuser=<USERNAME>/rpcpassword=<PASSWORD> pair of arguments. This option can be specified multiple times", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
+    argsman.AddArg("-rpcbatchthreads=<n>", strprintf("Set the maximum number of threads that execute the calls of a single JSON-RPC batch request concurrently. Threads beyond the first are shared by all batch requests and do not take requests from the -rpcworkqueue, 1 executes the calls in order (default: %d)", DEFAULT_HTTP_BATCH_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcbind=<addr>[:port]", "Bind to given address to listen for JSON-RPC connections. Do not expose the RPC server to untrusted networks such as the public internet! This option is ignored unless -rpcallowip is also passed. Port is optional and overrides -rpcport. Use [host]:port notation for IPv6. This option can be specified multiple times (default: 127.0.0.1 and ::1 i.e., localhost)", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcdoccheck", strprintf("Throw a non-fatal error at runtime if the documentation for an RPC is incorrect (default: %u)", DEFAULT_RPC_DOC_CHECK), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpccookiefile=<loc>", "Location of the auth cookie. Relative paths will be prefixed by a net-specific datadir location. (default: data dir)", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -1118,6 +1159,11 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         if (!mempool_result) {
             return InitError(util::ErrorString(mempool_result));
         }
+        CTxMemPool::Options preconf_mempool_opts{.is_preconf = true};
+        auto preconf_mempool_result{ApplyArgsManOptions(args, chainparams, preconf_mempool_opts)};
+        if (!preconf_mempool_result) {
+            return InitError(util::ErrorString(preconf_mempool_result));
+        }
     }
 
     return true;
@@ -1244,19 +1290,26 @@ bool CheckHostPortOptions(const ArgsManager& args) {
     }
 
     for ([[maybe_unused]] const auto& [param_name, unix, suffix_allowed] : std::vector<std::tuple<std::string, bool, bool>>{
-        // arg name          UNIX socket support  =suffix allowed
-        {"-i2psam",          false,               false},
-        {"-onion",           true,                false},
-        {"-proxy",           true,                true},
-        {"-bind",            false,               true},
-        {"-rpcbind",         false,               false},
-        {"-torcontrol",      false,               false},
-        {"-whitebind",       false,               false},
-        {"-zmqpubhashblock", true,                false},
-        {"-zmqpubhashtx",    true,                false},
-        {"-zmqpubrawblock",  true,                false},
-        {"-zmqpubrawtx",     true,                false},
-        {"-zmqpubsequence",  true,                false},
+        // arg name                UNIX socket support  =suffix allowed
+        {"-i2psam",                false,               false},
+        {"-onion",                 true,                false},
+        {"-proxy",                 true,                true},
+        {"-bind",                  false,               true},
+        {"-rpcbind",               false,               false},
+        {"-torcontrol",            false,               false},
+        {"-whitebind",             false,               false},
+        {"-zmqpubhashblock",       true,                false},
+        {"-zmqpubhashtx",          true,                false},
+        {"-zmqpubrawblock",        true,                false},
+        {"-zmqpubrawtx",           true,                false},
+        {"-zmqpubsequence",        true,                false},
+        {"-zmqpubhashsignedblock", true,                false},
+        {"-zmqpubrawsignedblock",  true,                false},
+        {"-zmqpubpreconfsig",      true,                false},
+        {"-zmqpubpreconftx",       true,                false},
+        {"-zmqpubassetcreate",     true,                false},
+        {"-zmqpubassetdisconnect", true,                false},
+        {"-zmqpubassettransfer",   true,                false},
     }) {
         for (const std::string& param_value : args.GetArgs(param_name)) {
             const std::string param_value_hostport{
@@ -1313,7 +1366,9 @@ static ChainstateLoadResult InitAndLoadChainstate(
     if (!mempool_error.empty()) {
         return {ChainstateLoadStatus::FAILURE_FATAL, mempool_error};
     }
+    const int64_t mempool_max_size_bytes{mempool_opts.max_size_bytes};
     mempool_opts.is_preconf = true;
+    Assert(ApplyArgsManOptions(args, chainparams, mempool_opts)); // already checked in AppInitParameterInteraction
     mempool_opts.limits.ancestor_count = 0;
     mempool_opts.limits.descendant_count = 0;
     node.preconfmempool = std::make_unique<CTxMemPool>(mempool_opts, mempool_error);
@@ -1323,7 +1378,8 @@ static ChainstateLoadResult InitAndLoadChainstate(
 
     LogInfo("* Using %.1f MiB for in-memory UTXO set (plus up to %.1f MiB of unused mempool space)",
             cache_sizes.coins * (1.0 / 1024 / 1024),
-            mempool_opts.max_size_bytes * (1.0 / 1024 / 1024));
+            mempool_max_size_bytes * (1.0 / 1024 / 1024));
+    LogInfo("* Using up to %.1f MiB for the preconf mempool", mempool_opts.max_size_bytes * (1.0 / 1024 / 1024));
     ChainstateManager::Options chainman_opts{
         .chainparams = chainparams,
         .datadir = args.GetDataDirNet(),
@@ -1341,6 +1397,7 @@ static ChainstateLoadResult InitAndLoadChainstate(
             .cache_bytes = cache_sizes.block_tree_db,
             .wipe_data = do_reindex,
         },
+        .auxpow_cache_bytes = cache_sizes.auxpow,
     };
     Assert(ApplyArgsManOptions(args, blockman_opts)); // no error can happen, already checked in AppInitParameterInteraction
 
@@ -1800,6 +1857,9 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
                   index_cache_sizes.filter_index * (1.0 / 1024 / 1024), BlockFilterTypeName(filter_type));
     }
     LogInfo("* Using %.1f MiB for chain state database", kernel_cache_sizes.coins_db * (1.0 / 1024 / 1024));
+    LogInfo("* Using %.1f MiB for asset database", kernel_cache_sizes.asset_db * (1.0 / 1024 / 1024));
+    LogInfo("* Using %.1f MiB for signed block database", kernel_cache_sizes.signed_block_db * (1.0 / 1024 / 1024));
+    LogInfo("* Using %.1f MiB for auxpow cache", kernel_cache_sizes.auxpow * (1.0 / 1024 / 1024));
 
     assert(!node.mempool);
     assert(!node.chainman);
@@ -1873,6 +1933,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         node.indexes.emplace_back(g_coin_stats_index.get());
     }
 
+    if (args.GetBoolArg("-assetindex", DEFAULT_ASSETINDEX)) {
+        g_asset_index = std::make_unique<AssetIndex>(interfaces::MakeChain(node), /*cache_size=*/0, false, do_reindex);
+        node.indexes.emplace_back(g_asset_index.get());
+    }
+
     // Init indexes
     for (auto index : node.indexes) if (!index->Init()) return false;
 
@@ -1967,6 +2032,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             return;
         }
 
+        // Signed block databases written by older versions lack the height entries
+        if (!backfillSignedBlockHeights(chainman) && !chainman.m_interrupt) {
+            LogError("Failed to index signed blocks by height, lookups by height may miss older signed blocks\n");
+        }
+
         // Start indexes initial sync
         if (!StartIndexBackgroundSync(node)) {
             bilingual_str err_str = _("Failed to start indexes, shutting down…");
@@ -2045,6 +2115,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     connOptions.m_peer_connect_timeout = peer_connect_timeout;
     connOptions.whitelist_forcerelay = args.GetBoolArg("-whitelistforcerelay", DEFAULT_WHITELISTFORCERELAY);
     connOptions.whitelist_relay = args.GetBoolArg("-whitelistrelay", DEFAULT_WHITELISTRELAY);
+    connOptions.m_use_sock_wait_set = true;
 
     // Port to bind to if `-bind=addr` is provided without a `:port` suffix.
     const uint16_t default_bind_port =
@@ -6,6 +6,7 @@
 #define BITCOIN_KERNEL_BLOCKMANAGER_OPTS_H
 
 #include <dbwrapper.h>
+#include <kernel/caches.h>
 #include <kernel/notifications_interface.h>
 #include <util/fs.h>
 
@@ -16,6 +17,7 @@ class CChainParams;
 namespace kernel {
 
 static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
+static constexpr bool DEFAULT_MMAP_BLOCKSDIR{false};
 
 /**
  * An options struct for `BlockManager`, more ergonomically referred to as
@@ -24,11 +26,15 @@ static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
 struct BlockManagerOpts {
     const CChainParams& chainparams;
     bool use_xor{DEFAULT_XOR_BLOCKSDIR};
+    //! Read blocks from memory-mapped block files once those are no longer written to
+    bool use_mmap{DEFAULT_MMAP_BLOCKSDIR};
     uint64_t prune_target{0};
     bool fast_prune{false};
     const fs::path blocks_dir;
     Notifications& notifications;
     DBParams block_tree_db_params;
+    //! Memory for auxpows of recent headers, so serving them does not read the block files
+    size_t auxpow_cache_bytes{MAX_AUXPOW_CACHE};
 };
 
 } // namespace kernel
@@ -19,6 +19,8 @@ static constexpr size_t MAX_COINS_DB_CACHE{8_MiB};
 static constexpr size_t MAX_ASSET_DB_CACHE{8_MiB};
 //! Max memory allocated to signed block DB specific cache (bytes)
 static constexpr size_t MAX_SIGNED_BLOCK_DB_CACHE{8_MiB};
+//! Max memory allocated to auxpows of recent headers (bytes)
+static constexpr size_t MAX_AUXPOW_CACHE{64_MiB};
 
 namespace kernel {
 struct CacheSizes {
@@ -27,6 +29,7 @@ struct CacheSizes {
     size_t coins;
     size_t asset_db;
     size_t signed_block_db;
+    size_t auxpow;
 
     CacheSizes(size_t total_cache)
     {
@@ -41,7 +44,10 @@ struct CacheSizes {
 
         signed_block_db = std::min(total_cache / 2, MAX_SIGNED_BLOCK_DB_CACHE);
         total_cache -= signed_block_db;
-        
+
+        auxpow = std::min(total_cache / 8, MAX_AUXPOW_CACHE);
+        total_cache -= auxpow;
+
         coins = total_cache; // the rest goes to the coins cache
     }
 };
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <type_traits>
 
 using namespace util::hex_literals;
@@ -94,6 +95,7 @@ public:
         consensus.BIP66Height = 1; 
         consensus.CSVHeight = 1; 
         consensus.SegwitHeight = 0; 
+        consensus.CompactWitnessHeight = std::numeric_limits<int>::max(); // Not scheduled
         consensus.MinBIP9WarningHeight = 0; // segwit activation height + miner confirmation window
         consensus.powLimit = uint256{"00000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffff"};
         consensus.nPowTargetTimespan = 1 * 1 * 60 * 60; // 1 hour
@@ -116,6 +118,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].threshold = 27; // 90%
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].period = 30;
 
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].bit = 4;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].min_activation_height = 0; // No activation delay
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].threshold = 27; // 90%
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].period = 30;
+
         consensus.nMinimumChainWork = uint256{};
         consensus.defaultAssumeValid = uint256{}; 
 
@@ -196,6 +205,7 @@ public:
         consensus.BIP66Height = 1;
         consensus.CSVHeight = 1;
         consensus.SegwitHeight = 0;
+        consensus.CompactWitnessHeight = std::numeric_limits<int>::max(); // Not scheduled
         consensus.MinBIP9WarningHeight = 0;
         consensus.powLimit = uint256{"00000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffff"};
         consensus.nPowTargetTimespan = 1 * 1 * 60 * 60; // 1 hour
@@ -219,6 +229,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].threshold = 27; // 75%
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].period = 30;
 
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].bit = 4;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].min_activation_height = 0; // No activation delay
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].threshold = 27; // 90%
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].period = 30;
+
         consensus.nMinimumChainWork = uint256{};
         consensus.defaultAssumeValid = uint256{}; 
 
@@ -338,6 +355,7 @@ public:
         consensus.BIP66Height = 1;
         consensus.CSVHeight = 1;
         consensus.SegwitHeight = 1;
+        consensus.CompactWitnessHeight = std::numeric_limits<int>::max(); // Not scheduled
         consensus.nPowTargetTimespan = 14 * 24 * 60 * 60; // two weeks
         consensus.nPowTargetSpacing = 10 * 60;
         consensus.fPowAllowMinDifficultyBlocks = false;
@@ -360,6 +378,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].threshold = 1815; // 90%
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].period = 2016;
 
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].bit = 4;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].min_activation_height = 0; // No activation delay
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].threshold = 1815; // 90%
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].period = 2016;
+
         consensus.nAuxpowChainId = 0x2121;
         consensus.nAuxpowStartHeight = 0;
         consensus.fStrictChainId = true;
@@ -424,6 +449,7 @@ public:
         consensus.BIP66Height = 1;  // Always active unless overridden
         consensus.CSVHeight = 1;    // Always active unless overridden
         consensus.SegwitHeight = 0; // Always active unless overridden
+        consensus.CompactWitnessHeight = 0; // Always active unless overridden
         consensus.MinBIP9WarningHeight = 0;
         consensus.powLimit = uint256{"7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"};
         consensus.nPowTargetTimespan = 1 * 1 * 60 * 60; // 1 hour
@@ -446,6 +472,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].threshold = 108; // 75%
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].period = 144;
 
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].bit = 4;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nStartTime = Consensus::BIP9Deployment::ALWAYS_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].min_activation_height = 0; // No activation delay
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].threshold = 108; // 75%
+        consensus.vDeployments[Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS].period = 144;
+
         consensus.nMinimumChainWork = uint256{};
         consensus.defaultAssumeValid = uint256{};
 
@@ -483,6 +516,9 @@ public:
             case Consensus::BuriedDeployment::DEPLOYMENT_CSV:
                 consensus.CSVHeight = int{height};
                 break;
+            case Consensus::BuriedDeployment::DEPLOYMENT_COMPACT_WITNESS:
+                consensus.CompactWitnessHeight = int{height};
+                break;
             }
         }
 
@@ -20,14 +20,17 @@
 #include <uint256.h>
 #include <util/check.h>
 #include <util/overflow.h>
+#include <util/threadnames.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 
 namespace kernel {
@@ -53,6 +56,11 @@ static void TxOutSer(T& ss, const COutPoint& outpoint, const Coin& coin)
     ss << outpoint;
     ss << static_cast<uint32_t>((coin.nHeight << 1) + coin.fCoinBase);
     ss << coin.out;
+    // Asset state is only committed for asset outputs, so the serialization of
+    // plain outputs (and the assumeutxo hashes built from it) is unchanged.
+    if (coin.fBitAsset || coin.fBitAssetControl) {
+        ss << coin.fBitAsset << coin.fBitAssetControl << coin.nAssetID;
+    }
 }
 
 static void ApplyCoinHash(HashWriter& ss, const COutPoint& outpoint, const Coin& coin)
@@ -74,6 +82,133 @@ void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& c
     muhash.Remove(MakeUCharSpan(ss));
 }
 
+void ApplyCoinHash(MuHashAccumulator& muhash, const COutPoint& outpoint, const Coin& coin)
+{
+    DataStream ss{};
+    TxOutSer(ss, outpoint, coin);
+    muhash.Insert(MakeUCharSpan(ss));
+}
+
+void RemoveCoinHash(MuHashAccumulator& muhash, const COutPoint& outpoint, const Coin& coin)
+{
+    DataStream ss{};
+    TxOutSer(ss, outpoint, coin);
+    muhash.Remove(MakeUCharSpan(ss));
+}
+
+/** Number of elements handed to a MuHashAccumulator worker at once */
+static constexpr size_t MUHASH_BATCH_ELEMENTS{256};
+
+MuHashAccumulator::MuHashAccumulator(int worker_threads)
+    : m_partials(std::max(worker_threads, 0))
+{
+}
+
+MuHashAccumulator::~MuHashAccumulator()
+{
+    StopWorkers();
+}
+
+void MuHashAccumulator::StartWorkers()
+{
+    WITH_LOCK(m_mutex, m_stop = false);
+    m_workers.reserve(m_partials.size());
+    for (size_t n = 0; n < m_partials.size(); ++n) {
+        m_workers.emplace_back([this, n]() {
+            util::ThreadRename(strprintf("muhash.%i", n));
+            Loop(m_partials[n]);
+        });
+    }
+}
+
+void MuHashAccumulator::StopWorkers()
+{
+    if (m_workers.empty()) return;
+    // Workers only exit once the queue is empty
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_work_cv.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+int MuHashAccumulator::DefaultWorkerThreads()
+{
+    return std::clamp<int>(std::thread::hardware_concurrency(), 1, MAX_MUHASH_WORKER_THREADS + 1) - 1;
+}
+
+void MuHashAccumulator::Add(std::span<const unsigned char> in, bool remove)
+{
+    if (m_partials.empty()) {
+        remove ? m_direct.Remove(in) : m_direct.Insert(in);
+        return;
+    }
+    m_batch.data.insert(m_batch.data.end(), in.begin(), in.end());
+    m_batch.elements.emplace_back(m_batch.data.size(), remove);
+    if (m_batch.elements.size() >= MUHASH_BATCH_ELEMENTS) Push();
+}
+
+void MuHashAccumulator::Push()
+{
+    if (m_batch.elements.empty()) return;
+    if (m_workers.empty()) StartWorkers();
+    {
+        // Bound the memory used by queued batches
+        WAIT_LOCK(m_mutex, lock);
+        m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_pending < 2 * m_workers.size(); });
+        m_queue.push_back(std::exchange(m_batch, {}));
+        ++m_pending;
+    }
+    m_work_cv.notify_one();
+}
+
+void MuHashAccumulator::Loop(Partial& partial)
+{
+    while (true) {
+        Batch batch;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_work_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            batch = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        ApplyBatch(partial.muhash, batch);
+        partial.used = true;
+        WITH_LOCK(m_mutex, --m_pending);
+        m_done_cv.notify_all();
+    }
+}
+
+void MuHashAccumulator::ApplyBatch(MuHash3072& muhash, const Batch& batch)
+{
+    uint32_t begin{0};
+    for (const auto& [end, remove] : batch.elements) {
+        const std::span<const unsigned char> element{batch.data.data() + begin, end - begin};
+        remove ? muhash.Remove(element) : muhash.Insert(element);
+        begin = end;
+    }
+}
+
+MuHash3072 MuHashAccumulator::Finish()
+{
+    if (m_workers.empty()) {
+        // Not worth starting the workers for a single batch
+        ApplyBatch(m_direct, std::exchange(m_batch, {}));
+    } else {
+        Push();
+        StopWorkers();
+    }
+    MuHash3072 result{std::exchange(m_direct, {})};
+    for (Partial& partial : m_partials) {
+        if (!partial.used) continue;
+        result *= partial.muhash;
+        partial = {};
+    }
+    return result;
+}
+
 static void ApplyCoinHash(std::nullptr_t, const COutPoint& outpoint, const Coin& coin) {}
 
 //! Warning: be very careful when changing this! assumeutxo and UTXO snapshot
@@ -104,8 +239,16 @@ static void ApplyStats(CCoinsStats& stats, const uint256& hash, const std::map<u
     stats.nTransactions++;
     for (auto it = outputs.begin(); it != outputs.end(); ++it) {
         stats.nTransactionOutputs++;
-        if (stats.total_amount.has_value()) {
-            stats.total_amount = CheckedAdd(*stats.total_amount, it->second.out.nValue);
+        const Coin& coin{it->second};
+        if (!coin.IsBitAsset()) {
+            if (stats.total_amount.has_value()) {
+                stats.total_amount = CheckedAdd(*stats.total_amount, coin.out.nValue);
+            }
+        } else if (!coin.IsBitAssetController()) {
+            if (stats.total_assets.has_value()) {
+                stats.total_assets = CheckedAdd(*stats.total_assets, coin.out.nValue);
+            }
+            stats.asset_amounts[coin.nAssetID] += coin.out.nValue;
         }
         stats.nBogoSize += GetBogoSize(it->second.out.scriptPubKey);
     }
@@ -113,7 +256,7 @@ static void ApplyStats(CCoinsStats& stats, const uint256& hash, const std::map<u
 
 //! Calculate statistics about the unspent transaction output set
 template <typename T>
-static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T&& hash_obj, const std::function<void()>& interruption_point)
 {
     std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
     assert(pcursor);
@@ -163,7 +306,7 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsV
             return ComputeUTXOStats(view, stats, ss, interruption_point);
         }
         case(CoinStatsHashType::MUHASH): {
-            MuHash3072 muhash;
+            MuHashAccumulator muhash;
             return ComputeUTXOStats(view, stats, muhash, interruption_point);
         }
         case(CoinStatsHashType::NONE): {
@@ -189,6 +332,11 @@ static void FinalizeHash(MuHash3072& muhash, CCoinsStats& stats)
     muhash.Finalize(out);
     stats.hashSerialized = out;
 }
+static void FinalizeHash(MuHashAccumulator& muhash, CCoinsStats& stats)
+{
+    MuHash3072 product{muhash.Finish()};
+    FinalizeHash(product, stats);
+}
 static void FinalizeHash(std::nullptr_t, CCoinsStats& stats) {}
 
 } // namespace kernel
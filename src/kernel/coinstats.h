@@ -8,11 +8,19 @@
 #include <consensus/amount.h>
 #include <crypto/muhash.h>
 #include <streams.h>
+#include <sync.h>
 #include <uint256.h>
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <map>
 #include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
 
 class CCoinsView;
 class Coin;
@@ -39,7 +47,10 @@ struct CCoinsStats {
     uint64_t nDiskSize{0};
     //! The total amount, or nullopt if an overflow occurred calculating it
     std::optional<CAmount> total_amount{0};
+    //! The total asset amount excluding controller outputs, or nullopt if an overflow occurred calculating it
     std::optional<CAmount> total_assets{0};
+    //! Asset amount per asset id, excluding controller outputs (only filled when scanning the UTXO set)
+    std::map<std::vector<unsigned char>, CAmount> asset_amounts;
 
     //! The number of coins contained.
     uint64_t coins_count{0};
@@ -72,10 +83,81 @@ struct CCoinsStats {
     CCoinsStats(int block_height, const uint256& block_hash);
 };
 
+/** Maximum number of worker threads of a MuHashAccumulator */
+static constexpr int MAX_MUHASH_WORKER_THREADS{7};
+
+/**
+ * Computes the MuHash3072 of many set updates on worker threads.
+ *
+ * Updates are collected into batches that the worker threads hash into
+ * partial MuHash3072 values of their own. As MuHash updates commute, Finish()
+ * multiplies the partial values into the same result as applying every update
+ * to a single MuHash3072. Without worker threads updates are applied directly.
+ *
+ * The worker threads are started once a batch is full and stopped by Finish(),
+ * so they only exist while an update is being computed.
+ */
+class MuHashAccumulator
+{
+public:
+    explicit MuHashAccumulator(int worker_threads = DefaultWorkerThreads());
+    ~MuHashAccumulator();
+
+    MuHashAccumulator(const MuHashAccumulator&) = delete;
+    MuHashAccumulator& operator=(const MuHashAccumulator&) = delete;
+
+    void Insert(std::span<const unsigned char> in) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex) { Add(in, /*remove=*/false); }
+    void Remove(std::span<const unsigned char> in) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex) { Add(in, /*remove=*/true); }
+
+    /** Wait for all queued updates and return their product, which resets the accumulator. */
+    MuHash3072 Finish() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** One worker thread per additional core, up to MAX_MUHASH_WORKER_THREADS. */
+    static int DefaultWorkerThreads();
+
+private:
+    /** Serialized elements and, for each, its end offset and whether it is removed. */
+    struct Batch {
+        std::vector<unsigned char> data;
+        std::vector<std::pair<uint32_t, bool>> elements;
+    };
+
+    /** Partial product of a worker, only accessed by that worker while the workers run. */
+    struct Partial {
+        MuHash3072 muhash;
+        bool used{false};
+    };
+
+    Mutex m_mutex;
+    //! Signals workers that a batch was queued or that they should exit
+    std::condition_variable m_work_cv;
+    //! Signals that a worker completed a batch
+    std::condition_variable m_done_cv;
+    std::deque<Batch> m_queue GUARDED_BY(m_mutex);
+    //! Number of batches queued or being processed
+    size_t m_pending GUARDED_BY(m_mutex){0};
+    bool m_stop GUARDED_BY(m_mutex){false};
+
+    std::vector<Partial> m_partials;
+    std::vector<std::thread> m_workers;
+    Batch m_batch;
+    MuHash3072 m_direct;
+
+    void Add(std::span<const unsigned char> in, bool remove) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Push() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void StartWorkers() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Wait for the workers to complete the queued batches and exit. */
+    void StopWorkers() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Loop(Partial& partial) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    static void ApplyBatch(MuHash3072& muhash, const Batch& batch);
+};
+
 uint64_t GetBogoSize(const CScript& script_pub_key);
 
 void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
 void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
+void ApplyCoinHash(MuHashAccumulator& muhash, const COutPoint& outpoint, const Coin& coin);
+void RemoveCoinHash(MuHashAccumulator& muhash, const COutPoint& outpoint, const Coin& coin);
 
 std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsView* view, node::BlockManager& blockman, const std::function<void()>& interruption_point = {});
 } // namespace kernel
@@ -145,6 +145,8 @@ public:
     }
     int32_t GetTxWeight() const { return nTxWeight; }
     uint64_t GetExpiredHeight() const { return expireSignedHeight; }
+    //! The preconf fee bid, carried by the first output of preconf transactions
+    CAmount GetPreConfFee() const { return tx->vout.empty() ? 0 : tx->vout[0].nValue; }
     std::chrono::seconds GetTime() const { return std::chrono::seconds{nTime}; }
     unsigned int GetHeight() const { return entryHeight; }
     uint64_t GetSequence() const { return entry_sequence; }
@@ -17,6 +17,8 @@ class ValidationSignals;
 
 /** Default for -maxmempool, maximum megabytes of mempool memory usage */
 static constexpr unsigned int DEFAULT_MAX_MEMPOOL_SIZE_MB{300};
+/** Default for -maxpreconfmempool, maximum megabytes of preconf mempool memory usage */
+static constexpr unsigned int DEFAULT_MAX_PRECONF_MEMPOOL_SIZE_MB{100};
 /** Default for -maxmempool when blocksonly is set */
 static constexpr unsigned int DEFAULT_BLOCKSONLY_MAX_MEMPOOL_SIZE_MB{5};
 /** Default for -mempoolexpiry, expiration time for mempool transactions in hours */
@@ -2100,7 +2100,14 @@ void CConnman::SocketHandler()
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+        if (m_sock_wait_set && !m_sock_wait_set->Update(events_per_sock)) {
+            LogPrintf("Waiting on sockets with poll(2) from now on\n");
+            m_sock_wait_set.reset();
+        }
+        const bool waited{!events_per_sock.empty() &&
+                          (m_sock_wait_set ? m_sock_wait_set->Wait(timeout, events_per_sock) :
+                                             events_per_sock.begin()->first->WaitMany(timeout, events_per_sock))};
+        if (!waited) {
             interruptNet.sleep_for(timeout);
         }
 
@@ -2181,7 +2188,7 @@ void CConnman::SocketHandlerConnected(const std::vector<CNode*>& nodes,
                 }
                 RecordBytesRecv(nBytes);
                 if (notify) {
-                    pnode->MarkReceivedMsgsForProcessing();
+                    if (pnode->MarkReceivedMsgsForProcessing()) WakePreconfMessageHandler();
                     WakeMessageHandler();
                 }
             }
@@ -2245,6 +2252,15 @@ void CConnman::WakeMessageHandler()
     condMsgProc.notify_one();
 }
 
+void CConnman::WakePreconfMessageHandler()
+{
+    {
+        LOCK(mutexPreconfMsgProc);
+        fPreconfMsgProcWake = true;
+    }
+    condPreconfMsgProc.notify_one();
+}
+
 void CConnman::ThreadDNSAddressSeed()
 {
     int outbound_connection_count = 0;
@@ -3077,6 +3093,34 @@ void CConnman::ThreadMessageHandler()
     }
 }
 
+void CConnman::ThreadPreconfMessageHandler()
+{
+    // Preconf relay messages are processed here, so that they do not wait for the
+    // message handler thread while it validates blocks or serves other peers.
+    while (!flagInterruptMsgProc) {
+        bool fMoreWork = false;
+
+        {
+            const NodesSnapshot snap{*this, /*shuffle=*/true};
+
+            for (CNode* pnode : snap.Nodes()) {
+                if (pnode->fDisconnect)
+                    continue;
+
+                fMoreWork |= m_msgproc->ProcessPreconfMessages(pnode, flagInterruptMsgProc);
+                if (flagInterruptMsgProc)
+                    return;
+            }
+        }
+
+        WAIT_LOCK(mutexPreconfMsgProc, lock);
+        if (!fMoreWork) {
+            condPreconfMsgProc.wait_until(lock, std::chrono::steady_clock::now() + std::chrono::milliseconds(100), [this]() EXCLUSIVE_LOCKS_REQUIRED(mutexPreconfMsgProc) { return fPreconfMsgProcWake; });
+        }
+        fPreconfMsgProcWake = false;
+    }
+}
+
 void CConnman::ThreadI2PAcceptIncoming()
 {
     static constexpr auto err_wait_begin = 1s;
@@ -3360,6 +3404,10 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
         LOCK(mutexMsgProc);
         fMsgProcWake = false;
     }
+    {
+        LOCK(mutexPreconfMsgProc);
+        fPreconfMsgProcWake = false;
+    }
 
     // Send and receive from sockets, accept connections
     threadSocketHandler = std::thread(&util::TraceThread, "net", [this] { ThreadSocketHandler(); });
@@ -3388,6 +3436,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 
     // Process messages
     threadMessageHandler = std::thread(&util::TraceThread, "msghand", [this] { ThreadMessageHandler(); });
+    threadPreconfMessageHandler = std::thread(&util::TraceThread, "preconf", [this] { ThreadPreconfMessageHandler(); });
 
     if (m_i2p_sam_session) {
         threadI2PAcceptIncoming =
@@ -3428,6 +3477,8 @@ void CConnman::Interrupt()
         flagInterruptMsgProc = true;
     }
     condMsgProc.notify_all();
+    WITH_LOCK(mutexPreconfMsgProc, fPreconfMsgProcWake = true);
+    condPreconfMsgProc.notify_all();
 
     interruptNet();
     g_socks5_interrupt();
@@ -3452,6 +3503,8 @@ void CConnman::StopThreads()
     }
     if (threadMessageHandler.joinable())
         threadMessageHandler.join();
+    if (threadPreconfMessageHandler.joinable())
+        threadPreconfMessageHandler.join();
     if (threadOpenConnections.joinable())
         threadOpenConnections.join();
     if (threadOpenAddedConnections.joinable())
@@ -3478,6 +3531,9 @@ void CConnman::StopNodes()
         }
     }
 
+    // Release the sockets still registered, so that closing them below takes effect.
+    m_sock_wait_set.reset();
+
     // Delete peer connections.
     std::vector<CNode*> nodes;
     WITH_LOCK(m_nodes_mutex, nodes.swap(m_nodes));
@@ -3840,7 +3896,7 @@ CNode::CNode(NodeId idIn,
     }
 }
 
-void CNode::MarkReceivedMsgsForProcessing()
+bool CNode::MarkReceivedMsgsForProcessing()
 {
     AssertLockNotHeld(m_msg_process_queue_mutex);
 
@@ -3855,20 +3911,45 @@ void CNode::MarkReceivedMsgsForProcessing()
     m_msg_process_queue.splice(m_msg_process_queue.end(), vRecvMsg);
     m_msg_process_queue_size += nSizeAdded;
     fPauseRecv = m_msg_process_queue_size > m_recv_flood_size;
+    return !m_msg_in_flight && !m_msg_process_queue.empty() && IsPreconfRelayMsgType(m_msg_process_queue.front().m_type);
 }
 
-std::optional<std::pair<CNetMessage, bool>> CNode::PollMessage()
+std::optional<std::pair<CNetMessage, bool>> CNode::PollNextMessage(bool preconf)
 {
-    LOCK(m_msg_process_queue_mutex);
-    if (m_msg_process_queue.empty()) return std::nullopt;
+    AssertLockHeld(m_msg_process_queue_mutex);
+    // The message handler and the preconf thread take turns, so a message is only
+    // processed once all messages received before it are
+    if (m_msg_in_flight || m_msg_process_queue.empty() || IsPreconfRelayMsgType(m_msg_process_queue.front().m_type) != preconf) {
+        return std::nullopt;
+    }
 
     std::list<CNetMessage> msgs;
     // Just take one message
     msgs.splice(msgs.begin(), m_msg_process_queue, m_msg_process_queue.begin());
     m_msg_process_queue_size -= msgs.front().GetMemoryUsage();
     fPauseRecv = m_msg_process_queue_size > m_recv_flood_size;
+    m_msg_in_flight = true;
+
+    return std::make_pair(std::move(msgs.front()), !m_msg_process_queue.empty() && IsPreconfRelayMsgType(m_msg_process_queue.front().m_type) == preconf);
+}
 
-    return std::make_pair(std::move(msgs.front()), !m_msg_process_queue.empty());
+std::optional<std::pair<CNetMessage, bool>> CNode::PollMessage()
+{
+    LOCK(m_msg_process_queue_mutex);
+    return PollNextMessage(/*preconf=*/false);
+}
+
+std::optional<std::pair<CNetMessage, bool>> CNode::PollPreconfMessage()
+{
+    LOCK(m_msg_process_queue_mutex);
+    return PollNextMessage(/*preconf=*/true);
+}
+
+bool CNode::MarkMessageProcessed()
+{
+    LOCK(m_msg_process_queue_mutex);
+    m_msg_in_flight = false;
+    return !m_msg_process_queue.empty() && IsPreconfRelayMsgType(m_msg_process_queue.front().m_type);
 }
 
 bool CConnman::NodeFullyConnected(const CNode* pnode)
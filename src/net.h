@@ -739,18 +739,37 @@ public:
 
     const ConnectionType m_conn_type;
 
-    /** Move all messages from the received queue to the processing queue. */
-    void MarkReceivedMsgsForProcessing()
+    /**
+     * Move all messages from the received queue to the processing queue.
+     * @return true if the next message to process is a preconf relay message (see IsPreconfRelayMsgType).
+     */
+    bool MarkReceivedMsgsForProcessing()
         EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
 
     /** Poll the next message from the processing queue of this connection.
      *
-     * Returns std::nullopt if the processing queue is empty, or a pair
+     * Preconf relay messages are left for PollPreconfMessage(). Messages are handed out
+     * in the order they were received, and only once the previous one was processed
+     * (see MarkMessageProcessed), so a preconf relay message never overtakes the
+     * transactions it refers to.
+     *
+     * Returns std::nullopt if there is no message to process now, or a pair
      * consisting of the message and a bool that indicates if the processing
-     * queue has more entries. */
+     * queue has more entries for the caller. */
     std::optional<std::pair<CNetMessage, bool>> PollMessage()
         EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
 
+    /** Same as PollMessage(), for preconf relay messages only. */
+    std::optional<std::pair<CNetMessage, bool>> PollPreconfMessage()
+        EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
+
+    /**
+     * Let the next message be polled, called once a polled message was processed.
+     * @return true if the next message to process is a preconf relay message.
+     */
+    bool MarkMessageProcessed()
+        EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
+
     /** Account for the total size of a sent message in the per msg type connection stats. */
     void AccountForSentBytes(const std::string& msg_type, size_t sent_bytes)
         EXCLUSIVE_LOCKS_REQUIRED(cs_vSend)
@@ -981,6 +1000,12 @@ private:
     Mutex m_msg_process_queue_mutex;
     std::list<CNetMessage> m_msg_process_queue GUARDED_BY(m_msg_process_queue_mutex);
     size_t m_msg_process_queue_size GUARDED_BY(m_msg_process_queue_mutex){0};
+    /** A polled message is being processed, by the message handler or the preconf thread. */
+    bool m_msg_in_flight GUARDED_BY(m_msg_process_queue_mutex){false};
+
+    /** Take the next message for the message handler (preconf=false) or the preconf thread (preconf=true). */
+    std::optional<std::pair<CNetMessage, bool>> PollNextMessage(bool preconf)
+        EXCLUSIVE_LOCKS_REQUIRED(m_msg_process_queue_mutex);
 
     // Our address, as reported by the peer
     CService m_addr_local GUARDED_BY(m_addr_local_mutex);
@@ -1032,6 +1057,16 @@ public:
     */
     virtual bool ProcessMessages(CNode* pnode, std::atomic<bool>& interrupt) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex) = 0;
 
+    /**
+    * Process preconf relay messages received from a given node. Called from its own
+    * thread, concurrently with ProcessMessages() and SendMessages().
+    *
+    * @param[in]   pnode           The node which we have received messages from.
+    * @param[in]   interrupt       Interrupt condition for processing threads
+    * @return                      True if there is more work to be done
+    */
+    virtual bool ProcessPreconfMessages(CNode* pnode, std::atomic<bool>& interrupt) EXCLUSIVE_LOCKS_REQUIRED(!g_msgproc_mutex) = 0;
+
     /**
     * Send queued protocol messages to a given node.
     *
@@ -1080,6 +1115,9 @@ public:
         bool m_i2p_accept_incoming;
         bool whitelist_forcerelay = DEFAULT_WHITELISTFORCERELAY;
         bool whitelist_relay = DEFAULT_WHITELISTRELAY;
+        /// Keep sockets registered with the kernel between waits, see SockWaitSet.
+        /// Only for sockets backed by real file descriptors.
+        bool m_use_sock_wait_set = false;
     };
 
     void Init(const Options& connOptions) EXCLUSIVE_LOCKS_REQUIRED(!m_added_nodes_mutex, !m_total_bytes_sent_mutex)
@@ -1117,6 +1155,7 @@ public:
         m_onion_binds = connOptions.onion_binds;
         whitelist_forcerelay = connOptions.whitelist_forcerelay;
         whitelist_relay = connOptions.whitelist_relay;
+        if (connOptions.m_use_sock_wait_set) m_sock_wait_set = SockWaitSet::Make();
     }
 
     CConnman(uint64_t seed0, uint64_t seed1, AddrMan& addrman, const NetGroupManager& netgroupman,
@@ -1124,7 +1163,7 @@ public:
 
     ~CConnman();
 
-    bool Start(CScheduler& scheduler, const Options& options) EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !m_added_nodes_mutex, !m_addr_fetches_mutex, !mutexMsgProc);
+    bool Start(CScheduler& scheduler, const Options& options) EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !m_added_nodes_mutex, !m_addr_fetches_mutex, !mutexMsgProc, !mutexPreconfMsgProc);
 
     void StopThreads();
     void StopNodes();
@@ -1134,7 +1173,7 @@ public:
         StopNodes();
     };
 
-    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc, !mutexPreconfMsgProc);
     bool GetNetworkActive() const { return fNetworkActive; };
     bool GetUseAddrmanOutgoing() const { return m_use_addrman_outgoing; };
     void SetNetworkActive(bool active);
@@ -1279,6 +1318,7 @@ public:
     CSipHasher GetDeterministicRandomizer(uint64_t id) const;
 
     void WakeMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
+    void WakePreconfMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexPreconfMsgProc);
 
     /** Return true if we should disconnect the peer for failing an inactivity check. */
     bool ShouldRunInactivityChecks(const CNode& node, std::chrono::seconds now) const;
@@ -1312,6 +1352,7 @@ private:
     void ProcessAddrFetch() EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_unused_i2p_sessions_mutex);
     void ThreadOpenConnections(std::vector<std::string> connect, std::span<const std::string> seed_nodes) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_added_nodes_mutex, !m_nodes_mutex, !m_unused_i2p_sessions_mutex, !m_reconnections_mutex);
     void ThreadMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
+    void ThreadPreconfMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexPreconfMsgProc);
     void ThreadI2PAcceptIncoming();
     void AcceptConnection(const ListenSocket& hListenSocket);
 
@@ -1343,7 +1384,7 @@ private:
     /**
      * Check connected and listening sockets for IO readiness and process them accordingly.
      */
-    void SocketHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc);
+    void SocketHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc, !mutexPreconfMsgProc);
 
     /**
      * Do the read/write for connected sockets that are ready for IO.
@@ -1352,7 +1393,7 @@ private:
      */
     void SocketHandlerConnected(const std::vector<CNode*>& nodes,
                                 const Sock::EventsPerSock& events_per_sock)
-        EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc, !mutexPreconfMsgProc);
 
     /**
      * Accept incoming connections, one from each read-ready listening socket.
@@ -1360,7 +1401,7 @@ private:
      */
     void SocketHandlerListening(const Sock::EventsPerSock& events_per_sock);
 
-    void ThreadSocketHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc, !m_nodes_mutex, !m_reconnections_mutex);
+    void ThreadSocketHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc, !mutexPreconfMsgProc, !m_nodes_mutex, !m_reconnections_mutex);
     void ThreadDNSAddressSeed() EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_nodes_mutex);
 
     uint64_t CalculateKeyedNetGroup(const CNetAddr& ad) const;
@@ -1444,6 +1485,14 @@ private:
     unsigned int nReceiveFloodSize{0};
 
     std::vector<ListenSocket> vhListenSocket;
+
+    /**
+     * Sockets the socket handler waits on, kept registered between its iterations.
+     * nullptr if not used or not available, then `Sock::WaitMany()` is used instead.
+     * Only accessed by the socket handler thread while it runs.
+     */
+    std::unique_ptr<SockWaitSet> m_sock_wait_set;
+
     std::atomic<bool> fNetworkActive{true};
     bool fAddressesInitialized{false};
     AddrMan& addrman;
@@ -1553,6 +1602,12 @@ private:
     Mutex mutexMsgProc;
     std::atomic<bool> flagInterruptMsgProc{false};
 
+    /** flag for waking the preconf message processor. */
+    bool fPreconfMsgProcWake GUARDED_BY(mutexPreconfMsgProc){false};
+
+    std::condition_variable condPreconfMsgProc;
+    Mutex mutexPreconfMsgProc;
+
     /**
      * This is signaled when network activity should cease.
      * A pointer to it is saved in `m_i2p_sam_session`, so make sure that
@@ -1573,6 +1628,7 @@ private:
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
     std::thread threadMessageHandler;
+    std::thread threadPreconfMessageHandler;
     std::thread threadI2PAcceptIncoming;
 
     /** flag for deciding to connect to an extra outbound peer,
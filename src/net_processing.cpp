@@ -88,6 +88,7 @@
 #include <coordinate/anduro_deposit.h>
 #include <coordinate/coordinate_mempool_entry.h>
 #include <coordinate/coordinate_preconf.h>
+#include <coordinate/federation_witness.h>
 #include <node/transaction.h>
 #include <coordinate/anduro_validator.h>
 
@@ -115,8 +116,12 @@ static constexpr auto EXTRA_PEER_CHECK_INTERVAL{45s};
 /** Minimum time an outbound-peer-eviction candidate must be connected for, in order to evict */
 static constexpr auto MINIMUM_CONNECT_TIME{30s};
 
-static constexpr auto PEG_CHECK_TIME{5s};
-static constexpr auto PRE_CONF_CHECK_TIME{1s};
+/** How long to wait for a peer to answer a precommitment request before asking another peer */
+static constexpr auto COMMITMENT_REQUEST_TIMEOUT{5s};
+/** How long before a peer that did not answer a precommitment request is asked again */
+static constexpr auto COMMITMENT_REQUEST_RETRY_INTERVAL{30s};
+/** Maximum number of peers asked for the next block's precommitments at the same time */
+static constexpr size_t MAX_COMMITMENT_REQUESTS_IN_FLIGHT{2};
 
 
 /** SHA256("main address relay")[0:8] */
@@ -207,6 +212,12 @@ static constexpr size_t MAX_ADDR_PROCESSING_TOKEN_BUCKET{MAX_ADDR_TO_SEND};
 /** The compactblocks version we support. See BIP 152. */
 static constexpr uint64_t CMPCTBLOCKS_VERSION{2};
 
+/** Federation witness encoding used in preconf signature and precommitment messages with this peer */
+static const FederationWitnessSerParams& FederationWitnessParams(const CNode& node)
+{
+    return node.GetCommonVersion() >= FEDERATION_BINARY_WITNESS_VERSION ? FEDERATION_WITNESS_BINARY : FEDERATION_WITNESS_HEX;
+}
+
 // Internal stuff
 namespace {
 
@@ -418,10 +429,14 @@ struct Peer {
     /** Time of the last getheaders message to this peer */
     NodeClock::time_point m_last_getheaders_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
 
-    /** Time of the last getheaders message to this peer */
-    NodeClock::time_point m_last_peg_req_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
+    /** Highest block height whose precommitments were exchanged with this peer */
+    int32_t m_commitment_height_known GUARDED_BY(NetEventsInterface::g_msgproc_mutex){-1};
+
+    /** Precommitment pool sequence and next block height at the last precommitment announcement to this peer */
+    std::pair<uint64_t, int32_t> m_commitment_announced GUARDED_BY(NetEventsInterface::g_msgproc_mutex){0, -1};
 
-    NodeClock::time_point m_last_pre_conf_req_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
+    /** Preconf relay sequence at the last preconf signature and signed block announcement to this peer */
+    uint64_t m_preconf_relay_sequence GUARDED_BY(NetEventsInterface::g_msgproc_mutex){0};
 
 
     /** Protects m_headers_sync **/
@@ -555,6 +570,8 @@ public:
     bool HasAllDesirableServiceFlags(ServiceFlags services) const override;
     bool ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, g_msgproc_mutex, !m_tx_download_mutex);
+    bool ProcessPreconfMessages(CNode* pfrom, std::atomic<bool>& interrupt) override
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !g_msgproc_mutex);
     bool SendMessages(CNode* pto) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_most_recent_block_mutex, g_msgproc_mutex, !m_tx_download_mutex);
     void NewSignedBlockTimer(uint32_t nTime) override
@@ -582,6 +599,10 @@ public:
     ServiceFlags GetDesirableServiceFlags(ServiceFlags services) const override;
 
 private:
+    /** Process a preconf relay message. Must not use state only accessed by the msg processing thread. */
+    void ProcessPreconfMessage(CNode& pfrom, const std::string& msg_type, DataStream& vRecv)
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+
     /** Consider evicting an outbound peer based on the amount of time they've been behind our tip */
     void ConsiderEviction(CNode& pto, Peer& peer, std::chrono::seconds time_in_seconds) EXCLUSIVE_LOCKS_REQUIRED(cs_main, g_msgproc_mutex);
 
@@ -890,6 +911,10 @@ private:
     std::chrono::microseconds NextInvToInbounds(std::chrono::microseconds now,
                                                 std::chrono::seconds average_interval) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
 
+    /** Block height the outstanding precommitment requests are for */
+    int32_t m_commitment_request_height GUARDED_BY(g_msgproc_mutex){-1};
+    /** Peers asked for the precommitments at m_commitment_request_height, and when */
+    std::map<NodeId, std::chrono::microseconds> m_commitment_requests GUARDED_BY(g_msgproc_mutex);
 
     // All of the following cache a recent block, and are protected by m_most_recent_block_mutex
     Mutex m_most_recent_block_mutex;
@@ -2364,7 +2389,15 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         // Fast-path: in this case it is possible to serve the block directly from disk,
         // as the network format matches the format on disk
         std::vector<std::byte> block_data;
-        if (!m_chainman.m_blockman.ReadRawBlock(block_data, block_pos)) {
+        if (const auto mapped{m_chainman.m_blockman.ReadMappedBlock(block_pos)}) {
+            // Copy the block from the memory-mapped block file straight into the
+            // message, and de-obfuscate it there
+            CSerializedNetMsg msg;
+            msg.m_type = NetMsgType::BLOCK;
+            msg.data.resize(mapped->Size());
+            mapped->CopyTo(MakeWritableByteSpan(msg.data));
+            m_connman.PushMessage(&pfrom, std::move(msg));
+        } else if (!m_chainman.m_blockman.ReadRawBlock(block_data, block_pos)) {
             if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
                 LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
             } else {
@@ -2372,8 +2405,9 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
             }
             pfrom.fDisconnect = true;
             return;
+        } else {
+            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{block_data});
         }
-        MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{block_data});
         // Don't set pblock as we've sent the block
     } else {
         // Send block from disk
@@ -4940,34 +4974,29 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         while(incr<3) {
             std::vector<AnduroPreCommitment> pending_commitments = listPendingCommitment(currentHeight + incr);
             if(pending_commitments.size()>0) {
-                MakeAndPushMessage(pfrom, NetMsgType::PREBLOCKSIGNREPONSE, pending_commitments);
+                MakeAndPushMessage(pfrom, NetMsgType::PREBLOCKSIGNREPONSE, FederationWitnessParams(pfrom)(pending_commitments));
+                peer->m_commitment_height_known = std::max<int32_t>(peer->m_commitment_height_known, currentHeight + incr);
             }
             incr = incr + 1;
         }
         return;
     }
 
-    // receive request from other peer to get recent anduro pre signed block information
-    if (msg_type == NetMsgType::PRECONFSIGNATUREPUSH) {
-        std::vector<CoordinatePreConfSig> vData;
-        vRecv >> vData;
-        includePreConfSigWitness(vData,m_chainman);
-        return;
-    }
-
-    if (msg_type == NetMsgType::PRECONFFINALIZEPUSH && !m_chainman.IsInitialBlockDownload()) {
-        std::vector<SignedBlock> vData;
-        vRecv >> TX_WITH_WITNESS(vData);
-        includePreConfBlockFromNetwork(vData,m_chainman);
+    // normally handled by ProcessPreconfMessages(), unless called directly
+    if (IsPreconfRelayMsgType(msg_type)) {
+        ProcessPreconfMessage(pfrom, msg_type, vRecv);
         return;
     }
 
     // receive response from other peer for recent anduro pre signed block information
     if (msg_type == NetMsgType::PREBLOCKSIGNREPONSE) {
         std::vector<AnduroPreCommitment> vData;
-        vRecv >> vData;
-        if(isPreCommitmentValid(vData,m_chainman)) {
-           includePreCommitmentSignature(vData);
+        vRecv >> FederationWitnessParams(pfrom)(vData);
+        m_commitment_requests.erase(pfrom.GetId());
+        if (includePreCommitmentSignature(vData, m_chainman)) {
+            for (const AnduroPreCommitment& commitment : vData) {
+                peer->m_commitment_height_known = std::max(peer->m_commitment_height_known, commitment.block_height);
+            }
         }
         return;
     }
@@ -5207,6 +5236,91 @@ bool PeerManagerImpl::MaybeDiscourageAndDisconnect(CNode& pnode, Peer& peer)
     return true;
 }
 
+void PeerManagerImpl::ProcessPreconfMessage(CNode& pfrom, const std::string& msg_type, DataStream& vRecv)
+{
+    // receive request from other peer to get recent anduro pre signed block information
+    if (msg_type == NetMsgType::PRECONFSIGNATUREPUSH) {
+        std::vector<CoordinatePreConfSig> vData;
+        vRecv >> FederationWitnessParams(pfrom)(vData);
+        // accepted signatures are not announced back to the peer they came from
+        includePreConfSigWitness(vData, m_chainman, pfrom.GetId());
+        return;
+    }
+
+    if (msg_type == NetMsgType::PRECONFFINALIZEPUSH && !m_chainman.IsInitialBlockDownload()) {
+        std::vector<SignedBlock> vData;
+        vRecv >> TX_WITH_WITNESS(vData);
+        includePreConfBlockFromNetwork(vData,m_chainman);
+        LOCK(cs_main);
+        for (const SignedBlock& signedBlockItem : vData) {
+            updateBroadcastedSignedBlock(signedBlockItem, pfrom.GetId());
+        }
+        return;
+    }
+}
+
+namespace {
+/**
+ * Marks the message polled from a peer as processed when it goes out of scope (see
+ * CNode::MarkMessageProcessed), and wakes the other thread if the next message is for it.
+ */
+class MessageProcessedGuard
+{
+    CNode& m_node;
+    CConnman& m_connman;
+    const bool m_preconf;
+
+public:
+    MessageProcessedGuard(CNode& node, CConnman& connman, bool preconf) : m_node{node}, m_connman{connman}, m_preconf{preconf} {}
+    MessageProcessedGuard(const MessageProcessedGuard&) = delete;
+    MessageProcessedGuard& operator=(const MessageProcessedGuard&) = delete;
+
+    ~MessageProcessedGuard()
+    {
+        const bool next_preconf{m_node.MarkMessageProcessed()};
+        if (next_preconf && !m_preconf) m_connman.WakePreconfMessageHandler();
+        if (!next_preconf && m_preconf) m_connman.WakeMessageHandler();
+    }
+};
+} // namespace
+
+bool PeerManagerImpl::ProcessPreconfMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
+{
+    AssertLockNotHeld(g_msgproc_mutex);
+
+    if (GetPeerRef(pfrom->GetId()) == nullptr) return false;
+
+    // Keep the messages queued until the message handler thread completed the handshake
+    if (!pfrom->fSuccessfullyConnected) return false;
+
+    auto poll_result{pfrom->PollPreconfMessage()};
+    if (!poll_result) {
+        // No message to process
+        return false;
+    }
+    const MessageProcessedGuard processed{*pfrom, m_connman, /*preconf=*/true};
+
+    CNetMessage& msg{poll_result->first};
+    LogDebug(BCLog::NET, "received: %s (%u bytes) peer=%d\n", SanitizeString(msg.m_type), msg.m_recv.size(), pfrom->GetId());
+
+    if (m_opts.capture_messages) {
+        CaptureMessage(pfrom->addr, msg.m_type, MakeUCharSpan(msg.m_recv), /*is_incoming=*/true);
+    }
+
+    try {
+        ProcessPreconfMessage(*pfrom, msg.m_type, msg.m_recv);
+        if (interruptMsgProc) return false;
+        // Relay what was accepted without waiting for the next message handler iteration
+        m_connman.WakeMessageHandler();
+    } catch (const std::exception& e) {
+        LogDebug(BCLog::NET, "%s(%s, %u bytes): Exception '%s' (%s) caught\n", __func__, SanitizeString(msg.m_type), msg.m_message_size, e.what(), typeid(e).name());
+    } catch (...) {
+        LogDebug(BCLog::NET, "%s(%s, %u bytes): Unknown exception caught\n", __func__, SanitizeString(msg.m_type), msg.m_message_size);
+    }
+
+    return poll_result->second;
+}
+
 bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
 {
     AssertLockNotHeld(m_tx_download_mutex);
@@ -5248,6 +5362,7 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
         // No message to process
         return false;
     }
+    const MessageProcessedGuard processed{*pfrom, m_connman, /*preconf=*/false};
 
     CNetMessage& msg{poll_result->first};
     bool fMoreWork = poll_result->second;
@@ -5485,37 +5600,66 @@ void PeerManagerImpl::CheckForStaleTipAndEvictPeers()
 
 void PeerManagerImpl::MaybeSendPeg(CNode& node_to, Peer& peer, std::chrono::microseconds now)
 {
-    const auto current_time = NodeClock::now();
+    // This runs for every peer on every pass of the message handler, so it works off the
+    // cached tip height and relay sequences, and only takes cs_main when there is preconf
+    // data to announce.
+    if (m_best_height < 0) return;
+    const int32_t currentHeight = m_best_height + 1;
+
+    // Announce precommitments for the upcoming blocks as soon as they are accepted,
+    // unless this peer already has them.
+    const std::pair<uint64_t, int32_t> commitment_announced{getCommitmentSequence(), currentHeight};
+    if (peer.m_commitment_announced != commitment_announced) {
+        peer.m_commitment_announced = commitment_announced;
+        for (int32_t height = std::max(currentHeight, peer.m_commitment_height_known + 1); height < currentHeight + 3; ++height) {
+            std::vector<AnduroPreCommitment> pending_commitments = listPendingCommitment(height);
+            if (!pending_commitments.empty()) {
+                MakeAndPushMessage(node_to, NetMsgType::PREBLOCKSIGNREPONSE, FederationWitnessParams(node_to)(pending_commitments));
+                peer.m_commitment_height_known = height;
+            }
+        }
+    }
 
-    if (current_time - peer.m_last_peg_req_timestamp > PEG_CHECK_TIME) {
-        peer.m_last_peg_req_timestamp = current_time;
-        LOCK(cs_main);
-        int32_t currentHeight = m_chainman.ActiveChain().Height() + 1;
-        std::vector<AnduroPreCommitment> pending_commitments = listPendingCommitment(currentHeight);
-        // Every 5 second node will check and request if no presigned block data exist
-        if (pending_commitments.size() == 0) {
+    // Request missing precommitments for the next block from a few peers at a time. Other
+    // peers are only asked once those requests time out, and any peer that gets them later
+    // announces them to us.
+    if (hasPendingCommitment(currentHeight)) {
+        m_commitment_requests.clear();
+    } else {
+        if (m_commitment_request_height != currentHeight) {
+            m_commitment_request_height = currentHeight;
+            m_commitment_requests.clear();
+        }
+        std::erase_if(m_commitment_requests, [&](const auto& request) { return request.second + COMMITMENT_REQUEST_RETRY_INTERVAL <= now; });
+        const size_t in_flight = std::count_if(m_commitment_requests.begin(), m_commitment_requests.end(),
+            [&](const auto& request) { return now < request.second + COMMITMENT_REQUEST_TIMEOUT; });
+        if (in_flight < MAX_COMMITMENT_REQUESTS_IN_FLIGHT && !m_commitment_requests.contains(peer.m_id)) {
+            m_commitment_requests.emplace(peer.m_id, now);
             MakeAndPushMessage(node_to, NetMsgType::PREBLOCKSIGNREQUEST, currentHeight);
         }
     }
-    if (current_time - peer.m_last_pre_conf_req_timestamp > PRE_CONF_CHECK_TIME) {
-        peer.m_last_pre_conf_req_timestamp = current_time;
-        std::vector<CoordinatePreConfSig> preconfList = getUnBroadcastedPreConfSig();
+
+    // Announce preconf signatures and signed blocks this peer has not seen, whenever new ones were accepted
+    const uint64_t preconf_relay_sequence = getPreConfRelaySequence();
+    if (peer.m_preconf_relay_sequence != preconf_relay_sequence) {
+        peer.m_preconf_relay_sequence = preconf_relay_sequence;
+        LOCK(cs_main);
+        std::vector<CoordinatePreConfSig> preconfList = getUnBroadcastedPreConfSig(peer.m_id);
         if(preconfList.size() > 0) {
-            MakeAndPushMessage(node_to, NetMsgType::PRECONFSIGNATUREPUSH, preconfList);
-            for (CoordinatePreConfSig& coordinatePreConfSigItem : preconfList) {
+            MakeAndPushMessage(node_to, NetMsgType::PRECONFSIGNATUREPUSH, FederationWitnessParams(node_to)(preconfList));
+            for (const CoordinatePreConfSig& coordinatePreConfSigItem : preconfList) {
                 updateBroadcastedPreConf(coordinatePreConfSigItem,peer.m_id);
             }
         }
 
-        std::vector<SignedBlock> preconfBlock = getUnBroadcastedPreConfSignedBlock();
+        std::vector<SignedBlockRef> preconfBlock = getUnBroadcastedPreConfSignedBlock(peer.m_id);
         if(preconfBlock.size() > 0) {
             MakeAndPushMessage(node_to, NetMsgType::PRECONFFINALIZEPUSH, TX_WITH_WITNESS(preconfBlock));
-            for (SignedBlock& coordinatePreConfBlockItem : preconfBlock) {
-                updateBroadcastedSignedBlock(coordinatePreConfBlockItem,peer.m_id);
+            for (const SignedBlockRef& coordinatePreConfBlockItem : preconfBlock) {
+                updateBroadcastedSignedBlock(*coordinatePreConfBlockItem,peer.m_id);
             }
         }
     }
-
 }
 
 void PeerManagerImpl::MaybeSendPing(CNode& node_to, Peer& peer, std::chrono::microseconds now)
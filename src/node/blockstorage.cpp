@@ -31,6 +31,7 @@
 #include <util/batchpriority.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/fs_helpers.h>
 #include <util/obfuscation.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
@@ -220,6 +221,9 @@ CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, CBlockInde
     pindexNew->nSequenceId = 0;
 
     pindexNew->phashBlock = &((*mi).first);
+    if (block.auxpow) {
+        CacheAuxpow(mi->first, block.auxpow);
+    }
     BlockMap::iterator miPrev = m_block_index.find(block.hashPrevBlock);
     if (miPrev != m_block_index.end()) {
         pindexNew->pprev = &(*miPrev).second;
@@ -610,6 +614,7 @@ bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_block
             const auto last_height_in_file = m_blockfile_info[i].nHeightLast;
             m_blockfile_cursors[BlockfileTypeForHeight(last_height_in_file)] = {static_cast<int>(i), 0};
         }
+        UpdateFirstOpenBlockfile();
     }
 
     // Check whether we have ever pruned block & undo files
@@ -623,6 +628,8 @@ bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_block
     m_block_tree_db->ReadReindexing(fReindexing);
     if (fReindexing) m_blockfiles_indexed = false;
 
+    LoadAuxpowCache();
+
     return true;
 }
 
@@ -759,6 +766,47 @@ bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index
     return true;
 }
 
+std::shared_ptr<const CBlockUndo> BlockManager::GetBlockUndo(const CBlockIndex& index) const
+{
+    const uint256 hash{index.GetBlockHash()};
+    {
+        LOCK(m_undo_cache_mutex);
+        if (auto it = m_undo_cache_index.find(hash); it != m_undo_cache_index.end()) {
+            m_undo_cache.splice(m_undo_cache.begin(), m_undo_cache, it->second);
+            return it->second->second;
+        }
+    }
+
+    auto blockundo{std::make_shared<CBlockUndo>()};
+    if (!ReadBlockUndo(*blockundo, index)) {
+        return nullptr;
+    }
+
+    LOCK(m_undo_cache_mutex);
+    // Another thread may have read the same undo data meanwhile
+    if (auto it = m_undo_cache_index.find(hash); it != m_undo_cache_index.end()) {
+        return it->second->second;
+    }
+    if (m_undo_cache.size() >= MAX_BLOCK_UNDO_CACHE_ENTRIES) {
+        m_undo_cache_index.erase(m_undo_cache.back().first);
+        m_undo_cache.pop_back();
+    }
+    m_undo_cache.emplace_front(hash, std::move(blockundo));
+    m_undo_cache_index.emplace(hash, m_undo_cache.begin());
+    return m_undo_cache.front().second;
+}
+
+std::shared_ptr<const CBlockUndo> BlockManager::UncacheBlockUndo(const uint256& hash) const
+{
+    LOCK(m_undo_cache_mutex);
+    auto it = m_undo_cache_index.find(hash);
+    if (it == m_undo_cache_index.end()) return nullptr;
+    auto blockundo{std::move(it->second->second)};
+    m_undo_cache.erase(it->second);
+    m_undo_cache_index.erase(it);
+    return blockundo;
+}
+
 bool BlockManager::FlushUndoFile(int block_file, bool finalize)
 {
     FlatFilePos undo_pos_old(block_file, m_blockfile_info[block_file].nUndoSize);
@@ -835,6 +883,8 @@ void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
 {
     std::error_code ec;
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
+        // Readers still using the mapping keep it valid until they are done
+        WITH_LOCK(m_mapped_files_mutex, m_mapped_files.erase(*it));
         FlatFilePos pos(*it, 0);
         const bool removed_blockfile{fs::remove(m_block_file_seq.FileName(pos), ec)};
         const bool removed_undofile{fs::remove(m_undo_file_seq.FileName(pos), ec)};
@@ -931,6 +981,7 @@ FlatFilePos BlockManager::FindNextBlockPos(unsigned int nAddSize, unsigned int n
         }
         // No undo data yet in the new file, so reset our undo-height tracking.
         m_blockfile_cursors[chain_type] = BlockfileCursor{nFile};
+        UpdateFirstOpenBlockfile();
     }
 
     m_blockfile_info[nFile].AddBlock(nHeight, nTime);
@@ -950,6 +1001,16 @@ FlatFilePos BlockManager::FindNextBlockPos(unsigned int nAddSize, unsigned int n
     return pos;
 }
 
+void BlockManager::UpdateFirstOpenBlockfile()
+{
+    AssertLockHeld(cs_LastBlockFile);
+    int first_open{std::numeric_limits<int>::max()};
+    for (const auto& cursor : m_blockfile_cursors) {
+        if (cursor) first_open = std::min(first_open, cursor->file_num);
+    }
+    m_first_open_blockfile = first_open;
+}
+
 void BlockManager::UpdateBlockInfo(const CBlock& block, unsigned int nHeight, const FlatFilePos& pos)
 {
     LOCK(cs_LastBlockFile);
@@ -959,6 +1020,7 @@ void BlockManager::UpdateBlockInfo(const CBlock& block, unsigned int nHeight, co
     auto& cursor{m_blockfile_cursors[chain_type]};
     if (!cursor || cursor->file_num < pos.nFile) {
         m_blockfile_cursors[chain_type] = BlockfileCursor{pos.nFile};
+        UpdateFirstOpenBlockfile();
     }
 
     // Update the file information with the current block.
@@ -1071,15 +1133,22 @@ bool ReadBlockOrHeader(T& block, const FlatFilePos& pos, const BlockManager& blo
 {
     block.SetNull();
 
-    // Open history file to read
+    // Deserialize straight from a memory-mapped block file if its data is
+    // usable as is, otherwise read the block into a buffer
+    const auto mapped{blockman.ReadMappedBlock(pos)};
     std::vector<std::byte> block_data;
-    if (!blockman.ReadRawBlock(block_data, pos)) {
+    std::span<const std::byte> block_span;
+    if (mapped && !mapped->IsObfuscated()) {
+        block_span = mapped->Data();
+    } else if (!blockman.ReadRawBlock(block_data, pos)) {
         return false;
+    } else {
+        block_span = block_data;
     }
 
     try {
         // Read block
-        SpanReader{block_data} >> TX_WITH_WITNESS(block);
+        SpanReader{block_span} >> TX_WITH_WITNESS(block);
     } catch (const std::exception& e) {
         LogError("Deserialize or I/O error - %s at %s while reading block", e.what(), pos.ToString());
         return false;
@@ -1131,6 +1200,128 @@ bool BlockManager::ReadBlockHeader(CBlockHeader& block, const CBlockIndex& index
     return ReadBlockOrHeader(block, index, *this);
 }
 
+/** Rough memory used by one auxpow cache entry: the auxpow with its transaction, list node and index entry */
+static size_t AuxpowCacheUsage(const CAuxPow& auxpow)
+{
+    return GetSerializeSize(TX_WITH_WITNESS(auxpow)) + sizeof(CAuxPow) + 4 * sizeof(uint256);
+}
+
+void BlockManager::CacheAuxpow(const uint256& hash, std::shared_ptr<CAuxPow> auxpow) const
+{
+    const size_t usage{AuxpowCacheUsage(*auxpow)};
+    if (usage > m_opts.auxpow_cache_bytes) return;
+    LOCK(m_auxpow_mutex);
+    if (m_auxpow_cache_index.contains(hash)) return;
+    while (!m_auxpow_cache.empty() && m_auxpow_cache_bytes + usage > m_opts.auxpow_cache_bytes) {
+        const auto& [oldest_hash, oldest] = m_auxpow_cache.back();
+        m_auxpow_cache_bytes -= AuxpowCacheUsage(*oldest);
+        m_auxpow_cache_index.erase(oldest_hash);
+        m_auxpow_cache.pop_back();
+    }
+    m_auxpow_cache.emplace_front(hash, std::move(auxpow));
+    m_auxpow_cache_index.emplace(hash, m_auxpow_cache.begin());
+    m_auxpow_cache_bytes += usage;
+}
+
+std::shared_ptr<CAuxPow> BlockManager::GetAuxpow(const CBlockIndex& index) const
+{
+    const uint256 hash{index.GetBlockHash()};
+    {
+        LOCK(m_auxpow_mutex);
+        if (auto it = m_auxpow_cache_index.find(hash); it != m_auxpow_cache_index.end()) {
+            m_auxpow_cache.splice(m_auxpow_cache.begin(), m_auxpow_cache, it->second);
+            return it->second->second;
+        }
+    }
+
+    CBlockHeader header;
+    if (!ReadBlockHeader(header, index) || !header.auxpow) {
+        return nullptr;
+    }
+    CacheAuxpow(hash, header.auxpow);
+    return header.auxpow;
+}
+
+/** Version of the file written by DumpAuxpowCache */
+static constexpr uint64_t AUXPOW_CACHE_DUMP_VERSION{1};
+
+static fs::path AuxpowCachePath(const fs::path& blocks_dir)
+{
+    return blocks_dir / "auxpowcache.dat";
+}
+
+bool BlockManager::DumpAuxpowCache() const
+{
+    std::vector<std::pair<uint256, std::shared_ptr<CAuxPow>>> entries;
+    WITH_LOCK(m_auxpow_mutex, entries.assign(m_auxpow_cache.begin(), m_auxpow_cache.end()));
+
+    const fs::path dump_path{AuxpowCachePath(m_opts.blocks_dir)};
+    const fs::path file_fspath{dump_path + ".new"};
+    AutoFile file{fsbridge::fopen(file_fspath, "wb")};
+    if (file.IsNull()) {
+        LogError("Failed to open %s to dump the auxpow cache", fs::PathToString(file_fspath));
+        return false;
+    }
+    try {
+        file << AUXPOW_CACHE_DUMP_VERSION << uint64_t{entries.size()};
+        // least recently used first, so loading them in file order restores the order
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            file << it->first << TX_WITH_WITNESS(*it->second);
+        }
+        if (!file.Commit()) {
+            (void)file.fclose();
+            throw std::runtime_error("Commit failed");
+        }
+        if (file.fclose() != 0) {
+            throw std::runtime_error(strprintf("Error closing %s: %s", fs::PathToString(file_fspath), SysErrorString(errno)));
+        }
+        if (!RenameOver(file_fspath, dump_path)) {
+            throw std::runtime_error("Rename failed");
+        }
+    } catch (const std::exception& e) {
+        LogWarning("Failed to dump the auxpow cache: %s", e.what());
+        return false;
+    }
+    LogInfo("Dumped %u cached auxpows", entries.size());
+    return true;
+}
+
+void BlockManager::LoadAuxpowCache()
+{
+    AssertLockHeld(::cs_main);
+    AutoFile file{fsbridge::fopen(AuxpowCachePath(m_opts.blocks_dir), "rb")};
+    if (file.IsNull()) return;
+
+    size_t loaded{0};
+    try {
+        uint64_t version;
+        file >> version;
+        if (version != AUXPOW_CACHE_DUMP_VERSION) {
+            LogWarning("Ignoring auxpow cache file with unknown version %d", version);
+            return;
+        }
+        uint64_t count;
+        file >> count;
+        for (uint64_t i = 0; i < count; ++i) {
+            uint256 hash;
+            auto auxpow{std::make_shared<CAuxPow>()};
+            file >> hash >> TX_WITH_WITNESS(*auxpow);
+            // skip headers no longer in the block index, e.g. after a reindex, and auxpows that do not prove
+            // the work of this very header. Anything skipped is read from disk when it is asked for.
+            const CBlockIndex* index{LookupBlockIndex(hash)};
+            if (!index || !CheckProofOfWork(auxpow->getParentBlockHash(), index->nBits, GetConsensus()) ||
+                !auxpow->check(hash, index->GetPureHeader().GetChainId(), GetConsensus())) {
+                continue;
+            }
+            CacheAuxpow(hash, std::move(auxpow));
+            ++loaded;
+        }
+    } catch (const std::exception& e) {
+        LogWarning("Failed to load the auxpow cache: %s", e.what());
+    }
+    LogInfo("Loaded %u cached auxpows", loaded);
+}
+
 
 bool BlockManager::ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos& pos) const
 {
@@ -1141,6 +1332,11 @@ bool BlockManager::ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos
         LogError("Failed for %s while reading raw block storage header", pos.ToString());
         return false;
     }
+    if (const auto mapped{ReadMappedBlock(pos)}) {
+        block.resize(mapped->Size());
+        mapped->CopyTo(block);
+        return true;
+    }
     AutoFile filein{OpenBlockFile({pos.nFile, pos.nPos - STORAGE_HEADER_BYTES}, /*fReadOnly=*/true)};
     if (filein.IsNull()) {
         LogError("OpenBlockFile failed for %s while reading raw block", pos.ToString());
@@ -1175,6 +1371,42 @@ bool BlockManager::ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos
     return true;
 }
 
+std::shared_ptr<const MappedFlatFile> BlockManager::GetMappedBlockFile(int file_num) const
+{
+    LOCK(m_mapped_files_mutex);
+    auto [it, inserted]{m_mapped_files.try_emplace(file_num)};
+    if (inserted) {
+        it->second = MappedFlatFile::Open(m_block_file_seq.FileName({file_num, 0}));
+        if (!it->second) {
+            LogDebug(BCLog::BLOCKSTORAGE, "Cannot memory-map block file %05i, reading from it instead\n", file_num);
+        }
+    }
+    return it->second;
+}
+
+std::optional<MappedBlock> BlockManager::ReadMappedBlock(const FlatFilePos& pos) const
+{
+    if (!m_opts.use_mmap || pos.nFile < 0 || pos.nFile >= m_first_open_blockfile.load() || pos.nPos < STORAGE_HEADER_BYTES) {
+        return std::nullopt;
+    }
+    const auto file{GetMappedBlockFile(pos.nFile)};
+    if (!file || pos.nPos > file->Data().size()) {
+        return std::nullopt;
+    }
+
+    // Check the storage header like ReadRawBlock does, which reports any errors
+    std::array<std::byte, STORAGE_HEADER_BYTES> header;
+    std::ranges::copy(file->Data().subspan(pos.nPos - STORAGE_HEADER_BYTES, STORAGE_HEADER_BYTES), header.begin());
+    m_obfuscation(header, pos.nPos - STORAGE_HEADER_BYTES);
+    MessageStartChars blk_start;
+    unsigned int blk_size;
+    SpanReader{header} >> blk_start >> blk_size;
+    if (blk_start != GetParams().MessageStart() || blk_size > MAX_SIZE || blk_size > file->Data().size() - pos.nPos) {
+        return std::nullopt;
+    }
+    return MappedBlock{file, pos.nPos, blk_size, m_obfuscation};
+}
+
 FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
 {
     const unsigned int block_size{static_cast<unsigned int>(GetSerializeSize(TX_WITH_WITNESS(block)))};
@@ -19,12 +19,17 @@
 #include <uint256.h>
 #include <util/fs.h>
 #include <util/hasher.h>
+#include <util/obfuscation.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -80,6 +85,9 @@ static constexpr uint32_t STORAGE_HEADER_BYTES{std::tuple_size_v<MessageStartCha
 /** Total overhead when writing undo data: header (8 bytes) plus checksum (32 bytes) */
 static constexpr uint32_t UNDO_DATA_DISK_OVERHEAD{STORAGE_HEADER_BYTES + uint256::size()};
 
+/** Number of blocks whose undo data is kept after reading it, as miner fee computation and reorgs read the same recent ones */
+static constexpr size_t MAX_BLOCK_UNDO_CACHE_ENTRIES{8};
+
 // Because validation code takes pointers to the map's CBlockIndex objects, if
 // we ever switch to another associative container, we need to either use a
 // container that has stable addressing (true of all std associative
@@ -127,6 +135,36 @@ struct BlockfileCursor {
 
 std::ostream& operator<<(std::ostream& os, const BlockfileCursor& cursor);
 
+/**
+ * A serialized block inside a memory-mapped block file, which stays mapped for
+ * the lifetime of this object. Data() is the block as stored on disk, so it
+ * can only be deserialized or sent directly if the block files are not
+ * obfuscated; CopyTo() de-obfuscates the copy it makes.
+ */
+class MappedBlock
+{
+    std::shared_ptr<const MappedFlatFile> m_file;
+    std::span<const std::byte> m_data;
+    //! Position of the block in the file, which the obfuscation key is aligned to
+    size_t m_file_offset;
+    Obfuscation m_obfuscation;
+
+public:
+    MappedBlock(std::shared_ptr<const MappedFlatFile> file, size_t file_offset, size_t size, const Obfuscation& obfuscation)
+        : m_file{std::move(file)}, m_data{m_file->Data().subspan(file_offset, size)}, m_file_offset{file_offset}, m_obfuscation{obfuscation} {}
+
+    size_t Size() const { return m_data.size(); }
+    bool IsObfuscated() const { return bool{m_obfuscation}; }
+    std::span<const std::byte> Data() const { return m_data; }
+
+    /** Copy the block into out, which must be Size() bytes long, and de-obfuscate it there. */
+    void CopyTo(std::span<std::byte> out) const
+    {
+        assert(out.size() == m_data.size());
+        std::ranges::copy(m_data, out.begin());
+        m_obfuscation(out, m_file_offset);
+    }
+};
 
 /**
  * Maintains a tree of blocks (stored in `m_block_index`) which is consulted
@@ -243,9 +281,41 @@ private:
 
     const Obfuscation m_obfuscation;
 
+    /**
+     * Block files with a lower number are no longer written to, so they can be
+     * memory-mapped by ReadMappedBlock. This is the lowest file number of the
+     * blockfile cursors.
+     */
+    std::atomic<int> m_first_open_blockfile{0};
+    void UpdateFirstOpenBlockfile() EXCLUSIVE_LOCKS_REQUIRED(cs_LastBlockFile);
+
+    /** Block files mapped into memory by ReadMappedBlock, or nullptr if that failed, by file number. */
+    mutable Mutex m_mapped_files_mutex;
+    mutable std::map<int, std::shared_ptr<const MappedFlatFile>> m_mapped_files GUARDED_BY(m_mapped_files_mutex);
+
+    std::shared_ptr<const MappedFlatFile> GetMappedBlockFile(int file_num) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
+
     /** Dirty block index entries. */
     std::set<CBlockIndex*> m_dirty_blockindex;
 
+    /**
+     * The block index does not store the auxpow of merge-mined headers. Keep the
+     * ones of recently added or served headers here, most recently used first.
+     */
+    using AuxpowCacheList = std::list<std::pair<uint256, std::shared_ptr<CAuxPow>>>;
+    mutable Mutex m_auxpow_mutex;
+    mutable AuxpowCacheList m_auxpow_cache GUARDED_BY(m_auxpow_mutex);
+    mutable std::unordered_map<uint256, AuxpowCacheList::iterator, BlockHasher> m_auxpow_cache_index GUARDED_BY(m_auxpow_mutex);
+    mutable size_t m_auxpow_cache_bytes GUARDED_BY(m_auxpow_mutex){0};
+
+    void CacheAuxpow(const uint256& hash, std::shared_ptr<CAuxPow> auxpow) const EXCLUSIVE_LOCKS_REQUIRED(!m_auxpow_mutex);
+
+    /** Undo data of recently read blocks, most recently used first. */
+    using BlockUndoCacheList = std::list<std::pair<uint256, std::shared_ptr<const CBlockUndo>>>;
+    mutable Mutex m_undo_cache_mutex;
+    mutable BlockUndoCacheList m_undo_cache GUARDED_BY(m_undo_cache_mutex);
+    mutable std::unordered_map<uint256, BlockUndoCacheList::iterator, BlockHasher> m_undo_cache_index GUARDED_BY(m_undo_cache_mutex);
+
     /** Dirty block file entries. */
     std::set<int> m_dirty_fileinfo;
 
@@ -420,10 +490,32 @@ public:
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
     bool ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos& pos) const;
+
+    /**
+     * Get the serialized block at pos from its memory-mapped block file, without
+     * reading it into a buffer. Returns nullopt when memory-mapping of block
+     * files is disabled, the file is still being written to, or the block
+     * cannot be found there, in which case ReadRawBlock should be used.
+     */
+    std::optional<MappedBlock> ReadMappedBlock(const FlatFilePos& pos) const;
     bool ReadBlockHeader(CBlockHeader& block, const CBlockIndex& pindex) const;
 
+    /** The auxpow of a merge-mined block, from memory when the header was seen recently, otherwise from disk */
+    std::shared_ptr<CAuxPow> GetAuxpow(const CBlockIndex& index) const EXCLUSIVE_LOCKS_REQUIRED(!m_auxpow_mutex);
+
+    /** Write the cached auxpows to the blocks directory, so the cache is warm after a restart */
+    bool DumpAuxpowCache() const EXCLUSIVE_LOCKS_REQUIRED(!m_auxpow_mutex);
+    /** Fill the cache with the auxpows written by DumpAuxpowCache of headers in the block index */
+    void LoadAuxpowCache() EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !m_auxpow_mutex);
+
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
+    /** The undo data of a block, from memory when it was read recently, otherwise from disk. Returns nullptr if reading fails. */
+    std::shared_ptr<const CBlockUndo> GetBlockUndo(const CBlockIndex& index) const EXCLUSIVE_LOCKS_REQUIRED(!m_undo_cache_mutex);
+
+    /** Drop the undo data of a block from memory, e.g. when it is disconnected. Returns it if it was cached. */
+    std::shared_ptr<const CBlockUndo> UncacheBlockUndo(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!m_undo_cache_mutex);
+
     void CleanupBlockRevFiles() const;
 };
 
@@ -114,10 +114,10 @@ static ChainstateLoadResult CompleteChainstateInitialization(
         }
 
         // asset memory allocation
-        chainstate->InitAssetCache();
+        chainstate->InitAssetCache(chainman.m_total_assetdb_cache);
 
         // signed block memory allocation
-        chainstate->InitSignedBlockCache();
+        chainstate->InitSignedBlockCache(chainman.m_total_signedblockdb_cache);
 
         // The on-disk coinsdb is now in a good state, create the cache
         chainstate->InitCoinsCache(chainman.m_total_coinstip_cache * init_cache_fraction);
@@ -171,6 +171,8 @@ ChainstateLoadResult LoadChainstate(ChainstateManager& chainman, const CacheSize
 
     chainman.m_total_coinstip_cache = cache_sizes.coins;
     chainman.m_total_coinsdb_cache = cache_sizes.coins_db;
+    chainman.m_total_assetdb_cache = cache_sizes.asset_db;
+    chainman.m_total_signedblockdb_cache = cache_sizes.signed_block_db;
 
     // Load the fully validated chainstate.
     chainman.InitializeChainstate(options.mempool, options.preconfmempool);
@@ -45,10 +45,15 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& argsman, const CChainP
 {
     mempool_opts.check_ratio = argsman.GetIntArg("-checkmempool", mempool_opts.check_ratio);
 
-    if (auto mb = argsman.GetIntArg("-maxmempool")) {
+    // The preconf mempool has its own size limit
+    const std::string max_size_arg{mempool_opts.is_preconf ? "-maxpreconfmempool" : "-maxmempool"};
+    if (mempool_opts.is_preconf) {
+        mempool_opts.max_size_bytes = int64_t{DEFAULT_MAX_PRECONF_MEMPOOL_SIZE_MB} * 1'000'000;
+    }
+    if (auto mb = argsman.GetIntArg(max_size_arg)) {
         constexpr bool is_32bit{sizeof(void*) == 4};
         if (is_32bit && *mb > MAX_32BIT_MEMPOOL_MB) {
-            return util::Error{Untranslated(strprintf("-maxmempool is set to %i but can't be over %i MB on 32-bit systems", *mb, MAX_32BIT_MEMPOOL_MB))};
+            return util::Error{Untranslated(strprintf("%s is set to %i but can't be over %i MB on 32-bit systems", max_size_arg, *mb, MAX_32BIT_MEMPOOL_MB))};
         }
         mempool_opts.max_size_bytes = *mb * 1'000'000;
     }
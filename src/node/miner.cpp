@@ -175,9 +175,8 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock()
     }
 
     pblock->reconciliationBlock = getReconsiledBlock(m_chainstate.m_chainman);
-    std::vector<SignedBlock> nextPreconfs = getFinalizedSignedBlocks();
-    for (size_t i = 0; i < nextPreconfs.size(); i++) {
-        pblock->preconfBlock.push_back(nextPreconfs[i]);
+    for (const SignedBlockRef& nextPreconf : getFinalizedSignedBlocks()) {
+        pblock->preconfBlock.push_back(*nextPreconf);
     }
 
 
@@ -193,12 +192,8 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock()
                 LogPrintf("commitment queue unavailable\n");
                 return nullptr;
             }
-
-            // increase transaction out size based on available pegin 
-            if(!isPreCommitmentValid(pending_commitments,m_chainstate.m_chainman)) {
-                LogPrintf("anduro commitment invalid \n");
-                return nullptr;
-            }
+            // pending commitments were validated when they were received and are
+            // dropped when the block they were signed over is disconnected
         }
 
         // increase transaction out size by one for include witness
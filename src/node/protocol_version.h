@@ -9,7 +9,7 @@
  * network protocol versioning
  */
 
-static const int PROTOCOL_VERSION = 70016;
+static const int PROTOCOL_VERSION = 70017;
 
 //! initial proto version, to be increased after version/verack negotiation
 static const int INIT_PROTO_VERSION = 209;
@@ -38,4 +38,7 @@ static const int INVALID_CB_NO_BAN_VERSION = 70015;
 //! "wtxidrelay" command for wtxid-based relay starts with this version
 static const int WTXID_RELAY_VERSION = 70016;
 
+//! federation witnesses in preconf signature and precommitment messages are sent as raw bytes starting with this version
+static const int FEDERATION_BINARY_WITNESS_VERSION = 70017;
+
 #endif // BITCOIN_NODE_PROTOCOL_VERSION_H
@@ -144,9 +144,8 @@ CTransactionRef GetTransaction(const CBlockIndex* const block_index, const CTxMe
         if (ptx) return ptx;
     }
 
-    std::vector<SignedBlock> finalizedBlocks= getFinalizedSignedBlocks();
-    for (SignedBlock finalizedSignedBlock : finalizedBlocks) {
-        for (const auto& tx : finalizedSignedBlock.vtx) {
+    for (const SignedBlockRef& finalizedSignedBlock : getFinalizedSignedBlocks()) {
+        for (const auto& tx : finalizedSignedBlock->vtx) {
             if (tx->GetHash() == hash) {
                 return tx;
             }
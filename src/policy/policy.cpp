@@ -22,7 +22,6 @@
 #include <algorithm>
 #include <cstddef>
 #include <vector>
-#include <coordinate/coordinate_mempool_entry.h>
 
 CAmount GetDustThreshold(const CTxOut& txout, const CFeeRate& dustRelayFeeIn)
 {
@@ -192,88 +191,58 @@ bool IsStandardTx(const CTransaction& tx, const std::optional<unsigned>& max_dat
     return true;
 }
 
-bool AreCoordinateTransactionStandard(const CTransaction& tx, CCoinsViewCache& mapInputs) {
-    if(tx.version == TRANSACTION_PEGIN_VERSION) {
+bool CheckCoordinateAssetRules(const CTransaction& tx, const std::vector<Coin>& spent_coins, std::string& reason)
+{
+    assert(spent_coins.size() == tx.vin.size());
+    if (tx.version == TRANSACTION_PEGIN_VERSION) {
         return true;
     }
-    
-    CAmount amountAssetInOut = CAmount(0);
-    std::vector<unsigned char> currentAssetID = {};
-    for (unsigned int i = 0; i < tx.vin.size(); i++) {
-        bool fBitAsset = false;
-        bool fBitAssetControl = false;
-        std::vector<unsigned char> nAssetID = {};
-        Coin coin;
-        CAmount coinValue = 0;
-
-        CoordinateMempoolEntry assetMempoolObj;
-        bool is_mempool_asset = getMempoolAsset(tx.vin[i].prevout.hash,tx.vin[i].prevout.n, &assetMempoolObj);
-        if(is_mempool_asset) {
-            fBitAsset = true;
-            fBitAssetControl = false;
-            nAssetID = assetMempoolObj.assetID;
-            coinValue = assetMempoolObj.nValue;
-        } else {
-            // check input is unspent
-            bool is_asset = mapInputs.getAssetCoin(tx.vin[i].prevout,fBitAsset,fBitAssetControl,nAssetID, &coin);
-            if(!is_asset) {
-                LogPrintf("Invalid inputs \n");
-                return false;
-            } else {
-                coinValue = coin.out.nValue;
-            }
-        }
+
+    CAmount amountAssetIn = CAmount(0);
+    const std::vector<unsigned char>* currentAssetID{nullptr};
+    for (unsigned int i = 0; i < spent_coins.size(); i++) {
+        const Coin& coin = spent_coins[i];
 
         if (tx.version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION) {
-            // check first input is asset
-            if(fBitAssetControl) {
-                LogPrintf("Asset controller value not accepted \n");
+            if (coin.fBitAssetControl) {
+                reason = "bad-txns-asset-controller-spent";
                 return false;
             }
 
-            if(fBitAsset) {
-                if(i == 0) {
-                    // check first index asset id
-                    currentAssetID = nAssetID;
-                } else {
-                    // prevent to include multiple asset id
-                    if (getAssetHash(currentAssetID) != getAssetHash(nAssetID)) {
-                        LogPrintf(" Multiple asset is detected and it is invalid \n");
-                        return false;
-                    }
+            if (coin.fBitAsset) {
+                // prevent to include multiple asset id, the first input sets the asset
+                if (i == 0) {
+                    currentAssetID = &coin.nAssetID;
+                } else if (!currentAssetID || *currentAssetID != coin.nAssetID) {
+                    reason = "bad-txns-asset-multiple";
+                    return false;
                 }
-                amountAssetInOut = amountAssetInOut +  coinValue;
+                amountAssetIn += coin.out.nValue;
             }
-    
         }
 
-        if (tx.version == 2 && fBitAsset) {
-            LogPrintf("Asset inputs not accepted in standard transaction \n");
+        if (tx.version == 2 && coin.fBitAsset) {
+            reason = "bad-txns-asset-in-standard-tx";
             return false;
         }
     }
 
-    if(tx.version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION && amountAssetInOut == 0) {
-        LogPrintf("Asset inputs missing \n");
+    if (tx.version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION && amountAssetIn == 0) {
+        reason = "bad-txns-asset-inputs-missing";
         return false;
     }
 
-
-    if (amountAssetInOut > 0 && !(tx.version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION)) {
-        LogPrintf("Invalid transaction hold asset input \n");
-    }
-
-    if (amountAssetInOut > 0) {
+    if (amountAssetIn > 0) {
         CAmount amountAssetOut = CAmount(0);
-        for (unsigned int i = 0; i < tx.vout.size(); i++) {
-            if (amountAssetOut == amountAssetInOut) {
+        for (const CTxOut& txout : tx.vout) {
+            if (amountAssetOut == amountAssetIn) {
                 break;
             }
-            amountAssetOut = amountAssetOut + tx.vout[i].nValue;
+            amountAssetOut += txout.nValue;
         }
         // check asset full spent on output
-        if(amountAssetOut != amountAssetInOut) {
-            LogPrintf("Enough asset not included in output \n");
+        if (amountAssetOut != amountAssetIn) {
+            reason = "bad-txns-asset-outputs-mismatch";
             return false;
         }
     }
@@ -17,6 +17,7 @@
 
 class CCoinsViewCache;
 class CFeeRate;
+class Coin;
 class CScript;
 
 /** Default for -blockmaxweight, which controls the range of block weights the mining code will create **/
@@ -196,6 +197,12 @@ static inline int64_t GetVirtualTransactionInputSize(const CTxIn& tx)
     return GetVirtualTransactionInputSize(tx, 0, 0);
 }
 
-bool AreCoordinateTransactionStandard(const CTransaction& tx, CCoinsViewCache& mapInputs);
+/**
+ * Check the asset rules of a transaction against the coins it spends, in input order: an
+ * asset transfer spends a single asset and no controller and pays the full asset amount to
+ * its outputs, and a standard transaction spends no asset. Depends only on its arguments,
+ * so it can run on the script check queue.
+ */
+bool CheckCoordinateAssetRules(const CTransaction& tx, const std::vector<Coin>& spent_coins, std::string& reason);
 
 #endif // BITCOIN_POLICY_POLICY_H
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <string_view>
 
 /** Message header.
  * (4) message start.
@@ -316,6 +317,16 @@ inline const std::array ALL_NET_MESSAGE_TYPES{std::to_array<std::string>({
     NetMsgType::SENDTXRCNCL,
 })};
 
+/**
+ * Preconf relay messages do not touch the per-peer state of the message handler, so they
+ * are processed by their own thread rather than while it validates blocks or serves other
+ * peers. They still take their turn with the peer's other messages (see CNode::PollMessage).
+ */
+inline bool IsPreconfRelayMsgType(std::string_view msg_type)
+{
+    return msg_type == NetMsgType::PRECONFSIGNATUREPUSH || msg_type == NetMsgType::PRECONFFINALIZEPUSH;
+}
+
 /** nServices flags */
 enum ServiceFlags : uint64_t {
     // NOTE: When adding here, be sure to update serviceFlagToStr too
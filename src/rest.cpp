@@ -10,9 +10,13 @@
 #include <blockfilter.h>
 #include <chain.h>
 #include <chainparams.h>
+#include <coordinate/coordinate_assets.h>
+#include <coordinate/coordinate_preconf.h>
+#include <coordinate/signed_block.h>
 #include <core_io.h>
 #include <flatfile.h>
 #include <httpserver.h>
+#include <index/assetindex.h>
 #include <index/blockfilterindex.h>
 #include <index/txindex.h>
 #include <node/blockstorage.h>
@@ -46,6 +50,7 @@ using util::SplitString;
 
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
 static constexpr unsigned int MAX_REST_HEADERS_RESULTS = 2000;
+static constexpr unsigned int MAX_REST_SIGNED_BLOCKS_RESULTS = 100;
 
 static const struct {
     RESTResponseFormat rf;
@@ -116,6 +121,23 @@ static CTxMemPool* GetMemPool(const std::any& context, HTTPRequest* req)
     return node_context->mempool.get();
 }
 
+/**
+ * Get the node context preconf mempool.
+ *
+ * @param[in]  req The HTTP request, whose status code will be set if node
+ *                 context preconf mempool is not found.
+ * @returns        Pointer to the preconf mempool or nullptr if no preconf mempool found.
+ */
+static CTxMemPool* GetPreConfMemPool(const std::any& context, HTTPRequest* req)
+{
+    auto node_context = util::AnyPtr<NodeContext>(context);
+    if (!node_context || !node_context->preconfmempool) {
+        RESTERR(req, HTTP_NOT_FOUND, "Preconf mempool disabled or instance not found");
+        return nullptr;
+    }
+    return node_context->preconfmempool.get();
+}
+
 /**
  * Get the node context chainstatemanager.
  *
@@ -429,6 +451,15 @@ static bool rest_block(const std::any& context,
         pos = pblockindex->GetBlockPos();
     }
 
+    if (rf == RESTResponseFormat::BINARY) {
+        // Reply straight from a memory-mapped block file if its data is usable as is
+        if (const auto mapped{chainman.m_blockman.ReadMappedBlock(pos)}; mapped && !mapped->IsObfuscated()) {
+            req->WriteHeader("Content-Type", "application/octet-stream");
+            req->WriteReply(HTTP_OK, mapped->Data());
+            return true;
+        }
+    }
+
     std::vector<std::byte> block_data{};
     if (!chainman.m_blockman.ReadRawBlock(block_data, pos)) {
         return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
@@ -449,13 +480,12 @@ static bool rest_block(const std::any& context,
     }
 
     case RESTResponseFormat::JSON: {
-        CBlock block{};
-        DataStream block_stream{block_data};
-        block_stream >> TX_WITH_WITNESS(block);
-        UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit);
-        std::string strJSON = objBlock.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        auto block{std::make_shared<CBlock>()};
+        SpanReader{block_data} >> TX_WITH_WITNESS(*block);
+        // The transactions are written from the block, not from the raw data
+        block_data.clear();
+        block_data.shrink_to_fit();
+        req->WriteJSONReply(HTTP_OK, BlockToJSONWriter(chainman.m_blockman, std::move(block), *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit, UniValue{UniValue::VOBJ}));
         return true;
     }
 
@@ -773,7 +803,6 @@ static bool rest_mempool(const std::any& context, HTTPRequest* req, const std::s
 
     switch (rf) {
     case RESTResponseFormat::JSON: {
-        std::string str_json;
         if (param == "contents") {
             std::string raw_verbose;
             try {
@@ -798,13 +827,10 @@ static bool rest_mempool(const std::any& context, HTTPRequest* req, const std::s
             if (verbose && mempool_sequence) {
                 return RESTERR(req, HTTP_BAD_REQUEST, "Verbose results cannot contain mempool sequence values. (hint: set \"verbose=false\")");
             }
-            str_json = MempoolToJSON(*mempool, verbose, mempool_sequence).write() + "\n";
+            req->WriteJSONReply(HTTP_OK, MempoolToJSONWriter(*mempool, verbose, mempool_sequence));
         } else {
-            str_json = MempoolInfoToJSON(*mempool).write() + "\n";
+            req->WriteJSONReply(HTTP_OK, MempoolInfoToJSON(*mempool));
         }
-
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, str_json);
         return true;
     }
     default: {
@@ -1116,6 +1142,327 @@ static bool rest_blockhash_by_height(const std::any& context, HTTPRequest* req,
     }
 }
 
+/**
+ * Parse an asset id given as <blockheight>/<index>, the form returned by listallassets.
+ *
+ * @param[in]  req The HTTP request, whose status code will be set on a parse error.
+ * @returns        The serialized asset id or std::nullopt on failure.
+ */
+static std::optional<std::vector<unsigned char>> ParseRESTAssetId(HTTPRequest* req, const std::string& param, const std::string& endpoint)
+{
+    const std::vector<std::string> path = SplitString(param, '/');
+    if (path.size() != 2) {
+        RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/" + endpoint + "/<blockheight>/<index>.<ext>");
+        return std::nullopt;
+    }
+    const auto block_height{ToIntegral<uint64_t>(path[0])};
+    const auto asset_index{ToIntegral<uint16_t>(path[1])};
+    if (!block_height || !asset_index || *asset_index > 999) {
+        RESTERR(req, HTTP_BAD_REQUEST, "Invalid asset id: " + SanitizeString(param, SAFE_CHARS_URI));
+        return std::nullopt;
+    }
+    return CreateAssetId(*block_height, *asset_index);
+}
+
+static bool rest_signedblock(const std::any& context, HTTPRequest* req, const std::string& uri_part)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, uri_part);
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+
+    SignedBlock block;
+    CBlock minedBlock;
+    bool found{false};
+    if (param.size() == 64) {
+        auto hash{uint256::FromHex(param)};
+        if (!hash) {
+            return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + SanitizeString(param, SAFE_CHARS_URI));
+        }
+        found = getSignedBlockByHash(chainman, *hash, block, minedBlock);
+    } else {
+        const auto height{ToIntegral<uint64_t>(param)};
+        if (!height) {
+            return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash or height: " + SanitizeString(param, SAFE_CHARS_URI));
+        }
+        found = getSignedBlockByHeight(chainman, *height, block, minedBlock);
+    }
+    if (!found) {
+        return RESTERR(req, HTTP_NOT_FOUND, SanitizeString(param, SAFE_CHARS_URI) + " not found");
+    }
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY: {
+        DataStream ssBlock;
+        ssBlock << TX_WITH_WITNESS(block);
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, ssBlock);
+        return true;
+    }
+
+    case RESTResponseFormat::HEX: {
+        DataStream ssBlock;
+        ssBlock << TX_WITH_WITNESS(block);
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, HexStr(ssBlock) + "\n");
+        return true;
+    }
+
+    case RESTResponseFormat::JSON: {
+        req->WriteJSONReply(HTTP_OK, signedBlockToJSON(block));
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+static bool rest_signedblocks(const std::any& context, HTTPRequest* req, const std::string& uri_part)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, uri_part);
+
+    const std::vector<std::string> path = SplitString(param, '/');
+    if (path.size() != 2) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/signedblocks/<count>/<start>.<ext>");
+    }
+    const auto count{ToIntegral<size_t>(path[0])};
+    if (!count || *count < 1 || *count > MAX_REST_SIGNED_BLOCKS_RESULTS) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Signed block count is out of acceptable range (1-%u): %s", MAX_REST_SIGNED_BLOCKS_RESULTS, SanitizeString(path[0], SAFE_CHARS_URI)));
+    }
+    const auto start{ToIntegral<uint64_t>(path[1])};
+    if (!start) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height: " + SanitizeString(path[1], SAFE_CHARS_URI));
+    }
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY:
+    case RESTResponseFormat::HEX:
+    case RESTResponseFormat::JSON: {
+        if (rf == RESTResponseFormat::BINARY) {
+            req->WriteHeader("Content-Type", "application/octet-stream");
+        } else if (rf == RESTResponseFormat::HEX) {
+            req->WriteHeader("Content-Type", "text/plain");
+        } else {
+            req->WriteHeader("Content-Type", "application/json");
+        }
+        // Signed blocks are written one chunk at a time, consecutive heights
+        // usually share the mined block they were included in.
+        req->StartReplyChunked(HTTP_OK);
+        if (rf == RESTResponseFormat::JSON) req->WriteReplyChunk("[");
+        CBlock minedBlock;
+        for (uint64_t nHeight = *start, written = 0; written < *count; ++nHeight, ++written) {
+            SignedBlock block;
+            if (!getSignedBlockByHeight(chainman, nHeight, block, minedBlock)) break;
+            if (rf == RESTResponseFormat::JSON) {
+                req->WriteReplyChunk((written > 0 ? "," : "") + signedBlockToJSON(block).write());
+            } else {
+                DataStream ssBlock;
+                ssBlock << TX_WITH_WITNESS(block);
+                if (rf == RESTResponseFormat::BINARY) {
+                    req->WriteReplyChunk(ssBlock);
+                } else {
+                    req->WriteReplyChunk(HexStr(ssBlock));
+                }
+            }
+        }
+        req->WriteReplyChunk(rf == RESTResponseFormat::JSON ? "]\n" : rf == RESTResponseFormat::HEX ? "\n" : "");
+        req->EndReplyChunked();
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+static bool rest_preconfmempool(const std::any& context, HTTPRequest* req, const std::string& str_uri_part)
+{
+    if (!CheckWarmup(req))
+        return false;
+
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, str_uri_part);
+    if (param != "contents") {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/preconfmempool/contents.<ext>");
+    }
+
+    const CTxMemPool* preconf_pool = GetPreConfMemPool(context, req);
+    if (!preconf_pool) return false;
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY:
+    case RESTResponseFormat::HEX: {
+        // Snapshot the pool under its own lock only, then stream the transactions
+        const std::vector<TxMempoolInfo> entries = preconf_pool->infoAll();
+        req->WriteHeader("Content-Type", rf == RESTResponseFormat::BINARY ? "application/octet-stream" : "text/plain");
+        req->StartReplyChunked(HTTP_OK);
+        for (const TxMempoolInfo& entry : entries) {
+            DataStream ssTx;
+            ssTx << TX_WITH_WITNESS(entry.tx);
+            if (rf == RESTResponseFormat::BINARY) {
+                req->WriteReplyChunk(ssTx);
+            } else {
+                req->WriteReplyChunk(HexStr(ssTx));
+            }
+        }
+        if (rf == RESTResponseFormat::HEX) req->WriteReplyChunk("\n");
+        req->EndReplyChunked();
+        return true;
+    }
+
+    case RESTResponseFormat::JSON: {
+        std::string raw_verbose;
+        try {
+            raw_verbose = req->GetQueryParameter("verbose").value_or("true");
+        } catch (const std::runtime_error& e) {
+            return RESTERR(req, HTTP_BAD_REQUEST, e.what());
+        }
+        if (raw_verbose != "true" && raw_verbose != "false") {
+            return RESTERR(req, HTTP_BAD_REQUEST, "The \"verbose\" query parameter must be either \"true\" or \"false\".");
+        }
+        const bool verbose{raw_verbose == "true"};
+
+        req->WriteJSONReply(HTTP_OK, MempoolToJSON(*preconf_pool, verbose));
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+static bool rest_asset(const std::any& context, HTTPRequest* req, const std::string& uri_part)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, uri_part);
+
+    const auto asset_id{ParseRESTAssetId(req, param, "asset")};
+    if (!asset_id) return false;
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+
+    CoordinateAsset asset;
+    if (!maybe_chainman->ActiveChainstate().passettree->GetAsset(getAssetHash(*asset_id), asset)) {
+        return RESTERR(req, HTTP_NOT_FOUND, SanitizeString(param, SAFE_CHARS_URI) + " not found");
+    }
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY: {
+        DataStream ssAsset;
+        ssAsset << asset;
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, ssAsset);
+        return true;
+    }
+
+    case RESTResponseFormat::HEX: {
+        DataStream ssAsset;
+        ssAsset << asset;
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, HexStr(ssAsset) + "\n");
+        return true;
+    }
+
+    case RESTResponseFormat::JSON: {
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, AssetToJSON(asset).write() + "\n");
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+static bool rest_assetutxos(const std::any& context, HTTPRequest* req, const std::string& uri_part)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RESTResponseFormat rf = ParseDataFormat(param, uri_part);
+
+    const auto asset_id{ParseRESTAssetId(req, param, "assetutxos")};
+    if (!asset_id) return false;
+
+    if (rf != RESTResponseFormat::BINARY && rf != RESTResponseFormat::HEX && rf != RESTResponseFormat::JSON) {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+
+    // Scanning the utxo set would need the coins cache flushed first, which a
+    // read-only endpoint must not be able to force, so the asset index is required.
+    if (!g_asset_index) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Asset index is not enabled (start with -assetindex)");
+    }
+    if (!g_asset_index->BlockUntilSyncedToCurrentChain()) {
+        return RESTERR(req, HTTP_SERVICE_UNAVAILABLE, "Asset index is still being built, try again later");
+    }
+    std::vector<std::pair<COutPoint, AssetIndexCoin>> index_coins;
+    if (!g_asset_index->FindAssetCoins(*asset_id, std::nullopt, index_coins)) {
+        return RESTERR(req, HTTP_INTERNAL_SERVER_ERROR, "Unable to read asset index");
+    }
+
+    if (rf == RESTResponseFormat::BINARY) {
+        req->WriteHeader("Content-Type", "application/octet-stream");
+    } else if (rf == RESTResponseFormat::HEX) {
+        req->WriteHeader("Content-Type", "text/plain");
+    } else {
+        req->WriteHeader("Content-Type", "application/json");
+    }
+    req->StartReplyChunked(HTTP_OK);
+    if (rf == RESTResponseFormat::JSON) req->WriteReplyChunk("[");
+    bool first{true};
+    auto write_utxo = [&](const COutPoint& key, Coin&& coin) {
+        if (rf == RESTResponseFormat::JSON) {
+            UniValue utxo(UniValue::VOBJ);
+            utxo.pushKV("txid", key.hash.GetHex());
+            utxo.pushKV("vout", key.n);
+            utxo.pushKV("height", (int32_t)coin.nHeight);
+            utxo.pushKV("value", coin.out.nValue);
+            utxo.pushKV("assetcontrol", coin.fBitAssetControl);
+
+            UniValue o(UniValue::VOBJ);
+            ScriptToUniv(coin.out.scriptPubKey, /*out=*/o, /*include_hex=*/true, /*include_address=*/true);
+            utxo.pushKV("scriptPubKey", std::move(o));
+            req->WriteReplyChunk((first ? "" : ",") + utxo.write());
+        } else {
+            DataStream ssUTXO;
+            ssUTXO << key << CCoin(std::move(coin));
+            if (rf == RESTResponseFormat::BINARY) {
+                req->WriteReplyChunk(ssUTXO);
+            } else {
+                req->WriteReplyChunk(HexStr(ssUTXO));
+            }
+        }
+        first = false;
+    };
+
+    for (auto& [outpoint, coin] : index_coins) {
+        write_utxo(outpoint, Coin(CTxOut(coin.nValue, coin.scriptPubKey), coin.nHeight, /*fCoinBaseIn=*/false, /*fBitAssetIn=*/true, coin.fControl, /*isPreconfIn=*/false, /*isPeginIn=*/false, coin.nAssetID));
+    }
+    req->WriteReplyChunk(rf == RESTResponseFormat::JSON ? "]\n" : rf == RESTResponseFormat::HEX ? "\n" : "");
+    req->EndReplyChunked();
+    return true;
+}
+
 static const struct {
     const char* prefix;
     bool (*handler)(const std::any& context, HTTPRequest* req, const std::string& strReq);
@@ -1133,6 +1480,11 @@ static const struct {
       {"/rest/deploymentinfo", rest_deploymentinfo},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
       {"/rest/spenttxouts/", rest_spent_txouts},
+      {"/rest/signedblock/", rest_signedblock},
+      {"/rest/signedblocks/", rest_signedblocks},
+      {"/rest/preconfmempool/", rest_preconfmempool},
+      {"/rest/asset/", rest_asset},
+      {"/rest/assetutxos/", rest_assetutxos},
 };
 
 void StartREST(const std::any& context)
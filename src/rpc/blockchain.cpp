@@ -15,6 +15,7 @@
 #include <consensus/amount.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
+#include <coordinate/coordinate_assets.h>
 #include <core_io.h>
 #include <deploymentinfo.h>
 #include <deploymentstatus.h>
@@ -203,7 +204,8 @@ UniValue blockheaderToJSON(const BlockManager& blockman, const CBlockIndex& tip,
     return result;
 }
 
-UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const uint256 pow_limit)
+/** Block description to JSON, without the transactions */
+static UniValue blockSummaryToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, const uint256 pow_limit)
 {
     UniValue result = blockheaderToJSON(blockman, tip, blockindex, pow_limit);
     result.pushKV("currentkeys", block.currentKeys.empty() ? "" : block.currentKeys);
@@ -251,33 +253,48 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
     }
     result.pushKV("pegins", pegins);
 
+    return result;
+}
+
+/** Read the undo data of a block for the transaction details, or return nullptr if it is not available */
+static std::unique_ptr<CBlockUndo> ReadBlockUndoForJSON(BlockManager& blockman, const CBlockIndex& blockindex)
+{
+    const bool is_not_pruned{WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
+    bool have_undo{is_not_pruned && WITH_LOCK(::cs_main, return blockindex.nStatus & BLOCK_HAVE_UNDO)};
+    if (!have_undo) return nullptr;
+    auto blockUndo{std::make_unique<CBlockUndo>()};
+    if (!blockman.ReadBlockUndo(*blockUndo, blockindex)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Undo data expected but can't be read. This could be due to disk corruption or a conflict with a pruning event.");
+    }
+    return blockUndo;
+}
+
+/** Transaction i of a block to JSON, as listed in the block description */
+static UniValue blockTxToJSON(const CBlock& block, size_t i, const CBlockUndo* blockUndo, TxVerbosity verbosity)
+{
+    const CTransactionRef& tx = block.vtx.at(i);
+    if (verbosity == TxVerbosity::SHOW_TXID) {
+        return tx->GetHash().GetHex();
+    }
+    // coinbase transaction (i.e. i == 0) doesn't have undo data
+    const CTxUndo* txundo = (blockUndo && i > 0) ? &blockUndo->vtxundo.at(i - 1) : nullptr;
+    UniValue objTx(UniValue::VOBJ);
+    TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, txundo, verbosity);
+    return objTx;
+}
+
+UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const uint256 pow_limit)
+{
+    UniValue result = blockSummaryToJSON(blockman, block, tip, blockindex, pow_limit);
+
+    std::unique_ptr<CBlockUndo> blockUndo;
+    if (verbosity != TxVerbosity::SHOW_TXID) {
+        blockUndo = ReadBlockUndoForJSON(blockman, blockindex);
+    }
     UniValue txs(UniValue::VARR);
     txs.reserve(block.vtx.size());
-
-    switch (verbosity) {
-        case TxVerbosity::SHOW_TXID:
-            for (const CTransactionRef& tx : block.vtx) {
-                txs.push_back(tx->GetHash().GetHex());
-            }
-            break;
-
-        case TxVerbosity::SHOW_DETAILS:
-        case TxVerbosity::SHOW_DETAILS_AND_PREVOUT:
-            CBlockUndo blockUndo;
-            const bool is_not_pruned{WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
-            bool have_undo{is_not_pruned && WITH_LOCK(::cs_main, return blockindex.nStatus & BLOCK_HAVE_UNDO)};
-            if (have_undo && !blockman.ReadBlockUndo(blockUndo, blockindex)) {
-                throw JSONRPCError(RPC_INTERNAL_ERROR, "Undo data expected but can't be read. This could be due to disk corruption or a conflict with a pruning event.");
-            }
-            for (size_t i = 0; i < block.vtx.size(); ++i) {
-                const CTransactionRef& tx = block.vtx.at(i);
-                // coinbase transaction (i.e. i == 0) doesn't have undo data
-                const CTxUndo* txundo = (have_undo && i > 0) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
-                UniValue objTx(UniValue::VOBJ);
-                TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, txundo, verbosity);
-                txs.push_back(std::move(objTx));
-            }
-            break;
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        txs.push_back(blockTxToJSON(block, i, blockUndo.get(), verbosity));
     }
 
     result.pushKV("tx", std::move(txs));
@@ -285,6 +302,34 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
     return result;
 }
 
+JSONRPCResultWriter BlockToJSONWriter(BlockManager& blockman, std::shared_ptr<const CBlock> block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const uint256 pow_limit, UniValue extra)
+{
+    UniValue summary = blockSummaryToJSON(blockman, *block, tip, blockindex, pow_limit);
+    std::shared_ptr<const CBlockUndo> blockUndo;
+    if (verbosity != TxVerbosity::SHOW_TXID) {
+        blockUndo = ReadBlockUndoForJSON(blockman, blockindex);
+    }
+    return [summary = std::move(summary), block = std::move(block), blockUndo = std::move(blockUndo), verbosity, extra = std::move(extra)](UniValueWriter& writer) {
+        writer.beginObject();
+        for (size_t i = 0; i < summary.size(); ++i) {
+            writer.key(summary.getKeys()[i]);
+            writer.value(summary.getValues()[i]);
+        }
+        // Only one transaction is held as JSON at a time
+        writer.key("tx");
+        writer.beginArray();
+        for (size_t i = 0; i < block->vtx.size(); ++i) {
+            writer.value(blockTxToJSON(*block, i, blockUndo.get(), verbosity));
+        }
+        writer.endArray();
+        for (size_t i = 0; i < extra.size(); ++i) {
+            writer.key(extra.getKeys()[i]);
+            writer.value(extra.getValues()[i]);
+        }
+        writer.endObject();
+    };
+}
+
 UniValue AuxpowToJSON(const CAuxPow& auxpow, const bool verbose, Chainstate& active_chainstate)
 {
     UniValue result(UniValue::VOBJ);
@@ -960,6 +1005,15 @@ static RPCHelpMan getblock()
         tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
     }
 
+    if (request.m_result_writer && tx_verbosity != TxVerbosity::SHOW_TXID) {
+        UniValue extra(UniValue::VOBJ);
+        if (block.auxpow) {
+            extra.pushKV("auxpow", AuxpowToJSON(*block.auxpow, verbosity >= 1, chainman.ActiveChainstate()));
+        }
+        *request.m_result_writer = BlockToJSONWriter(chainman.m_blockman, std::make_shared<const CBlock>(std::move(block)), *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit, std::move(extra));
+        return NullUniValue;
+    }
+
     auto result = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit);
     if (block.auxpow) {
         result.pushKV("auxpow", AuxpowToJSON(*block.auxpow, verbosity >= 1, chainman.ActiveChainstate()));
@@ -1112,6 +1166,7 @@ static RPCHelpMan gettxoutsetinfo()
                          .type_str = {"", "string or numeric"},
                      }},
                     {"use_index", RPCArg::Type::BOOL, RPCArg::Default{true}, "Use coinstatsindex, if available."},
+                    {"assets", RPCArg::Type::BOOL, RPCArg::Default{false}, "Include the circulating supply of every asset."},
                 },
                 RPCResult{
                     RPCResult::Type::OBJ, "", "",
@@ -1124,7 +1179,18 @@ static RPCHelpMan gettxoutsetinfo()
                         {RPCResult::Type::STR_HEX, "muhash", /*optional=*/true, "The serialized hash (only present if 'muhash' hash_type is chosen)"},
                         {RPCResult::Type::NUM, "transactions", /*optional=*/true, "The number of transactions with unspent outputs (not available when coinstatsindex is used)"},
                         {RPCResult::Type::NUM, "disk_size", /*optional=*/true, "The estimated size of the chainstate on disk (not available when coinstatsindex is used)"},
-                        {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount of coins in the UTXO set"},
+                        {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount of coins in the UTXO set, excluding asset outputs"},
+                        {RPCResult::Type::NUM, "total_assets", "The total amount of all assets in the UTXO set, excluding asset controller outputs"},
+                        {RPCResult::Type::ARR, "assets", /*optional=*/true, "Circulating supply per asset (only present if 'assets' is true)",
+                        {
+                            {RPCResult::Type::OBJ, "", "",
+                            {
+                                {RPCResult::Type::NUM, "id", "The asset index within its creation block"},
+                                {RPCResult::Type::NUM, "blockheight", "The asset creation block height"},
+                                {RPCResult::Type::NUM, "supply", "Sum of unspent asset outputs, excluding controller outputs"},
+                                {RPCResult::Type::NUM, "issued", "Supply recorded in the asset database at the chain tip"},
+                            }},
+                        }},
                         {RPCResult::Type::STR_AMOUNT, "total_unspendable_amount", /*optional=*/true, "The total amount of coins permanently excluded from the UTXO set (only available if coinstatsindex is used)"},
                         {RPCResult::Type::OBJ, "block_info", /*optional=*/true, "Info on amounts in the block at this block height (only available if coinstatsindex is used)",
                         {
@@ -1147,6 +1213,7 @@ static RPCHelpMan gettxoutsetinfo()
                     HelpExampleCli("gettxoutsetinfo", R"("none" 1000)") +
                     HelpExampleCli("gettxoutsetinfo", R"("none" '"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09"')") +
                     HelpExampleCli("-named gettxoutsetinfo", R"(hash_type='muhash' use_index='false')") +
+                    HelpExampleCli("-named gettxoutsetinfo", R"(hash_type='none' assets=true)") +
                     HelpExampleRpc("gettxoutsetinfo", "") +
                     HelpExampleRpc("gettxoutsetinfo", R"("none")") +
                     HelpExampleRpc("gettxoutsetinfo", R"("none", 1000)") +
@@ -1216,6 +1283,37 @@ static RPCHelpMan gettxoutsetinfo()
         }
         CHECK_NONFATAL(stats.total_amount.has_value());
         ret.pushKV("total_amount", ValueFromAmount(stats.total_amount.value()));
+        CHECK_NONFATAL(stats.total_assets.has_value());
+        ret.pushKV("total_assets", stats.total_assets.value());
+        if (!request.params[3].isNull() && request.params[3].get_bool()) {
+            UniValue assets(UniValue::VARR);
+            for (const CoordinateAsset& asset : active_chainstate.passettree->GetAssets()) {
+                uint64_t blockNumber;
+                uint16_t assetIndex;
+                ParseAssetId(asset.nID, blockNumber, assetIndex);
+                // Assets created above the requested height did not exist yet
+                if (blockNumber > static_cast<uint64_t>(stats.nHeight)) continue;
+
+                CAmount supply{0};
+                if (stats.index_used) {
+                    const std::optional<CAmount> maybe_supply{g_coin_stats_index->LookUpAssetAmount(asset.nID, *pindex)};
+                    if (!maybe_supply) {
+                        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read asset supply from coinstatsindex");
+                    }
+                    supply = *maybe_supply;
+                } else if (auto it{stats.asset_amounts.find(asset.nID)}; it != stats.asset_amounts.end()) {
+                    supply = it->second;
+                }
+
+                UniValue entry(UniValue::VOBJ);
+                entry.pushKV("id", assetIndex);
+                entry.pushKV("blockheight", blockNumber);
+                entry.pushKV("supply", supply);
+                entry.pushKV("issued", asset.nSupply);
+                assets.push_back(std::move(entry));
+            }
+            ret.pushKV("assets", std::move(assets));
+        }
         if (!stats.index_used) {
             ret.pushKV("transactions", static_cast<int64_t>(stats.nTransactions));
             ret.pushKV("disk_size", stats.nDiskSize);
@@ -1555,8 +1653,10 @@ UniValue DeploymentInfo(const CBlockIndex* blockindex, const ChainstateManager&
     SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_CLTV);
     SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_CSV);
     SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_SEGWIT);
+    SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_COMPACT_WITNESS);
     SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_TESTDUMMY);
     SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_TAPROOT);
+    SoftForkDescPushBack(blockindex, softforks, chainman, Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS);
     return softforks;
 }
 } // anon namespace
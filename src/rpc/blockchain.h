@@ -7,6 +7,7 @@
 
 #include <consensus/amount.h>
 #include <core_io.h>
+#include <rpc/request.h>
 #include <streams.h>
 #include <sync.h>
 #include <util/fs.h>
@@ -14,6 +15,7 @@
 
 #include <any>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 class CBlock;
@@ -38,6 +40,10 @@ double GetDifficulty(uint32_t nBits);
 /** Block description to JSON */
 UniValue blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const uint256 pow_limit) LOCKS_EXCLUDED(cs_main);
 
+/** Block description to JSON, written incrementally so that only one transaction
+ * is held as JSON at a time. The members of extra are appended after "tx". */
+JSONRPCResultWriter BlockToJSONWriter(node::BlockManager& blockman, std::shared_ptr<const CBlock> block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const uint256 pow_limit, UniValue extra) LOCKS_EXCLUDED(cs_main);
+
 /** Block header to JSON */
 UniValue blockheaderToJSON(const node::BlockManager& blockman, const CBlockIndex& tip, const CBlockIndex& blockindex, const uint256 pow_limit) LOCKS_EXCLUDED(cs_main);
 
@@ -95,6 +95,12 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "getdescriptoractivity", 1, "scanobjects" },
     { "getdescriptoractivity", 2, "include_mempool" },
     { "scantxoutset", 1, "scanobjects" },
+    { "getassetbalance", 0, "blockheight" },
+    { "getassetbalance", 1, "id" },
+    { "listassetholders", 0, "blockheight" },
+    { "listassetholders", 1, "id" },
+    { "getassetsupply", 0, "blockheight" },
+    { "getassetsupply", 1, "id" },
     { "createmultisig", 0, "nrequired" },
     { "createmultisig", 1, "keys" },
     { "listunspent", 0, "minconf" },
@@ -187,6 +193,16 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "gettxoutproof", 0, "txids" },
     { "gettxoutsetinfo", 1, "hash_or_height" },
     { "gettxoutsetinfo", 2, "use_index"},
+    { "gettxoutsetinfo", 3, "assets"},
+    { "getpreconflist", 1, "verbose" },
+    { "getpreconflist", 3, "count" },
+    { "getfinalizedsignedblocks", 0, "verbosity" },
+    { "getfinalizedsignedblocks", 1, "start_height" },
+    { "getfinalizedsignedblocks", 2, "count" },
+    { "estimatepreconffee", 0, "signed_blocks" },
+    { "getfederationwitnessmessage", 0, "options" },
+    { "createfederationwitness", 1, "signatures" },
+    { "signfederationwitnesswithkey", 2, "privkeys" },
     { "dumptxoutset", 2, "options" },
     { "dumptxoutset", 2, "rollback" },
     { "lockunspent", 0, "unlock" },
@@ -10,6 +10,7 @@
 #include <coordinate/coordinate_mempool_entry.h>
 #include <coordinate/coordinate_pegin.h>
 #include <coordinate/anduro_validator.h>
+#include <index/assetindex.h>
 #include <rpc/request.h>
 
 using node::NodeContext;
@@ -199,6 +200,27 @@ static RPCHelpMan getPendingCommitments() {
 
 }
 
+UniValue AssetToJSON(const CoordinateAsset& asset)
+{
+    uint64_t blockNumber;
+    uint16_t assetIndex;
+    ParseAssetId(asset.nID, blockNumber, assetIndex);
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("id", assetIndex);
+    obj.pushKV("blockheight", blockNumber);
+    obj.pushKV("assettype", asset.assetType);
+    obj.pushKV("precision", asset.precision);
+    obj.pushKV("ticker", asset.strTicker);
+    obj.pushKV("supply", asset.nSupply);
+    obj.pushKV("headline", asset.strHeadline);
+    obj.pushKV("payload", asset.payload.ToString());
+    obj.pushKV("txid", asset.txid.ToString());
+    obj.pushKV("controller", asset.strController);
+    obj.pushKV("owner", asset.strOwner);
+    return obj;
+}
+
 static RPCHelpMan listAllAssets() {
         return RPCHelpMan{
         "listallassets",
@@ -240,23 +262,7 @@ static RPCHelpMan listAllAssets() {
             ;
 
             for (const CoordinateAsset& asset_item : assetList) {
-                uint64_t blockNumber;
-                uint16_t assetIndex;
-                ParseAssetId(asset_item.nID, blockNumber, assetIndex);
-
-                UniValue obj(UniValue::VOBJ);
-                obj.pushKV("id", assetIndex);
-                obj.pushKV("blockheight", blockNumber);
-                obj.pushKV("assettype", asset_item.assetType);
-                obj.pushKV("precision", asset_item.precision);
-                obj.pushKV("ticker", asset_item.strTicker);
-                obj.pushKV("supply", asset_item.nSupply);
-                obj.pushKV("headline", asset_item.strHeadline);
-                obj.pushKV("payload", asset_item.payload.ToString());
-                obj.pushKV("txid", asset_item.txid.ToString());
-                obj.pushKV("controller", asset_item.strController);
-                obj.pushKV("owner", asset_item.strOwner);
-                assets.push_back(obj);
+                assets.push_back(AssetToJSON(asset_item));
             }
             result.pushKV("assets", assets);
             return result;
@@ -313,6 +319,228 @@ static RPCHelpMan listMempoolAssets() {
         }};
 }
 
+static std::vector<unsigned char> ParseAssetIdArgs(const UniValue& blockheight, const UniValue& index)
+{
+    const int64_t nBlockHeight{blockheight.getInt<int64_t>()};
+    const int nIndex{index.getInt<int>()};
+    if (nBlockHeight < 0 || nIndex < 0 || nIndex > 999) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid asset id");
+    }
+    return CreateAssetId(nBlockHeight, nIndex);
+}
+
+static AssetIndex& EnsureSyncedAssetIndex()
+{
+    if (!g_asset_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Asset index not enabled. Restart with -assetindex");
+    }
+    if (!g_asset_index->BlockUntilSyncedToCurrentChain()) {
+        throw JSONRPCError(RPC_MISC_ERROR, strprintf("Asset index is still syncing. Current height: %d", g_asset_index->GetSummary().best_block_height));
+    }
+    return *g_asset_index;
+}
+
+static RPCHelpMan getAssetBalance() {
+        return RPCHelpMan{
+        "getassetbalance",
+        "get the confirmed balance of a coordinate asset held by an address. Requires -assetindex",
+        {
+            {"blockheight", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset block height"},
+            {"id", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset id within the block"},
+            {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "Holder address"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "balance", "Asset balance, excluding controller outputs"},
+                {RPCResult::Type::NUM, "utxos", "Number of unspent asset outputs"},
+                {RPCResult::Type::BOOL, "controller", "Whether the address holds the asset controller output"},
+            },
+        },
+        RPCExamples{
+           HelpExampleCli("getassetbalance", "100 1 \"address\"")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+        {
+            const std::vector<unsigned char> assetId = ParseAssetIdArgs(request.params[0], request.params[1]);
+            const CTxDestination dest = DecodeDestination(request.params[2].get_str());
+            if (!IsValidDestination(dest)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
+            }
+
+            std::vector<std::pair<COutPoint, AssetIndexCoin>> coins;
+            if (!EnsureSyncedAssetIndex().FindAssetCoins(assetId, GetScriptForDestination(dest), coins)) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read asset index");
+            }
+
+            CAmount balance = 0;
+            bool controller = false;
+            for (const auto& [outpoint, coin] : coins) {
+                if (coin.fControl) {
+                    controller = true;
+                } else {
+                    balance += coin.nValue;
+                }
+            }
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("balance", balance);
+            result.pushKV("utxos", (uint64_t)coins.size());
+            result.pushKV("controller", controller);
+            return result;
+        }};
+}
+
+static RPCHelpMan listAssetHolders() {
+        return RPCHelpMan{
+        "listassetholders",
+        "get all holders of a coordinate asset with their confirmed balance. Requires -assetindex",
+        {
+            {"blockheight", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset block height"},
+            {"id", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset id within the block"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::ARR, "holders", "",
+                {
+                     {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "address", /*optional=*/true, "Holder address, only if the script has one"},
+                            {RPCResult::Type::STR_HEX, "scriptPubKey", "Holder script"},
+                            {RPCResult::Type::NUM, "balance", "Asset balance, excluding controller outputs"},
+                            {RPCResult::Type::BOOL, "controller", "Whether the holder has the asset controller output"},
+                        }
+                     }
+                }},
+            },
+        },
+        RPCExamples{
+           HelpExampleCli("listassetholders", "100 1")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+        {
+            const std::vector<unsigned char> assetId = ParseAssetIdArgs(request.params[0], request.params[1]);
+
+            std::vector<std::pair<COutPoint, AssetIndexCoin>> coins;
+            if (!EnsureSyncedAssetIndex().FindAssetCoins(assetId, std::nullopt, coins)) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read asset index");
+            }
+
+            // Outputs come grouped by holder script
+            UniValue holders(UniValue::VARR);
+            for (auto it = coins.begin(); it != coins.end();) {
+                const CScript& script = it->second.scriptPubKey;
+                CAmount balance = 0;
+                bool controller = false;
+                for (; it != coins.end() && it->second.scriptPubKey == script; ++it) {
+                    if (it->second.fControl) {
+                        controller = true;
+                    } else {
+                        balance += it->second.nValue;
+                    }
+                }
+
+                UniValue obj(UniValue::VOBJ);
+                CTxDestination dest;
+                if (ExtractDestination(script, dest)) {
+                    obj.pushKV("address", EncodeDestination(dest));
+                }
+                obj.pushKV("scriptPubKey", HexStr(script));
+                obj.pushKV("balance", balance);
+                obj.pushKV("controller", controller);
+                holders.push_back(obj);
+            }
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("holders", holders);
+            return result;
+        }};
+}
+
+static RPCHelpMan getAssetSupply() {
+        return RPCHelpMan{
+        "getassetsupply",
+        "get the circulating supply of a coordinate asset from its unspent outputs. Requires -assetindex",
+        {
+            {"blockheight", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset block height"},
+            {"id", RPCArg::Type::NUM, RPCArg::Optional::NO, "Asset id within the block"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "height", "Height the asset index is synced to"},
+                {RPCResult::Type::NUM, "supply", "Sum of unspent asset outputs, excluding controller outputs"},
+                {RPCResult::Type::NUM, "utxos", "Number of unspent asset outputs"},
+                {RPCResult::Type::NUM, "issued", "Supply recorded in the asset database"},
+            },
+        },
+        RPCExamples{
+           HelpExampleCli("getassetsupply", "100 1")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+        {
+            NodeContext& node = EnsureAnyNodeContext(request.context);
+            ChainstateManager& chainman = EnsureChainman(node);
+            const std::vector<unsigned char> assetId = ParseAssetIdArgs(request.params[0], request.params[1]);
+
+            CoordinateAsset asset;
+            if (!chainman.ActiveChainstate().passettree->GetAsset(getAssetHash(assetId), asset)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Asset not found");
+            }
+
+            AssetIndex& index = EnsureSyncedAssetIndex();
+            AssetIndexSupply supply;
+            if (!index.LookUpSupply(assetId, supply)) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read asset index");
+            }
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("height", index.GetSummary().best_block_height);
+            result.pushKV("supply", supply.nAmount);
+            result.pushKV("utxos", supply.nOutputs);
+            result.pushKV("issued", asset.nSupply);
+            return result;
+        }};
+}
+
+static RPCHelpMan getAssetCacheInfo() {
+        return RPCHelpMan{
+        "getassetcacheinfo",
+        "get usage and hit rate of the in-memory asset metadata cache in front of the asset database",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "entries", "Number of cached assets"},
+                {RPCResult::Type::NUM, "usage", "Memory used by the cache in bytes"},
+                {RPCResult::Type::NUM, "max_usage", "Maximum memory the cache may use in bytes"},
+                {RPCResult::Type::NUM, "hits", "Asset lookups answered from the cache"},
+                {RPCResult::Type::NUM, "misses", "Asset lookups that read the database"},
+                {RPCResult::Type::NUM, "hit_rate", "Share of lookups answered from the cache"},
+            },
+        },
+        RPCExamples{
+           HelpExampleCli("getassetcacheinfo", "") + HelpExampleRpc("getassetcacheinfo", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+        {
+            NodeContext& node = EnsureAnyNodeContext(request.context);
+            ChainstateManager& chainman = EnsureChainman(node);
+            const CoordinateAssetDB::CacheStats stats{WITH_LOCK(cs_main, return chainman.ActiveChainstate().passettree->GetCacheStats())};
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("entries", (uint64_t)stats.entries);
+            result.pushKV("usage", (uint64_t)stats.usage);
+            result.pushKV("max_usage", (uint64_t)stats.max_usage);
+            result.pushKV("hits", stats.hits);
+            result.pushKV("misses", stats.misses);
+            const uint64_t lookups{stats.hits + stats.misses};
+            result.pushKV("hit_rate", lookups ? double(stats.hits) / lookups : 0.0);
+            return result;
+        }};
+}
+
 static RPCHelpMan createPegin()
 {
     return RPCHelpMan{"createpegin",
@@ -396,6 +624,10 @@ void RegisterCoordinateRPCCommands(CRPCTable& t)
         {"coordinate", &anduroWithdrawAddress},
         {"coordinate", &listAllAssets},
         {"coordinate", &listMempoolAssets},
+        {"coordinate", &getAssetBalance},
+        {"coordinate", &listAssetHolders},
+        {"coordinate", &getAssetSupply},
+        {"coordinate", &getAssetCacheInfo},
         {"coordinate", createPegin}
     };
     for (const auto& c : commands) {
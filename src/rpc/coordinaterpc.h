@@ -5,5 +5,10 @@
 #ifndef BITCOIN_RPC_COORDINATERPC_H
 #define BITCOIN_RPC_COORDINATERPC_H
 
+struct CoordinateAsset;
+class UniValue;
+
+/** Coordinate asset description to JSON */
+UniValue AssetToJSON(const CoordinateAsset& asset);
 
 #endif // BITCOIN_RPC_COORDINATERPC_H
@@ -385,6 +385,69 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
     }
 }
 
+JSONRPCResultWriter MempoolToJSONWriter(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence)
+{
+    if (verbose && include_mempool_sequence) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Verbose results cannot contain mempool sequence values.");
+    }
+    // Only the txids are taken up front, the rest is looked up while writing
+    auto txids{std::make_shared<std::vector<Txid>>()};
+    uint64_t mempool_sequence;
+    {
+        LOCK(pool.cs);
+        txids->reserve(pool.size());
+        for (const CTxMemPoolEntry& e : pool.entryAll()) {
+            txids->push_back(e.GetTx().GetHash());
+        }
+        mempool_sequence = pool.GetSequence();
+    }
+    if (!verbose) {
+        return [txids, mempool_sequence, include_mempool_sequence](UniValueWriter& writer) {
+            if (include_mempool_sequence) {
+                writer.beginObject();
+                writer.key("txids");
+            }
+            writer.beginArray();
+            for (const Txid& txid : *txids) {
+                writer.value(txid.ToString());
+            }
+            writer.endArray();
+            if (include_mempool_sequence) {
+                writer.key("mempool_sequence");
+                writer.value(mempool_sequence);
+                writer.endObject();
+            }
+        };
+    }
+    return [&pool, txids](UniValueWriter& writer) {
+        // Entries are described in batches, so that the mempool is not locked
+        // while the writer waits for the client. Entries removed in between
+        // are left out.
+        static constexpr size_t BATCH_SIZE{1000};
+        writer.beginObject();
+        std::vector<std::pair<const Txid*, UniValue>> batch;
+        for (size_t start = 0; start < txids->size(); start += BATCH_SIZE) {
+            const size_t end{std::min(start + BATCH_SIZE, txids->size())};
+            {
+                LOCK(pool.cs);
+                for (size_t i = start; i < end; ++i) {
+                    const auto it{pool.GetIter((*txids)[i])};
+                    if (!it) continue;
+                    UniValue info(UniValue::VOBJ);
+                    entryToJSON(pool, info, **it);
+                    batch.emplace_back(&(*txids)[i], std::move(info));
+                }
+            }
+            for (const auto& [txid, info] : batch) {
+                writer.key(txid->ToString());
+                writer.value(info);
+            }
+            batch.clear();
+        }
+        writer.endObject();
+    };
+}
+
 static RPCHelpMan getrawmempool()
 {
     return RPCHelpMan{
@@ -431,6 +494,10 @@ static RPCHelpMan getrawmempool()
         include_mempool_sequence = request.params[1].get_bool();
     }
 
+    if (request.m_result_writer) {
+        *request.m_result_writer = MempoolToJSONWriter(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence);
+        return NullUniValue;
+    }
     return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence);
 },
     };
@@ -1189,10 +1256,9 @@ static RPCHelpMan sendprecommitment()
                     fedParams.find_value("block_height").getInt<int32_t>(),fedParams.find_value("nextindex").getInt<int32_t>(),fedParams.find_value("nextkeys").get_str(),fedParams.find_value("deposit_address").get_str(),fedParams.find_value("burn_address").get_str());
                     commitments.push_back(commitment);
                 }
-                if(!isPreCommitmentValid(commitments,chainman)) {
+                if(!includePreCommitmentSignature(commitments, chainman)) {
                         throw JSONRPCError(RPC_WALLET_ERROR, "Coinbase Special Txout is invalid");
                 }
-                includePreCommitmentSignature(commitments);
                 return "success";
             }
             throw JSONRPCError(RPC_WALLET_ERROR, "no commitment summited");
@@ -5,6 +5,8 @@
 #ifndef BITCOIN_RPC_MEMPOOL_H
 #define BITCOIN_RPC_MEMPOOL_H
 
+#include <rpc/request.h>
+
 class CTxMemPool;
 class UniValue;
 
@@ -14,4 +16,8 @@ UniValue MempoolInfoToJSON(const CTxMemPool& pool);
 /** Mempool to JSON */
 UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false);
 
+/** Mempool to JSON, written incrementally. The verbose form describes the
+ * entries in batches and leaves out those removed while it is written. */
+JSONRPCResultWriter MempoolToJSONWriter(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false);
+
 #endif // BITCOIN_RPC_MEMPOOL_H
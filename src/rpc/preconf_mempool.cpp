@@ -4,6 +4,7 @@
 #include <chainparams.h>
 #include <coordinate/coordinate_preconf.h>
 #include <core_io.h>
+#include <key_io.h>
 #include <kernel/mempool_entry.h>
 #include <node/mempool_persist.h>
 #include <node/types.h>
@@ -13,12 +14,15 @@
 #include <policy/settings.h>
 #include <primitives/transaction.h>
 #include <rpc/blockchain.h>
+#include <rpc/preconf_mempool.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <txmempool.h>
 #include <univalue.h>
 #include <util/moneystr.h>
+#include <util/strencodings.h>
+#include <util/string.h>
 #include <util/time.h>
 #include <utility>
 #include <net.h>
@@ -27,6 +31,10 @@ using node::BlockManager;
 using node::DEFAULT_MAX_RAW_TX_FEE_RATE;
 using node::NodeContext;
 using node::TransactionError;
+using util::SplitString;
+
+/** Default number of recent signed blocks estimatepreconffee looks at */
+static constexpr int64_t DEFAULT_PRECONF_FEE_ESTIMATE_BLOCKS{6};
 
 static RPCHelpMan sendpreconftransaction()
 {
@@ -187,36 +195,100 @@ static RPCHelpMan getpreconffee()
     };
 }
 
+static RPCHelpMan estimatepreconffee()
+{
+    return RPCHelpMan{
+        "estimatepreconffee",
+        "\nEstimate the preconf fee needed to be included in one of the next signed blocks, based on the\n"
+        "clearing fees of recently connected signed blocks.\n",
+        {
+            {"signed_blocks", RPCArg::Type::NUM, RPCArg::Default{int{DEFAULT_PRECONF_FEE_ESTIMATE_BLOCKS}}, strprintf("The number of recent signed blocks to consider (1-%u)", PRECONF_FEE_HISTORY)},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_AMOUNT, "fee", "highest clearing fee over the considered signed blocks, never below the preconf minimum fee"},
+                {RPCResult::Type::NUM, "blocks", "number of signed blocks the estimate is based on"},
+            }},
+        RPCExamples{
+            HelpExampleCli("estimatepreconffee", "6") + HelpExampleRpc("estimatepreconffee", "6")},
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
+            const int64_t signed_blocks{request.params[0].isNull() ? DEFAULT_PRECONF_FEE_ESTIMATE_BLOCKS : request.params[0].getInt<int64_t>()};
+            if (signed_blocks < 1 || signed_blocks > (int64_t)PRECONF_FEE_HISTORY) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid signed_blocks, must be between 1 and %u", PRECONF_FEE_HISTORY));
+            }
+
+            std::vector<CAmount> fees;
+            {
+                LOCK(cs_main);
+                fees = getRecentSignedBlockFees(signed_blocks);
+            }
+            CAmount fee = getPreConfMinFee();
+            for (const CAmount blockFee : fees) {
+                fee = std::max(fee, blockFee);
+            }
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("fee", ValueFromAmount(fee));
+            result.pushKV("blocks", (int64_t)fees.size());
+            return result;
+        },
+    };
+}
+
 static RPCHelpMan getpreconflist()
 {
     return RPCHelpMan{
         "getpreconflist",
-        "\nGet current getpreconf votes list \n",
+        "\nGet current getpreconf votes list \n"
+        "\nAll votes are returned unless count is set. To walk through a large backlog in pages, pass the\n"
+        "returned next_cursor as cursor. The cursor stays valid while votes are added or removed.\n",
         {
             {"height", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "The height index"},
+            {"verbose", RPCArg::Type::BOOL, RPCArg::Default{true}, "True for vote details, false for an array of transaction ids"},
+            {"cursor", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Only return votes after this next_cursor of a previous call"},
+            {"count", RPCArg::Type::NUM, RPCArg::Optional::OMITTED, "The maximum number of votes to return, all if not set"},
         },
-        RPCResult{
-            RPCResult::Type::OBJ,
-            "",
-            "",
-            {
-                {RPCResult::Type::ARR, "block", "",
+        {
+            RPCResult{"for verbose = true",
+                RPCResult::Type::OBJ,
+                "",
+                "",
                 {
-                     {RPCResult::Type::OBJ, "", "",
-                        {
-                            {RPCResult::Type::STR, "txid", "preconf transaction txid"},
-                            {RPCResult::Type::NUM, "mined_block_height", "mine block height"},
-                            {RPCResult::Type::NUM, "signed_block_height", "signed block height"},
-                            {RPCResult::Type::NUM, "reserve", "Transaction reserve amount"},
-                            {RPCResult::Type::NUM, "vsize", "Transaction virtual size"},
-                            {RPCResult::Type::NUM, "finalized", "Finalized list from federation leader or not"},
-                            {RPCResult::Type::STR, "federationkey", "federation identification"}
-                        }
-                     }
-                }},
+                    {RPCResult::Type::ARR, "block", "",
+                    {
+                         {RPCResult::Type::OBJ, "", "",
+                            {
+                                {RPCResult::Type::STR, "txid", "preconf transaction txid"},
+                                {RPCResult::Type::NUM, "mined_block_height", "mine block height"},
+                                {RPCResult::Type::NUM, "signed_block_height", "signed block height"},
+                                {RPCResult::Type::NUM, "reserve", "Transaction reserve amount"},
+                                {RPCResult::Type::NUM, "vsize", "Transaction virtual size"},
+                                {RPCResult::Type::NUM, "finalized", "Finalized list from federation leader or not"},
+                                {RPCResult::Type::STR, "federationkey", "federation identification"}
+                            }
+                         }
+                    }},
+                    {RPCResult::Type::NUM, "total", "Number of votes matching the height"},
+                    {RPCResult::Type::STR, "next_cursor", /*optional=*/true, "Cursor for the next page, only if votes were left out"},
+                },
+            },
+            RPCResult{"for verbose = false",
+                RPCResult::Type::OBJ,
+                "",
+                "",
+                {
+                    {RPCResult::Type::ARR, "block", "",
+                    {
+                        {RPCResult::Type::STR_HEX, "", "preconf transaction txid, empty for a vote without transaction"},
+                    }},
+                    {RPCResult::Type::NUM, "total", "Number of votes matching the height"},
+                    {RPCResult::Type::STR, "next_cursor", /*optional=*/true, "Cursor for the next page, only if votes were left out"},
+                },
             },
         },
-        RPCExamples{"\nGet current preconf block in queue\n" + HelpExampleCli("getpreconflist", "height")},
+        RPCExamples{"\nGet current preconf block in queue\n" + HelpExampleCli("getpreconflist", "height") +
+                    "\nGet the next page of transaction ids of all heights\n" + HelpExampleCli("getpreconflist", "\"0\" false \"next_cursor\" 1000")},
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
 
             const NodeContext& node{EnsureAnyNodeContext(request.context)};
@@ -232,113 +304,191 @@ static RPCHelpMan getpreconflist()
                 }
                 nHeight = nHeightValue.value();
             }
+            const bool fVerbose{request.params[1].isNull() || request.params[1].get_bool()};
+            // A vote is identified by the sequence number of its signature and its position in it
+            std::pair<uint64_t, uint64_t> cursor{0, 0};
+            bool fCursor{false};
+            if (!request.params[2].isNull()) {
+                const std::vector<std::string> parts{SplitString(request.params[2].get_str(), ':')};
+                const auto sequence{parts.size() == 2 ? ToIntegral<uint64_t>(parts[0]) : std::nullopt};
+                const auto index{parts.size() == 2 ? ToIntegral<uint64_t>(parts[1]) : std::nullopt};
+                if (!sequence || !index) {
+                    throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+                }
+                cursor = {*sequence, *index};
+                fCursor = true;
+            }
+            const std::optional<int64_t> nCount{request.params[3].isNull() ? std::nullopt : std::optional<int64_t>{request.params[3].getInt<int64_t>()}};
+            if (nCount && *nCount < 1) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Count must be positive");
+            }
 
-            UniValue result(UniValue::VOBJ);
+            // Walk the votes in place and only build the requested page
             UniValue block(UniValue::VARR);
-            std::vector<CoordinatePreConfSig> coordinatePreConfSigs = getPreConfSig();
-            for (const CoordinatePreConfSig& coordinatePreConfSig : coordinatePreConfSigs) {
-                    if (coordinatePreConfSig.blockHeight == (int32_t)nHeight || nHeight == 0) {
-                        for (size_t i = 0; i < coordinatePreConfSig.txids.size(); i++)
-                        {
-                            UniValue voteItem(UniValue::VOBJ);
-                            if(coordinatePreConfSig.txids[i] == uint256::ZERO) {
-                                voteItem.pushKV("txid","");
-                                voteItem.pushKV("reserve", 0);
-                                voteItem.pushKV("vsize", 0);
-                            } else {
-                                TxMempoolInfo info = preconf_pool.info(Txid::FromUint256(coordinatePreConfSig.txids[i]));
-                                if(info.tx) {
-                                    voteItem.pushKV("txid",  coordinatePreConfSig.txids[i].ToString());
-                                    voteItem.pushKV("reserve", info.tx->vout[0].nValue);
-                                    voteItem.pushKV("vsize", info.vsize);
-                                } else {
-                                    voteItem.pushKV("txid","");
-                                    voteItem.pushKV("reserve", 0);
-                                    voteItem.pushKV("vsize", 0);
-                                }
-                            }
-                                voteItem.pushKV("mined_block_height", coordinatePreConfSig.minedBlockHeight);
-                                voteItem.pushKV("signed_block_height", coordinatePreConfSig.blockHeight);
-                                voteItem.pushKV("finalized", coordinatePreConfSig.finalized);
-                                voteItem.pushKV("federationkey", coordinatePreConfSig.federationKey);
-                                block.push_back(voteItem);
-                        }
+            uint64_t total = 0;
+            int64_t returned = 0;
+            std::optional<std::pair<uint64_t, uint64_t>> last;
+            bool fMore{false};
+            LOCK(cs_main);
+            forEachPreConfSig([&](const CoordinatePreConfSig& coordinatePreConfSig) {
+                if (coordinatePreConfSig.blockHeight != (int32_t)nHeight && nHeight != 0) return true;
+                for (size_t i = 0; i < coordinatePreConfSig.txids.size(); i++) {
+                    total++;
+                    const std::pair<uint64_t, uint64_t> position{coordinatePreConfSig.nSequence, i};
+                    if (fCursor && position <= cursor) continue;
+                    if (nCount && returned >= *nCount) {
+                        fMore = true;
+                        continue;
+                    }
+                    returned++;
+                    last = position;
+
+                    TxMempoolInfo info;
+                    if (coordinatePreConfSig.txids[i] != uint256::ZERO) {
+                        info = preconf_pool.info(Txid::FromUint256(coordinatePreConfSig.txids[i]));
+                    }
+                    if (!fVerbose) {
+                        block.push_back(info.tx ? coordinatePreConfSig.txids[i].ToString() : "");
+                        continue;
+                    }
 
-              
+                    UniValue voteItem(UniValue::VOBJ);
+                    if (info.tx) {
+                        voteItem.pushKV("txid", coordinatePreConfSig.txids[i].ToString());
+                        voteItem.pushKV("reserve", info.tx->vout[0].nValue);
+                        voteItem.pushKV("vsize", info.vsize);
+                    } else {
+                        voteItem.pushKV("txid", "");
+                        voteItem.pushKV("reserve", 0);
+                        voteItem.pushKV("vsize", 0);
+                    }
+                    voteItem.pushKV("mined_block_height", coordinatePreConfSig.minedBlockHeight);
+                    voteItem.pushKV("signed_block_height", coordinatePreConfSig.blockHeight);
+                    voteItem.pushKV("finalized", coordinatePreConfSig.finalized);
+                    voteItem.pushKV("federationkey", coordinatePreConfSig.federationKey);
+                    block.push_back(std::move(voteItem));
                 }
+                return true;
+            });
+
+            UniValue result(UniValue::VOBJ);
+            result.pushKV("block", std::move(block));
+            result.pushKV("total", total);
+            if (fMore) {
+                result.pushKV("next_cursor", strprintf("%u:%u", last->first, last->second));
             }
-            result.pushKV("block", block);
             return result;
         },
     };
 }
 
+UniValue signedBlockToJSON(const SignedBlock& block, bool txDetails)
+{
+    int blockSize = 0;
+    blockSize += sizeof(block.currentFee);
+    blockSize += sizeof(block.blockIndex);
+    blockSize += sizeof(block.nHeight);
+    blockSize += sizeof(block.nTime);
+    blockSize += block.hashPrevSignedBlock.size();
+    blockSize += block.hashMerkleRoot.size();
+    blockSize += block.GetHash().size();
+    for (const CTransactionRef& tx : block.vtx) {
+        blockSize +=  GetVirtualTransactionSize(*tx);
+    }
+
+    UniValue blockDetails(UniValue::VOBJ);
+    UniValue txs(UniValue::VARR);
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const CTransactionRef& tx = block.vtx.at(i);
+        if (!txDetails) {
+            txs.push_back(tx->GetHash().GetHex());
+            continue;
+        }
+        UniValue objTx(UniValue::VOBJ);
+        TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true);
+        txs.push_back(objTx);
+    }
+
+    blockDetails.pushKV("fee", block.currentFee);
+    blockDetails.pushKV("blockindex", (uint64_t)block.blockIndex);
+    blockDetails.pushKV("height", (uint64_t)block.nHeight);
+    blockDetails.pushKV("time", block.nTime);
+    blockDetails.pushKV("size", blockSize);
+    blockDetails.pushKV("previousblock", block.hashPrevSignedBlock.ToString());
+    blockDetails.pushKV("merkleroot", block.hashMerkleRoot.ToString());
+    blockDetails.pushKV("hash", block.GetHash().ToString());
+    blockDetails.pushKV("tx", txs);
+
+    return blockDetails;
+}
+
 static RPCHelpMan getfinalizedsignedblocks() {
         return RPCHelpMan{
         "getfinalizedsignedblocks" ,
-        "get finalized signed blocks",
+        "get finalized signed blocks\n"
+        "\nThe blocks are ordered by height and all of them are returned unless count is set. To get the next page,\n"
+        "pass the height after the last returned block as start_height.\n",
         {
+            {"verbosity", RPCArg::Type::NUM, RPCArg::Default{2}, "0 for signed block hashes, 1 for signed block details with transaction ids, 2 for signed block details with decoded transactions"},
+            {"start_height", RPCArg::Type::NUM, RPCArg::Default{0}, "The lowest signed block height to return"},
+            {"count", RPCArg::Type::NUM, RPCArg::Optional::OMITTED, "The maximum number of signed blocks to return, all if not set"},
         },
-        RPCResult{
-            RPCResult::Type::ARR, "", "",
-            {
+        {
+            RPCResult{"for verbosity = 0",
+                RPCResult::Type::ARR, "", "",
+                {
+                    {RPCResult::Type::STR_HEX, "", "Signed block hash"},
+                },
+            },
+            RPCResult{"for verbosity = 1 or 2",
+                RPCResult::Type::ARR, "", "",
                 {
-                    {RPCResult::Type::OBJ, "", "Signed block details",
                     {
-                        {RPCResult::Type::NUM, "fee", "Signed block fee"},
-                        {RPCResult::Type::NUM, "blockindex", "block index where anduro witness refer back to the pubkeys"},
-                        {RPCResult::Type::NUM, "height", "Signed block height"},
-                        {RPCResult::Type::NUM, "time", "Signed block time"},
-                        {RPCResult::Type::STR_HEX, "previousblock", "previous signed block hash"},
-                        {RPCResult::Type::STR_HEX, "merkleroot", "signed block merkle root hash"},
-                        {RPCResult::Type::STR_HEX, "hash", "Signed block hash"},
-                        {RPCResult::Type::ARR, "tx", "The transaction ids",
-                            {{RPCResult::Type::STR_HEX, "", "The transaction id"}}},
-                    }},
+                        {RPCResult::Type::OBJ, "", "Signed block details",
+                        {
+                            {RPCResult::Type::NUM, "fee", "Signed block fee"},
+                            {RPCResult::Type::NUM, "blockindex", "block index where anduro witness refer back to the pubkeys"},
+                            {RPCResult::Type::NUM, "height", "Signed block height"},
+                            {RPCResult::Type::NUM, "time", "Signed block time"},
+                            {RPCResult::Type::NUM, "size", "Signed block size"},
+                            {RPCResult::Type::STR_HEX, "previousblock", "previous signed block hash"},
+                            {RPCResult::Type::STR_HEX, "merkleroot", "signed block merkle root hash"},
+                            {RPCResult::Type::STR_HEX, "hash", "Signed block hash"},
+                            {RPCResult::Type::ARR, "tx", "The transaction ids, or the decoded transactions for verbosity 2",
+                                {{RPCResult::Type::ELISION, "", ""}}},
+                        }},
+                    },
                 },
             },
         },
         RPCExamples{
-            HelpExampleCli("getfinalizedsignedblocks", ""),
+            HelpExampleCli("getfinalizedsignedblocks", "") +
+            HelpExampleCli("getfinalizedsignedblocks", "1 1200 50"),
 
         },
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
-            LOCK(cs_main);
-            UniValue result(UniValue::VARR);
-            std::vector<SignedBlock> finalizedBlocks = getFinalizedSignedBlocks();
-            for (const SignedBlock& block : finalizedBlocks) {
-                int blockSize = 0;
-                blockSize += sizeof(block.currentFee);
-                blockSize += sizeof(block.blockIndex);
-                blockSize += sizeof(block.nHeight);
-                blockSize += sizeof(block.nTime);
-                blockSize += block.hashPrevSignedBlock.size();
-                blockSize += block.hashMerkleRoot.size();
-                blockSize += block.GetHash().size();
-                for (const CTransactionRef& tx : block.vtx) {
-                    blockSize +=  GetVirtualTransactionSize(*tx);
-                }
+            const int verbosity{request.params[0].isNull() ? 2 : request.params[0].getInt<int>()};
+            const int64_t nStartHeight{request.params[1].isNull() ? 0 : request.params[1].getInt<int64_t>()};
+            const int64_t nCount{request.params[2].isNull() ? std::numeric_limits<int64_t>::max() : request.params[2].getInt<int64_t>()};
+            if (verbosity < 0 || verbosity > 2) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Verbosity must be 0, 1 or 2");
+            }
+            if (nStartHeight < 0) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Negative start height");
+            }
+            if (nCount < 1) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Count must be positive");
+            }
 
-                UniValue blockDetails(UniValue::VOBJ); 
-                UniValue txs(UniValue::VARR);
-                for (size_t i = 0; i < block.vtx.size(); ++i) {
-                    const CTransactionRef& tx = block.vtx.at(i);
-                    UniValue objTx(UniValue::VOBJ);
-                    TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true);
-                    txs.push_back(objTx);
+            // Only the requested page is copied, the JSON is built without holding cs_main
+            const std::vector<SignedBlockRef> finalizedBlocks = WITH_LOCK(cs_main, return getFinalizedSignedBlocks(nStartHeight, std::min<uint64_t>(nCount, std::numeric_limits<size_t>::max())));
+            UniValue result(UniValue::VARR);
+            for (const SignedBlockRef& block : finalizedBlocks) {
+                if (verbosity == 0) {
+                    result.push_back(block->GetHash().GetHex());
+                } else {
+                    result.push_back(signedBlockToJSON(*block, /*txDetails=*/verbosity > 1));
                 }
-
-                blockDetails.pushKV("fee", block.currentFee);
-                blockDetails.pushKV("blockindex", (uint64_t)block.blockIndex);
-                blockDetails.pushKV("height", (uint64_t)block.nHeight);
-                blockDetails.pushKV("time", block.nTime);
-                blockDetails.pushKV("size", blockSize);
-                blockDetails.pushKV("previousblock", block.hashPrevSignedBlock.ToString());
-                blockDetails.pushKV("merkleroot", block.hashMerkleRoot.ToString());
-                blockDetails.pushKV("hash", block.GetHash().ToString());
-                blockDetails.pushKV("tx", txs);
-
-                result.push_back(blockDetails); 
             }
 
             return result;
@@ -410,6 +560,7 @@ static RPCHelpMan getpreconftxrefund() {
             chainman.ActiveChainstate().UpdatedCoinsTip(view,chainman.ActiveChainstate().m_chain.Height());
 
 
+            const std::vector<SignedBlockRef> finalizedBlocks = getFinalizedSignedBlocks();
             UniValue result(UniValue::VARR);  
             for (unsigned int idx = 0; idx < req_params.size(); idx++) {
                 const UniValue& params = req_params[idx].get_obj();
@@ -419,12 +570,11 @@ static RPCHelpMan getpreconftxrefund() {
                 CAmount refund = CAmount(0);
                 uint256 hash = ParseHashV(params.find_value("tx"), "parameter 1");
                 CTransactionRef mined_tx;
-                std::vector<SignedBlock> finalizedBlocks= getFinalizedSignedBlocks();
-                for (SignedBlock finalizedSignedBlock : finalizedBlocks) {
-                    for (const auto& tx : finalizedSignedBlock.vtx) {
+                for (const SignedBlockRef& finalizedSignedBlock : finalizedBlocks) {
+                    for (const auto& tx : finalizedSignedBlock->vtx) {
                         if (tx->GetHash() == hash) {
                             mined_tx =  tx;
-                            refund = getRefundForPreconfCurrentTx(*mined_tx,finalizedSignedBlock.currentFee,view);
+                            refund = getRefundForPreconfCurrentTx(*mined_tx,finalizedSignedBlock->currentFee,view);
                             break;
                         }
                     }
@@ -456,6 +606,175 @@ static RPCHelpMan getpreconftxrefund() {
     };
 }
 
+static std::vector<XOnlyPubKey> ParseFederationKeysV(const UniValue& v)
+{
+    std::vector<XOnlyPubKey> keys;
+    if (!IsHex(v.get_str()) || !parseFederationKeys(v.get_str(), /*allowCompact=*/true, keys) || keys.empty()) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid federation keys");
+    }
+    return keys;
+}
+
+static UniValue FederationWitnessResult(const std::vector<XOnlyPubKey>& keys, const std::string& witnessHex)
+{
+    std::string keysHex;
+    if (!encodeCompactFederationKeys(keys, keysHex)) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Too many federation keys for the compact encoding");
+    }
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("witness", witnessHex);
+    result.pushKV("keys", keysHex);
+    return result;
+}
+
+static const std::vector<RPCResult> FEDERATION_WITNESS_RESULT{
+    {RPCResult::Type::STR_HEX, "witness", "compact federation witness"},
+    {RPCResult::Type::STR_HEX, "keys", "the federation keys as compact key set"},
+};
+
+static RPCHelpMan getfederationwitnessmessage()
+{
+    return RPCHelpMan{
+        "getfederationwitnessmessage",
+        "\nReturns the canonical message federation members sign for a compact federation witness.\n"
+        "Pass the preconf list fields for preconf lists and signed blocks, or the mined block hash for precommitments.\n",
+        {
+            {"options", RPCArg::Type::OBJ, RPCArg::Optional::NO, "",
+                {
+                    {"txids", RPCArg::Type::ARR, RPCArg::Optional::OMITTED, "signed transaction ids in order, an empty string for the federation witness entry",
+                        {
+                            {"txid", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "transaction id"},
+                        },
+                    },
+                    {"signed_block_height", RPCArg::Type::NUM, RPCArg::Optional::OMITTED, "signed block height"},
+                    {"mined_block_height", RPCArg::Type::NUM, RPCArg::Optional::OMITTED, "mined block height the federation keys are taken from"},
+                    {"blockhash", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "mined block hash a precommitment refers to"},
+                },
+            },
+        },
+        RPCResult{
+            RPCResult::Type::STR_HEX, "", "the message hash to sign"},
+        RPCExamples{
+            HelpExampleCli("getfederationwitnessmessage", "\"{\\\"txids\\\":[\\\"\\\"],\\\"signed_block_height\\\":5,\\\"mined_block_height\\\":2}\"")
+            + HelpExampleRpc("getfederationwitnessmessage", "{\"blockhash\":\"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09\"}")},
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
+            const UniValue& options = request.params[0].get_obj();
+            RPCTypeCheckObj(options,
+                            {
+                                {"txids", UniValueType(UniValue::VARR)},
+                                {"signed_block_height", UniValueType(UniValue::VNUM)},
+                                {"mined_block_height", UniValueType(UniValue::VNUM)},
+                                {"blockhash", UniValueType(UniValue::VSTR)},
+                            },
+                            /*fAllowNull=*/true, /*fStrict=*/true);
+            if (!options["blockhash"].isNull()) {
+                if (!options["txids"].isNull() || !options["signed_block_height"].isNull() || !options["mined_block_height"].isNull()) {
+                    throw JSONRPCError(RPC_INVALID_PARAMETER, "blockhash cannot be combined with preconf list fields");
+                }
+                return prepareCommitmentMessageHash(ParseHashV(options["blockhash"], "blockhash")).GetHex();
+            }
+            if (options["txids"].isNull() || options["signed_block_height"].isNull() || options["mined_block_height"].isNull()) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "txids, signed_block_height and mined_block_height are required for preconf lists");
+            }
+            std::vector<uint256> txids;
+            for (const UniValue& txid : options["txids"].getValues()) {
+                txids.push_back(txid.get_str().empty() ? uint256::ZERO : ParseHashV(txid, "txid"));
+            }
+            return preparePreconfMessageHash(txids, options["signed_block_height"].getInt<int64_t>(), options["mined_block_height"].getInt<int64_t>()).GetHex();
+        },
+    };
+}
+
+static RPCHelpMan createfederationwitness()
+{
+    return RPCHelpMan{
+        "createfederationwitness",
+        "\nAssemble a compact federation witness from the signatures of federation members over the canonical message.\n",
+        {
+            {"keys", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "federation keys in either encoding"},
+            {"signatures", RPCArg::Type::ARR, RPCArg::Optional::NO, "",
+                {
+                    {"", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "",
+                        {
+                            {"pubkey", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "x-only or compressed public key of the federation member"},
+                            {"signature", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "64 byte schnorr signature of the message"},
+                        },
+                    },
+                },
+            },
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "", FEDERATION_WITNESS_RESULT},
+        RPCExamples{
+            HelpExampleCli("createfederationwitness", "\"keys\" \"[{\\\"pubkey\\\":\\\"key\\\",\\\"signature\\\":\\\"sig\\\"}]\"")},
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
+            const std::vector<XOnlyPubKey> keys = ParseFederationKeysV(request.params[0]);
+            std::map<XOnlyPubKey, std::vector<unsigned char>> signatures;
+            for (const UniValue& entry : request.params[1].get_array().getValues()) {
+                RPCTypeCheckObj(entry,
+                                {
+                                    {"pubkey", UniValueType(UniValue::VSTR)},
+                                    {"signature", UniValueType(UniValue::VSTR)},
+                                });
+                const std::vector<unsigned char> pubkey = ParseHexV(entry["pubkey"], "pubkey");
+                XOnlyPubKey key;
+                if (pubkey.size() == XOnlyPubKey::size() && XOnlyPubKey{pubkey}.IsFullyValid()) {
+                    key = XOnlyPubKey{pubkey};
+                } else if (const CPubKey full{pubkey}; full.IsFullyValid() && full.IsCompressed()) {
+                    key = XOnlyPubKey{full};
+                } else {
+                    throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid pubkey");
+                }
+                if (!signatures.emplace(key, ParseHexV(entry["signature"], "signature")).second) {
+                    throw JSONRPCError(RPC_INVALID_PARAMETER, "Duplicate signature for pubkey");
+                }
+            }
+            std::string witnessHex;
+            if (!encodeCompactAnduroWitness(keys, signatures, witnessHex)) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Signatures must be 64 bytes and belong to federation keys");
+            }
+            return FederationWitnessResult(keys, witnessHex);
+        },
+    };
+}
+
+static RPCHelpMan signfederationwitnesswithkey()
+{
+    return RPCHelpMan{
+        "signfederationwitnesswithkey",
+        "\nSign the canonical message with the private keys of federation members and assemble a compact federation witness.\n",
+        {
+            {"keys", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "federation keys in either encoding"},
+            {"message", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "the message hash from getfederationwitnessmessage"},
+            {"privkeys", RPCArg::Type::ARR, RPCArg::Optional::NO, "base58-encoded private keys of the signing federation members",
+                {
+                    {"privatekey", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "private key in base58-encoding"},
+                },
+            },
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "", FEDERATION_WITNESS_RESULT},
+        RPCExamples{
+            HelpExampleCli("signfederationwitnesswithkey", "\"keys\" \"message\" \"[\\\"key1\\\",\\\"key2\\\"]\"")},
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue {
+            const std::vector<XOnlyPubKey> keys = ParseFederationKeysV(request.params[0]);
+            const uint256 message = ParseHashV(request.params[1], "message");
+            std::vector<CKey> signers;
+            for (const UniValue& privkey : request.params[2].get_array().getValues()) {
+                CKey key = DecodeSecret(privkey.get_str());
+                if (!key.IsValid()) {
+                    throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid private key");
+                }
+                signers.push_back(std::move(key));
+            }
+            std::string witnessHex;
+            if (!signCompactAnduroWitness(keys, signers, message, witnessHex)) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Private keys must belong to distinct federation keys");
+            }
+            return FederationWitnessResult(keys, witnessHex);
+        },
+    };
+}
 
 void RegisterPreConfMempoolRPCCommands(CRPCTable& t)
 {
@@ -463,10 +782,14 @@ void RegisterPreConfMempoolRPCCommands(CRPCTable& t)
         {"preconf", &sendpreconftransaction},
         {"preconf", &sendpreconflist},
         {"preconf", &getpreconffee},
+        {"preconf", &estimatepreconffee},
         {"preconf", &getpreconflist},
         {"preconf", &getfinalizedsignedblocks},
         {"preconf", &getsignedblockcount},
-        {"preconf", &getpreconftxrefund}
+        {"preconf", &getpreconftxrefund},
+        {"preconf", &getfederationwitnessmessage},
+        {"preconf", &createfederationwitness},
+        {"preconf", &signfederationwitnesswithkey},
     };
     for (const auto& c : commands) {
         t.appendCommand(c.name, &c);
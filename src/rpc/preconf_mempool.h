@@ -5,6 +5,10 @@
 #ifndef BITCOIN_RPC_PRECONFMEMPOOLRPC_H
 #define BITCOIN_RPC_PRECONFMEMPOOLRPC_H
 
+class SignedBlock;
 class UniValue;
 
+/** Signed block description to JSON, with decoded transactions or only their ids */
+UniValue signedBlockToJSON(const SignedBlock& block, bool txDetails = true);
+
 #endif // BITCOIN_RPC_PRECONFMEMPOOLRPC_H
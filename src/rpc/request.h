@@ -7,6 +7,7 @@
 #define BITCOIN_RPC_REQUEST_H
 
 #include <any>
+#include <functional>
 #include <optional>
 #include <string>
 
@@ -49,6 +50,9 @@ void DeleteAuthCookie();
 /** Parse JSON-RPC batch reply into a vector */
 std::vector<UniValue> JSONRPCProcessBatchReply(const UniValue& in);
 
+/** Writes an RPC result incrementally, in place of a result tree */
+using JSONRPCResultWriter = std::function<void(UniValueWriter&)>;
+
 class JSONRPCRequest
 {
 public:
@@ -62,6 +66,11 @@ public:
     std::any context;
     std::any context2;
     JSONRPCVersion m_json_version = JSONRPCVersion::V1_LEGACY;
+    /** Set when the reply to this request is written incrementally. Handlers of
+     * large results may then store a writer for the result here and return a
+     * null value. The writer cannot report errors, so everything that can fail
+     * must be done before it is stored. */
+    JSONRPCResultWriter* m_result_writer{nullptr};
 
     void parse(const UniValue& valRequest);
     [[nodiscard]] bool IsNotification() const { return !id.has_value() && m_json_version == JSONRPCVersion::V2; };
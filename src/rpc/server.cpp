@@ -22,8 +22,10 @@
 #include <validation.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -42,10 +44,31 @@ struct RPCCommandExecutionInfo
     SteadyClock::time_point start;
 };
 
+/** Upper bounds of the buckets of the per-method latency histogram, the last
+ * bucket holds all calls that took longer. */
+static constexpr std::array<std::chrono::microseconds, 6> RPC_LATENCY_BUCKETS{
+    1ms, 10ms, 100ms, 1s, 10s, 60s,
+};
+
+struct RPCMethodLatency
+{
+    uint64_t count{0};
+    std::chrono::microseconds total{0};
+    std::array<uint64_t, RPC_LATENCY_BUCKETS.size() + 1> buckets{};
+
+    void Add(std::chrono::microseconds duration)
+    {
+        ++count;
+        total += duration;
+        ++buckets[std::ranges::lower_bound(RPC_LATENCY_BUCKETS, duration) - RPC_LATENCY_BUCKETS.begin()];
+    }
+};
+
 struct RPCServerInfo
 {
     Mutex mutex;
     std::list<RPCCommandExecutionInfo> active_commands GUARDED_BY(mutex);
+    std::map<std::string, RPCMethodLatency> method_latency GUARDED_BY(mutex);
 };
 
 static RPCServerInfo g_rpc_server_info;
@@ -60,7 +83,9 @@ struct RPCCommandExecution
     }
     ~RPCCommandExecution()
     {
+        const auto duration{std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - it->start)};
         LOCK(g_rpc_server_info.mutex);
+        g_rpc_server_info.method_latency[it->method].Add(duration);
         g_rpc_server_info.active_commands.erase(it);
     }
 };
@@ -209,6 +234,22 @@ static RPCHelpMan getrpcinfo()
                             }},
                         }},
                         {RPCResult::Type::STR, "logpath", "The complete file path to the debug log"},
+                        {RPCResult::Type::OBJ_DYN, "method_latency", "Latency of the completed calls of each RPC command since startup",
+                        {
+                            {RPCResult::Type::OBJ, "method", "The name of the RPC command",
+                            {
+                                {RPCResult::Type::NUM, "count", "The number of completed calls"},
+                                {RPCResult::Type::NUM, "total", "The total running time of the completed calls in microseconds"},
+                                {RPCResult::Type::ARR, "histogram", "The number of calls per latency bucket",
+                                {
+                                    {RPCResult::Type::OBJ, "", "",
+                                    {
+                                        {RPCResult::Type::NUM, "le", /*optional=*/true, "The upper bound of the bucket in microseconds, omitted for the last bucket"},
+                                        {RPCResult::Type::NUM, "count", "The number of calls in the bucket"},
+                                    }},
+                                }},
+                            }},
+                        }},
                     }
                 },
                 RPCExamples{
@@ -232,6 +273,23 @@ static RPCHelpMan getrpcinfo()
     UniValue log_path(UniValue::VSTR, path);
     result.pushKV("logpath", std::move(log_path));
 
+    UniValue method_latency(UniValue::VOBJ);
+    for (const auto& [method, latency] : g_rpc_server_info.method_latency) {
+        UniValue histogram(UniValue::VARR);
+        for (size_t i{0}; i < latency.buckets.size(); ++i) {
+            UniValue bucket(UniValue::VOBJ);
+            if (i < RPC_LATENCY_BUCKETS.size()) bucket.pushKV("le", int64_t{Ticks<std::chrono::microseconds>(RPC_LATENCY_BUCKETS[i])});
+            bucket.pushKV("count", latency.buckets[i]);
+            histogram.push_back(std::move(bucket));
+        }
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("count", latency.count);
+        entry.pushKV("total", int64_t{Ticks<std::chrono::microseconds>(latency.total)});
+        entry.pushKV("histogram", std::move(histogram));
+        method_latency.pushKV(method, std::move(entry));
+    }
+    result.pushKV("method_latency", std::move(method_latency));
+
     return result;
 }
     };
@@ -673,9 +673,20 @@ UniValue RPCHelpMan::HandleRequest(const JSONRPCRequest& request) const
     UniValue ret = m_fun(*this, request);
     m_req = nullptr;
     if (gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
+        // Check a result written incrementally in the form the client receives
+        const UniValue* result{&ret};
+        UniValue written;
+        if (request.m_result_writer && *request.m_result_writer) {
+            std::string json;
+            UniValueWriter writer{[&](std::string_view chunk) { json.append(chunk); }};
+            (*request.m_result_writer)(writer);
+            writer.flush();
+            CHECK_NONFATAL(written.read(json));
+            result = &written;
+        }
         UniValue mismatch{UniValue::VARR};
         for (const auto& res : m_results.m_results) {
-            UniValue match{res.MatchesType(ret)};
+            UniValue match{res.MatchesType(*result)};
             if (match.isTrue()) {
                 mismatch.setNull();
                 break;
@@ -6,6 +6,7 @@
 #include <script/signingprovider.h>
 #include <consensus/validation.h>
 #include <validation.h>
+#include <checkqueue.h>
 #include <txmempool.h>
 #include <policy/policy.h>
 #include <node/miner.h>
@@ -326,4 +327,69 @@ BOOST_FIXTURE_TEST_CASE(multiple_asset_types_in_block, TestChain100Setup) {
     BOOST_CHECK(m_node.chainman->ActiveChain().Tip()->GetBlockHash() == block.GetHash());
 }
 
+BOOST_AUTO_TEST_CASE(asset_rules_use_spent_coins_only)
+{
+    const std::vector<unsigned char> asset_a{'0', '0', '0', '0', '0', '1', '0', '1', '0', '0', '1'};
+    const std::vector<unsigned char> asset_b{'0', '0', '0', '0', '0', '1', '0', '1', '0', '0', '2'};
+    auto asset_coin = [](CAmount value, const std::vector<unsigned char>& id, bool control = false) {
+        return Coin(CTxOut(value, CScript() << OP_TRUE), 1, false, !control, control, false, false, id);
+    };
+
+    CMutableTransaction mtx;
+    mtx.version = TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION;
+    mtx.vin.resize(2);
+    mtx.vout.emplace_back(30, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(20, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(1000, CScript() << OP_TRUE);
+    const CTransaction tx{mtx};
+    std::string reason;
+
+    BOOST_CHECK(CheckCoordinateAssetRules(tx, {asset_coin(40, asset_a), asset_coin(10, asset_a)}, reason));
+
+    BOOST_CHECK(!CheckCoordinateAssetRules(tx, {asset_coin(40, asset_a), asset_coin(10, asset_b)}, reason));
+    BOOST_CHECK_EQUAL(reason, "bad-txns-asset-multiple");
+
+    BOOST_CHECK(!CheckCoordinateAssetRules(tx, {asset_coin(40, asset_a), asset_coin(5, asset_a)}, reason));
+    BOOST_CHECK_EQUAL(reason, "bad-txns-asset-outputs-mismatch");
+
+    BOOST_CHECK(!CheckCoordinateAssetRules(tx, {asset_coin(40, asset_a), asset_coin(1, asset_a, /*control=*/true)}, reason));
+    BOOST_CHECK_EQUAL(reason, "bad-txns-asset-controller-spent");
+
+    mtx.version = 2;
+    BOOST_CHECK(!CheckCoordinateAssetRules(CTransaction{mtx}, {asset_coin(40, asset_a), asset_coin(10, asset_a)}, reason));
+    BOOST_CHECK_EQUAL(reason, "bad-txns-asset-in-standard-tx");
+}
+
+BOOST_AUTO_TEST_CASE(asset_rule_failures_from_check_queue)
+{
+    const std::vector<unsigned char> asset_a{'0', '0', '0', '0', '0', '1', '0', '1', '0', '0', '1'};
+    const std::vector<unsigned char> asset_b{'0', '0', '0', '0', '0', '1', '0', '1', '0', '0', '2'};
+    auto asset_coin = [](CAmount value, const std::vector<unsigned char>& id) {
+        return Coin(CTxOut(value, CScript() << OP_TRUE), 1, false, true, false, false, false, id);
+    };
+
+    CMutableTransaction mtx;
+    mtx.version = TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION;
+    mtx.vin.resize(2);
+    mtx.vout.emplace_back(30, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(20, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(1000, CScript() << OP_TRUE);
+    const CTransaction tx{mtx};
+
+    // asset rule failures keep their result type and reject reason when run by the check queue workers
+    CCheckQueue<CBlockCheck> queue{/*batch_size=*/128, /*worker_threads_num=*/2};
+    CCheckQueueControl<CBlockCheck> control{queue};
+    std::vector<CBlockCheck> checks;
+    checks.emplace_back(CAssetCheck{tx, {asset_coin(40, asset_a), asset_coin(10, asset_b)}});
+    control.Add(std::move(checks));
+    const auto failure{control.Complete()};
+    BOOST_REQUIRE(failure);
+    BOOST_CHECK(failure->result == BlockValidationResult::BLOCK_CACHED_INVALID);
+    BOOST_CHECK_EQUAL(failure->reject_reason, "ConnectBlock(): Invalid transaction standard");
+    BOOST_CHECK_EQUAL(failure->debug_message, strprintf("bad-txns-asset-multiple in %s", tx.GetHash().ToString()));
+
+    CBlockCheck valid{CAssetCheck{tx, {asset_coin(40, asset_a), asset_coin(10, asset_a)}}};
+    BOOST_CHECK(!valid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,196 @@
+// Copyright (c) 2017-2022 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <consensus/validation.h>
+#include <coordinate/anduro_validator.h>
+#include <coordinate/coordinate_assets.h>
+#include <index/assetindex.h>
+#include <interfaces/chain.h>
+#include <script/sign.h>
+#include <script/signingprovider.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+/** Sign every input of tx, all of them spending outputs of prev_tx held by key. */
+void SignInputs(CMutableTransaction& tx, const CKey& key, const CTransaction& prev_tx)
+{
+    FillableSigningProvider keystore;
+    BOOST_REQUIRE(keystore.AddKey(key));
+    for (size_t i = 0; i < tx.vin.size(); i++) {
+        const CTxOut& prevout = prev_tx.vout[tx.vin[i].prevout.n];
+        SignatureData sigdata = DataFromTransaction(tx, i, prevout);
+        BOOST_REQUIRE(ProduceSignature(keystore, MutableTransactionSignatureCreator(tx, i, prevout.nValue, SIGHASH_ALL), prevout.scriptPubKey, sigdata));
+        UpdateInput(tx.vin[i], sigdata);
+    }
+}
+
+/** Token creation spending the first output of funding_tx: controller, supply and change to script. */
+CMutableTransaction CreateTokenTransaction(const CTransaction& funding_tx, const CScript& script, CAmount supply)
+{
+    CMutableTransaction tx;
+    tx.version = TRANSACTION_COORDINATE_ASSET_CREATE_VERSION;
+    tx.payloadData = "4444444444444444444444444444444444444444444444444444444444444444";
+    tx.payload = prepareMessageHash(tx.payloadData);
+    tx.ticker = "IDX";
+    tx.headline = "Asset index token";
+    tx.assetType = 0;
+    tx.precision = 8;
+    tx.vin.emplace_back(funding_tx.GetHash(), 0);
+    tx.vout.emplace_back(1, script);
+    tx.vout.emplace_back(supply, script);
+    tx.vout.emplace_back(funding_tx.vout[0].nValue - supply - 1 - 1000, script);
+    return tx;
+}
+
+CAmount SumCoins(const std::vector<std::pair<COutPoint, AssetIndexCoin>>& coins, bool control)
+{
+    CAmount total{0};
+    for (const auto& [outpoint, coin] : coins) {
+        if (coin.fControl == control) total += coin.nValue;
+    }
+    return total;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(assetindex_tests)
+
+BOOST_FIXTURE_TEST_CASE(assetindex_initial_sync, TestChain100Setup)
+{
+    AssetIndex assetindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(assetindex.Init());
+
+    // BlockUntilSyncedToCurrentChain should return false before assetindex is started.
+    BOOST_CHECK(!assetindex.BlockUntilSyncedToCurrentChain());
+
+    assetindex.Sync();
+
+    // Plain coinbase outputs never carry an asset.
+    const std::vector<unsigned char> asset_id{CreateAssetId(1, 1)};
+    std::vector<std::pair<COutPoint, AssetIndexCoin>> coins;
+    AssetIndexSupply supply;
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, std::nullopt, coins));
+    BOOST_CHECK(coins.empty());
+    BOOST_CHECK(assetindex.LookUpSupply(asset_id, supply));
+    BOOST_CHECK_EQUAL(supply.nAmount, 0);
+    BOOST_CHECK_EQUAL(supply.nOutputs, 0U);
+
+    // New blocks keep the index in sync.
+    for (int i = 0; i < 10; i++) {
+        CScript coinbase_script_pub_key = GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()));
+        std::vector<CMutableTransaction> no_txns;
+        CreateAndProcessBlock(no_txns, coinbase_script_pub_key);
+        BOOST_CHECK(assetindex.BlockUntilSyncedToCurrentChain());
+    }
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, GetScriptForDestination(PKHash(coinbaseKey.GetPubKey())), coins));
+    BOOST_CHECK(coins.empty());
+
+    // It is not safe to stop and destroy the index until it finishes handling
+    // the last BlockConnected notification.
+    m_node.validation_signals->SyncWithValidationInterfaceQueue();
+
+    // shutdown sequence (c.f. Shutdown() in init.cpp)
+    assetindex.Stop();
+}
+
+BOOST_FIXTURE_TEST_CASE(assetindex_create_transfer_reorg, TestChain100Setup)
+{
+    AssetIndex assetindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(assetindex.Init());
+    BOOST_REQUIRE(assetindex.StartBackgroundSync());
+
+    const CScript owner_script{GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()))};
+    CKey other_key = GenerateRandomKey();
+    const CScript other_script{GetScriptForDestination(PKHash(other_key.GetPubKey()))};
+    const CScript coinbase_script{GetScriptForRawPubKey(coinbaseKey.GetPubKey())};
+
+    // Create a token, outputs 0 and 1 are its controller and supply.
+    const CTransactionRef funding_tx{MinePegin(owner_script, 1 * COIN)};
+    CMutableTransaction create_tx = CreateTokenTransaction(*funding_tx, owner_script, 10000);
+    SignInputs(create_tx, coinbaseKey, *funding_tx);
+    const CBlock create_block = CreateAndProcessBlock({create_tx}, coinbase_script);
+    BOOST_REQUIRE_EQUAL(m_node.chainman->ActiveChain().Tip()->GetBlockHash(), create_block.GetHash());
+    BOOST_REQUIRE(assetindex.BlockUntilSyncedToCurrentChain());
+
+    const int create_height{WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Height())};
+    const std::vector<unsigned char> asset_id{CreateAssetId(create_height, 1)};
+    std::vector<std::pair<COutPoint, AssetIndexCoin>> coins;
+    AssetIndexSupply supply;
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, std::nullopt, coins));
+    BOOST_CHECK_EQUAL(coins.size(), 2U);
+    BOOST_CHECK_EQUAL(SumCoins(coins, /*control=*/false), 10000);
+    BOOST_CHECK_EQUAL(SumCoins(coins, /*control=*/true), 1);
+    for (const auto& [outpoint, coin] : coins) {
+        BOOST_CHECK(coin.nAssetID == asset_id);
+        BOOST_CHECK(coin.scriptPubKey == owner_script);
+        BOOST_CHECK_EQUAL(coin.nHeight, uint32_t(create_height));
+        BOOST_CHECK_EQUAL(coin.fControl, outpoint.n == 0);
+    }
+    BOOST_CHECK(assetindex.LookUpSupply(asset_id, supply));
+    BOOST_CHECK_EQUAL(supply.nAmount, 10000);
+    BOOST_CHECK_EQUAL(supply.nOutputs, 2U);
+
+    // Transfer part of the supply, both outputs keep the asset.
+    CMutableTransaction transfer_tx;
+    transfer_tx.version = TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION;
+    transfer_tx.vin.emplace_back(COutPoint{create_tx.GetHash(), 1, asset_id});
+    transfer_tx.vout.emplace_back(6000, other_script);
+    transfer_tx.vout.emplace_back(4000, owner_script);
+    SignInputs(transfer_tx, coinbaseKey, CTransaction{create_tx});
+    const CBlock transfer_block = CreateAndProcessBlock({transfer_tx}, coinbase_script);
+    BOOST_REQUIRE_EQUAL(m_node.chainman->ActiveChain().Tip()->GetBlockHash(), transfer_block.GetHash());
+    BOOST_REQUIRE(assetindex.BlockUntilSyncedToCurrentChain());
+
+    coins.clear();
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, other_script, coins));
+    BOOST_REQUIRE_EQUAL(coins.size(), 1U);
+    BOOST_CHECK(coins[0].first == COutPoint(transfer_tx.GetHash(), 0));
+    BOOST_CHECK_EQUAL(coins[0].second.nValue, 6000);
+    coins.clear();
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, owner_script, coins));
+    BOOST_CHECK_EQUAL(coins.size(), 2U);
+    BOOST_CHECK_EQUAL(SumCoins(coins, /*control=*/false), 4000);
+    BOOST_CHECK(assetindex.LookUpSupply(asset_id, supply));
+    BOOST_CHECK_EQUAL(supply.nAmount, 10000);
+    BOOST_CHECK_EQUAL(supply.nOutputs, 3U);
+
+    // Disconnecting the transfer restores the spent supply output. The index
+    // rewinds once a block is connected on the new chain.
+    BlockValidationState state;
+    CBlockIndex* transfer_index{WITH_LOCK(cs_main, return m_node.chainman->m_blockman.LookupBlockIndex(transfer_block.GetHash()))};
+    BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, transfer_index));
+    CreateAndProcessBlock({}, coinbase_script);
+    BOOST_REQUIRE(assetindex.BlockUntilSyncedToCurrentChain());
+    coins.clear();
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, other_script, coins));
+    BOOST_CHECK(coins.empty());
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, owner_script, coins));
+    BOOST_CHECK_EQUAL(coins.size(), 2U);
+    BOOST_CHECK_EQUAL(SumCoins(coins, /*control=*/false), 10000);
+    BOOST_CHECK(assetindex.LookUpSupply(asset_id, supply));
+    BOOST_CHECK_EQUAL(supply.nAmount, 10000);
+    BOOST_CHECK_EQUAL(supply.nOutputs, 2U);
+
+    // Disconnecting the creation removes the asset altogether.
+    CBlockIndex* create_index{WITH_LOCK(cs_main, return m_node.chainman->m_blockman.LookupBlockIndex(create_block.GetHash()))};
+    BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, create_index));
+    CreateAndProcessBlock({}, coinbase_script);
+    BOOST_REQUIRE(assetindex.BlockUntilSyncedToCurrentChain());
+    coins.clear();
+    BOOST_CHECK(assetindex.FindAssetCoins(asset_id, std::nullopt, coins));
+    BOOST_CHECK(coins.empty());
+    BOOST_CHECK(assetindex.LookUpSupply(asset_id, supply));
+    BOOST_CHECK_EQUAL(supply.nAmount, 0);
+    BOOST_CHECK_EQUAL(supply.nOutputs, 0U);
+
+    m_node.validation_signals->SyncWithValidationInterfaceQueue();
+    assetindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,14 +2,18 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <auxpow.h>
 #include <chain.h>
 #include <chainparams.h>
 #include <clientversion.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <node/kernel_notifications.h>
+#include <pow.h>
 #include <script/solver.h>
 #include <primitives/block.h>
+#include <undo.h>
+#include <util/byte_units.h>
 #include <util/chaintype.h>
 #include <validation.h>
 
@@ -21,6 +25,14 @@ using node::STORAGE_HEADER_BYTES;
 using node::BlockManager;
 using node::KernelNotifications;
 using node::MAX_BLOCKFILE_SIZE;
+using node::MAX_BLOCK_UNDO_CACHE_ENTRIES;
+
+/** Reaches into CAuxPow for the hash of the parent chain coinbase */
+class CAuxPowForTest
+{
+public:
+    static uint256 CoinbaseHash(const CAuxPow& auxpow) { return auxpow.coinbaseTx->GetHash().ToUint256(); }
+};
 
 // use BasicTestingSetup here for the data directory configuration, setup, and cleanup
 BOOST_FIXTURE_TEST_SUITE(blockmanager_tests, BasicTestingSetup)
@@ -147,6 +159,44 @@ BOOST_FIXTURE_TEST_CASE(blockmanager_readblock_hash_mismatch, TestingSetup)
     BOOST_CHECK(!m_node.chainman->m_blockman.ReadBlock(dummy, *fake_index));
 }
 
+BOOST_FIXTURE_TEST_CASE(blockmanager_block_undo_cache, TestChain100Setup)
+{
+    const auto& chainman = Assert(m_node.chainman);
+    auto& blockman = chainman->m_blockman;
+
+    // Spend a peg-in so that the tip has undo data for a transaction
+    const CScript p2pk{CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    const CTransactionRef pegin{MinePegin(p2pk, 1 * COIN)};
+    const CAmount amount{pegin->vout[0].nValue};
+    const auto [spend, fee]{CreateValidTransaction({pegin}, {COutPoint{pegin->GetHash(), 0}}, /*input_height=*/0, {coinbaseKey},
+                                                   {CTxOut{amount / 2, p2pk}, CTxOut{amount / 4, p2pk}}, /*feerate=*/std::nullopt, /*fee_output=*/std::nullopt)};
+    CreateAndProcessBlock({spend}, p2pk);
+    const CBlockIndex* tip{WITH_LOCK(chainman->GetMutex(), return chainman->ActiveChain().Tip())};
+
+    // Reading the undo data again is served from memory
+    const auto undo{blockman.GetBlockUndo(*tip)};
+    BOOST_REQUIRE(undo);
+    BOOST_CHECK_EQUAL(undo->vtxundo.size(), 1U);
+    BOOST_CHECK(blockman.GetBlockUndo(*tip) == undo);
+    CBlockUndo from_disk;
+    BOOST_CHECK(blockman.ReadBlockUndo(from_disk, *tip));
+    BOOST_CHECK_EQUAL(undo->vtxundo.size(), from_disk.vtxundo.size());
+
+    // Once uncached, it is read from disk again
+    BOOST_CHECK(blockman.UncacheBlockUndo(tip->GetBlockHash()) == undo);
+    BOOST_CHECK(!blockman.UncacheBlockUndo(tip->GetBlockHash()));
+    const auto reread{blockman.GetBlockUndo(*tip)};
+    BOOST_CHECK(reread && reread != undo);
+
+    // Only the most recently used entries are kept
+    const CBlockIndex* index{tip};
+    for (size_t i = 0; i < MAX_BLOCK_UNDO_CACHE_ENTRIES; ++i) {
+        index = index->pprev;
+        BOOST_CHECK(blockman.GetBlockUndo(*index));
+    }
+    BOOST_CHECK(!blockman.UncacheBlockUndo(tip->GetBlockHash()));
+}
+
 BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
 {
     KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
@@ -216,4 +266,152 @@ BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
     BOOST_CHECK_EQUAL(read_block.nVersion, 2);
 }
 
+BOOST_AUTO_TEST_CASE(blockmanager_read_mapped_block)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .use_mmap = true,
+        .fast_prune = true,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    const CBlock& genesis{Params().GenesisBlock()};
+    DataStream expected;
+    expected << TX_WITH_WITNESS(genesis);
+
+    // Fill the first (64 KiB with fast_prune) block file, so it is no longer written to
+    const FlatFilePos first_pos{blockman.WriteBlock(genesis, /*nHeight=*/0)};
+    FlatFilePos last_pos{first_pos};
+    while (last_pos.nFile == first_pos.nFile) {
+        last_pos = blockman.WriteBlock(genesis, /*nHeight=*/0);
+    }
+
+    // The block file that is still written to is not mapped
+    BOOST_CHECK(!blockman.ReadMappedBlock(last_pos));
+
+    const auto mapped{blockman.ReadMappedBlock(first_pos)};
+    BOOST_REQUIRE(mapped);
+    BOOST_CHECK_EQUAL(mapped->Size(), expected.size());
+    std::vector<std::byte> block_data(mapped->Size());
+    mapped->CopyTo(block_data);
+    BOOST_CHECK(std::ranges::equal(block_data, expected));
+    // A fresh blocksdir is obfuscated, so the mapped data differs from the block
+    BOOST_CHECK(mapped->IsObfuscated());
+    BOOST_CHECK(!std::ranges::equal(mapped->Data(), expected));
+
+    // The other read functions use the mapped file too
+    block_data.clear();
+    BOOST_CHECK(blockman.ReadRawBlock(block_data, first_pos));
+    BOOST_CHECK(std::ranges::equal(block_data, expected));
+    CBlock read_block;
+    BOOST_CHECK(blockman.ReadBlock(read_block, first_pos, genesis.GetHash()));
+
+    // Positions without a block in front of them are not served
+    BOOST_CHECK(!blockman.ReadMappedBlock({first_pos.nFile, first_pos.nPos + 1}));
+
+    // Pruning drops the mapping, but it stays valid for its current users
+    blockman.UnlinkPrunedFiles({first_pos.nFile});
+    BOOST_CHECK(!blockman.ReadMappedBlock(first_pos));
+    mapped->CopyTo(block_data);
+    BOOST_CHECK(std::ranges::equal(block_data, expected));
+}
+
+BOOST_AUTO_TEST_CASE(blockmanager_auxpow_cache)
+{
+    const auto params{CreateChainParams(ArgsManager{}, ChainType::REGTEST)};
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    const BlockManager::Options blockman_opts{
+        .chainparams = *params,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+            .memory_only = true,
+        },
+        .auxpow_cache_bytes = 1_MiB,
+    };
+
+    // a merge-mined block on top of genesis
+    CBlock block{params->GenesisBlock()};
+    block.hashPrevBlock = block.GetHash();
+    block.SetChainId(params->GetConsensus().nAuxpowChainId);
+    block.SetAuxpowVersion(true);
+    CPureBlockHeader& parent{CAuxPow::initAuxPow(block)};
+    // the parent block commits to the parent chain's coinbase, which is what CAuxPow::check hashes
+    parent.hashMerkleRoot = CAuxPowForTest::CoinbaseHash(*block.auxpow);
+    while (!CheckProofOfWork(parent.GetHash(), block.nBits, params->GetConsensus())) ++parent.nNonce;
+    const uint256 hash{block.GetHash()};
+    const std::shared_ptr<CAuxPow> auxpow{block.auxpow};
+    DataStream expected;
+    expected << TX_WITH_WITNESS(*auxpow);
+    const auto serialized = [](const CAuxPow& a) {
+        DataStream s;
+        s << TX_WITH_WITNESS(a);
+        return s;
+    };
+
+    {
+        BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+        LOCK(cs_main);
+        CBlockIndex* best_header{nullptr};
+        CBlockIndex* index{blockman.AddToBlockIndex(block, best_header)};
+        const FlatFilePos pos{blockman.WriteBlock(block, /*nHeight=*/1)};
+        index->nFile = pos.nFile;
+        index->nDataPos = pos.nPos;
+        index->nStatus |= BLOCK_HAVE_DATA;
+
+        // served from memory, and the same as the auxpow on disk
+        BOOST_CHECK_EQUAL(blockman.GetAuxpow(*index), auxpow);
+        CBlockHeader header;
+        BOOST_REQUIRE(blockman.ReadBlockHeader(header, *index));
+        BOOST_REQUIRE(header.auxpow);
+        BOOST_CHECK(std::ranges::equal(serialized(*header.auxpow), expected));
+        BOOST_CHECK(std::ranges::equal(serialized(*index->GetBlockHeader(blockman).auxpow), expected));
+        BOOST_CHECK(blockman.DumpAuxpowCache());
+    }
+
+    // after a restart, the cache is filled from the dump for headers in the block index
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+    LOCK(cs_main);
+    CBlockIndex* index{blockman.InsertBlockIndex(hash)};
+    index->nVersion = block.nVersion;
+    index->nBits = block.nBits;
+    blockman.LoadAuxpowCache();
+    // the index has no block data, so this can only come from memory
+    const auto loaded{blockman.GetAuxpow(*index)};
+    BOOST_REQUIRE(loaded);
+    BOOST_CHECK(std::ranges::equal(serialized(*loaded), expected));
+
+    // a cache too small for the auxpow keeps nothing
+    BlockManager::Options no_cache_opts{blockman_opts};
+    no_cache_opts.auxpow_cache_bytes = 0;
+    BlockManager no_cache{*Assert(m_node.shutdown_signal), no_cache_opts};
+    CBlockIndex* no_cache_index{no_cache.InsertBlockIndex(hash)};
+    no_cache_index->nVersion = block.nVersion;
+    no_cache_index->nBits = block.nBits;
+    no_cache.LoadAuxpowCache();
+    BOOST_CHECK(!no_cache.GetAuxpow(*no_cache_index));
+
+    // an auxpow filed under another header, e.g. in a stale or swapped file, is not served for it
+    const uint256 other_hash{m_rng.rand256()};
+    {
+        AutoFile file{fsbridge::fopen(m_args.GetBlocksDirPath() / "auxpowcache.dat", "wb")};
+        file << uint64_t{1} << uint64_t{1} << other_hash << TX_WITH_WITNESS(*auxpow);
+    }
+    BlockManager swapped{*Assert(m_node.shutdown_signal), blockman_opts};
+    CBlockIndex* other_index{swapped.InsertBlockIndex(other_hash)};
+    other_index->nVersion = block.nVersion;
+    other_index->nBits = block.nBits;
+    swapped.LoadAuxpowCache();
+    BOOST_CHECK(!swapped.GetAuxpow(*other_index));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
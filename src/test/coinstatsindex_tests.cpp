@@ -3,6 +3,10 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <common/args.h>
+#include <coordinate/coordinate_assets.h>
+#include <crypto/muhash.h>
+#include <dbwrapper.h>
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
 #include <kernel/coinstats.h>
@@ -14,6 +18,50 @@
 
 BOOST_AUTO_TEST_SUITE(coinstatsindex_tests)
 
+BOOST_AUTO_TEST_CASE(coinstatsindex_asset_coin_hash)
+{
+    const COutPoint outpoint{Txid::FromUint256(uint256::ONE), 1};
+    const CTxOut txout{5000, CScript() << OP_TRUE};
+    const std::vector<unsigned char> asset_id{CreateAssetId(100, 1)};
+
+    // Plain coins hash exactly as before assets were committed
+    const Coin plain{txout, 100, false};
+    DataStream ss{};
+    ss << outpoint << static_cast<uint32_t>((100 << 1) + 0) << txout;
+    MuHash3072 expected;
+    expected.Insert(MakeUCharSpan(ss));
+    MuHash3072 muhash;
+    kernel::ApplyCoinHash(muhash, outpoint, plain);
+    uint256 expected_hash, plain_hash;
+    expected.Finalize(expected_hash);
+    muhash.Finalize(plain_hash);
+    BOOST_CHECK_EQUAL(plain_hash, expected_hash);
+
+    // The asset state of a coin is part of its hash
+    auto coin_hash = [&](const Coin& coin) {
+        MuHash3072 h;
+        kernel::ApplyCoinHash(h, outpoint, coin);
+        uint256 out;
+        h.Finalize(out);
+        return out;
+    };
+    const uint256 asset_hash{coin_hash(Coin{txout, 100, false, /*fBitAssetIn=*/true, /*fBitAssetControlIn=*/false, false, false, asset_id})};
+    const uint256 control_hash{coin_hash(Coin{txout, 100, false, /*fBitAssetIn=*/true, /*fBitAssetControlIn=*/true, false, false, asset_id})};
+    const uint256 other_asset_hash{coin_hash(Coin{txout, 100, false, /*fBitAssetIn=*/true, /*fBitAssetControlIn=*/false, false, false, CreateAssetId(100, 2)})};
+    BOOST_CHECK(asset_hash != plain_hash);
+    BOOST_CHECK(control_hash != asset_hash);
+    BOOST_CHECK(other_asset_hash != asset_hash);
+
+    // Removing an asset coin undoes exactly its insertion
+    MuHash3072 roundtrip;
+    kernel::ApplyCoinHash(roundtrip, outpoint, plain);
+    kernel::ApplyCoinHash(roundtrip, outpoint, Coin{txout, 100, false, true, false, false, false, asset_id});
+    kernel::RemoveCoinHash(roundtrip, outpoint, Coin{txout, 100, false, true, false, false, false, asset_id});
+    uint256 roundtrip_hash;
+    roundtrip.Finalize(roundtrip_hash);
+    BOOST_CHECK_EQUAL(roundtrip_hash, plain_hash);
+}
+
 BOOST_FIXTURE_TEST_CASE(coinstatsindex_initial_sync, TestChain100Setup)
 {
     CoinStatsIndex coin_stats_index{interfaces::MakeChain(m_node), 1 << 20, true};
@@ -114,4 +162,46 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
     }
 }
 
+// An index written before the asset state was committed to the coin hashes
+// can't be extended, make sure it is rebuilt instead of being reused.
+BOOST_FIXTURE_TEST_CASE(coinstatsindex_rebuilds_old_version, TestChain100Setup)
+{
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip())};
+    std::optional<kernel::CCoinsStats> stats;
+    {
+        CoinStatsIndex index{interfaces::MakeChain(m_node), 1 << 20};
+        BOOST_REQUIRE(index.Init());
+        index.Sync();
+        stats = index.LookUpStats(*tip);
+        index.Stop();
+    }
+    BOOST_REQUIRE(stats);
+
+    {
+        // Drop the version the way an index built by an older release looks
+        CDBWrapper db{DBParams{.path = gArgs.GetDataDirNet() / "indexes" / "coinstats" / "db", .cache_bytes = 1 << 20}};
+        BOOST_REQUIRE(db.Exists(uint8_t{'B'}));
+        BOOST_REQUIRE(db.Erase(uint8_t{'V'}, /*fSync=*/true));
+    }
+
+    {
+        CoinStatsIndex index{interfaces::MakeChain(m_node), 1 << 20};
+        BOOST_CHECK(!index.LookUpStats(*tip));
+        BOOST_REQUIRE(index.Init());
+        BOOST_CHECK_EQUAL(index.GetSummary().best_block_height, 0);
+        index.Sync();
+        const auto rebuilt{index.LookUpStats(*tip)};
+        BOOST_REQUIRE(rebuilt);
+        BOOST_CHECK_EQUAL(rebuilt->hashSerialized, stats->hashSerialized);
+        BOOST_CHECK_EQUAL(rebuilt->nTransactionOutputs, stats->nTransactionOutputs);
+        index.Stop();
+    }
+
+    {
+        // The index database is closed again, so the rebuilt statistics are read back from disk
+        CoinStatsIndex reloaded{interfaces::MakeChain(m_node), 1 << 20};
+        BOOST_CHECK(reloaded.LookUpStats(*tip));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
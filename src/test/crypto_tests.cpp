@@ -15,6 +15,7 @@
 #include <crypto/sha3.h>
 #include <crypto/sha512.h>
 #include <crypto/muhash.h>
+#include <kernel/coinstats.h>
 #include <random.h>
 #include <streams.h>
 #include <test/util/random.h>
@@ -22,6 +23,8 @@
 #include <util/strencodings.h>
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -848,6 +851,46 @@ BOOST_AUTO_TEST_CASE(chacha20_midblock)
     BOOST_CHECK(std::ranges::equal(std::span{block}.last(52), b3));
 }
 
+BOOST_AUTO_TEST_CASE(chacha20_multiblock)
+{
+    auto key = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"_hex;
+    const ChaCha20::Nonce96 nonce{0x09000000, 0x4a000000};
+    // Multi-block requests (which may use vectorized code) must match computing one
+    // block at a time, also when the block counter wraps into the nonce.
+    for (const uint32_t counter : {0U, 1U, 0xfffffffbU}) {
+        for (const size_t blocks : {1U, 3U, 4U, 5U, 8U, 9U, 12U, 17U, 33U}) {
+            std::vector<std::byte> expected(blocks * 64), input(blocks * 64);
+            for (size_t i = 0; i < input.size(); ++i) input[i] = std::byte(i * 7);
+            ChaCha20Aligned single{key};
+            single.Seek(nonce, counter);
+            for (size_t i = 0; i < blocks; ++i) {
+                single.Keystream(std::span{expected}.subspan(i * 64, 64));
+            }
+
+            ChaCha20Aligned multi{key};
+            multi.Seek(nonce, counter);
+            std::vector<std::byte> keystream(blocks * 64), output(blocks * 64);
+            multi.Keystream(keystream);
+            BOOST_CHECK(keystream == expected);
+            multi.Seek(nonce, counter);
+            multi.Crypt(input, output);
+            for (size_t i = 0; i < output.size(); ++i) {
+                BOOST_CHECK(output[i] == (input[i] ^ expected[i]));
+            }
+
+            // Small reads through the buffered ChaCha20 see the same keystream.
+            ChaCha20 buffered{key};
+            buffered.Seek(nonce, counter);
+            std::vector<std::byte> pieces(blocks * 64);
+            for (size_t pos = 0, len = 1; pos < pieces.size(); pos += len, len = len * 3 % 97 + 1) {
+                len = std::min(len, pieces.size() - pos);
+                buffered.Keystream(std::span{pieces}.subspan(pos, len));
+            }
+            BOOST_CHECK(pieces == expected);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(poly1305_testvector)
 {
     // RFC 7539, section 2.5.2.
@@ -1280,4 +1323,80 @@ BOOST_AUTO_TEST_CASE(muhash_tests)
     BOOST_CHECK_EQUAL(HexStr(out4), "3a31e6903aff0de9f62f9a9f7f8b861de76ce2cda09822b90014319ae5dc2271");
 }
 
+BOOST_AUTO_TEST_CASE(muhash_multiply_implementations)
+{
+    // 2^3072 - MAX_PRIME_DIFF is the modulus
+    constexpr Num3072::limb_t MAX_PRIME_DIFF{1103717};
+    constexpr Num3072::limb_t ALL_ONES{std::numeric_limits<Num3072::limb_t>::max()};
+    auto make = [](auto fill) {
+        Num3072 num;
+        for (int i = 0; i < Num3072::LIMBS; ++i) num.limbs[i] = fill(i);
+        return num;
+    };
+
+    std::vector<Num3072> values{
+        make([](int) { return Num3072::limb_t{0}; }),
+        make([](int i) { return Num3072::limb_t{i == 0}; }),
+        make([&](int i) { return i == 0 ? MAX_PRIME_DIFF : 0; }),
+        make([](int) { return ALL_ONES; }),
+        make([&](int i) { return i == 0 ? ALL_ONES - MAX_PRIME_DIFF + 1 : ALL_ONES; }), // modulus
+        make([&](int i) { return i == 0 ? ALL_ONES - MAX_PRIME_DIFF : ALL_ONES; }),     // modulus - 1
+        make([&](int i) { return i == 0 ? ALL_ONES - MAX_PRIME_DIFF + 2 : ALL_ONES; }), // modulus + 1
+        make([](int i) { return i == 0 ? 0 : ALL_ONES; }),
+        make([](int i) { return i == Num3072::LIMBS - 1 ? ALL_ONES : 0; }),
+        make([](int i) { return i < Num3072::LIMBS / 2 ? ALL_ONES : 0; }),
+        make([](int i) { return i % 2 ? ALL_ONES : 0; }),
+        make([](int i) { return i % 2 ? 0 : ALL_ONES; }),
+    };
+    const size_t edge_values{values.size()};
+    for (int i = 0; i < 64; ++i) {
+        values.push_back(make([&](int) { return m_rng.rand<Num3072::limb_t>(); }));
+    }
+
+    if (!Num3072::UseOptimizedMultiply(true)) {
+        BOOST_TEST_MESSAGE("No optimized multiply on this CPU, only the portable one is tested");
+    }
+    auto multiply = [](Num3072 a, const Num3072& b, bool optimized) {
+        Num3072::UseOptimizedMultiply(optimized);
+        a.Multiply(b);
+        return a;
+    };
+    for (size_t i = 0; i < values.size(); ++i) {
+        // Edge values are multiplied with every value, random values with a few
+        for (size_t j = 0; j < values.size(); ++j) {
+            if (i >= edge_values && j >= edge_values && m_rng.randrange(8) != 0) continue;
+            const Num3072 portable{multiply(values[i], values[j], false)};
+            const Num3072 optimized{multiply(values[i], values[j], true)};
+            BOOST_CHECK(std::equal(std::begin(portable.limbs), std::end(portable.limbs), std::begin(optimized.limbs)));
+        }
+    }
+    Num3072::UseOptimizedMultiply(true);
+}
+
+BOOST_AUTO_TEST_CASE(muhash_accumulator)
+{
+    for (int worker_threads : {0, 1, 3}) {
+        kernel::MuHashAccumulator acc{worker_threads};
+        // Reusing the accumulator after Finish() starts from the empty set again.
+        // Updates that fit into one batch are applied without the workers.
+        for (int elements : {0, 100, 256, 257, 1500, 100}) {
+            MuHash3072 expected;
+            for (int i = 0; i < elements; ++i) {
+                const std::vector<unsigned char> data{m_rng.randbytes(m_rng.randrange(100))};
+                if (m_rng.randbool()) {
+                    expected.Insert(data);
+                    acc.Insert(data);
+                } else {
+                    expected.Remove(data);
+                    acc.Remove(data);
+                }
+            }
+            uint256 out_expected, out;
+            expected.Finalize(out_expected);
+            acc.Finish().Finalize(out);
+            BOOST_CHECK_EQUAL(out, out_expected);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
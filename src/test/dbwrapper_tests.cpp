@@ -5,6 +5,7 @@
 #include <dbwrapper.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
+#include <txdb.h>
 #include <uint256.h>
 #include <util/string.h>
 
@@ -185,6 +186,89 @@ BOOST_AUTO_TEST_CASE(dbwrapper_batch)
     }
 }
 
+BOOST_AUTO_TEST_CASE(dbwrapper_write_back)
+{
+    constexpr size_t CACHE_SIZE{1_MiB};
+    const fs::path path{m_args.GetDataDirBase() / "dbwrapper_write_back"};
+    const uint256 block_hash{m_rng.rand256()};
+    uint32_t prune_height{0};
+
+    {
+        CoordinateAssetDB db{{.path = path, .cache_bytes = CACHE_SIZE, .wipe_data = true}, /*max_pending_bytes=*/CACHE_SIZE, /*max_cache_bytes=*/CACHE_SIZE};
+        BOOST_CHECK(db.WriteAssetMinedBlock(block_hash));
+        BOOST_CHECK(db.WriteLastAssetPruneHeight(42));
+
+        // Pending writes are visible before they are flushed
+        BOOST_CHECK(db.getAssetMinedBlock(block_hash));
+        BOOST_CHECK(db.GetLastAssetPruneHeight(prune_height));
+        BOOST_CHECK_EQUAL(prune_height, 42U);
+        BOOST_CHECK_GT(db.PendingBytes(), 0U);
+        BOOST_CHECK(!db.ShouldFlush());
+    }
+
+    // Writes which were never flushed are not on disk
+    {
+        CoordinateAssetDB db{{.path = path, .cache_bytes = CACHE_SIZE}, /*max_pending_bytes=*/CACHE_SIZE, /*max_cache_bytes=*/CACHE_SIZE};
+        BOOST_CHECK(!db.getAssetMinedBlock(block_hash));
+        BOOST_CHECK(!db.GetLastAssetPruneHeight(prune_height));
+
+        BOOST_CHECK(db.WriteAssetMinedBlock(block_hash));
+        BOOST_CHECK(db.WriteLastAssetPruneHeight(43));
+        BOOST_CHECK(!db.HaveAssetMintBlock(block_hash));
+        db.WriteAssetMintBlock(block_hash);
+        BOOST_CHECK(db.HaveAssetMintBlock(block_hash));
+        BOOST_CHECK(db.Flush());
+        BOOST_CHECK_EQUAL(db.PendingBytes(), 0U);
+    }
+
+    {
+        CoordinateAssetDB db{{.path = path, .cache_bytes = CACHE_SIZE}, /*max_pending_bytes=*/CACHE_SIZE, /*max_cache_bytes=*/CACHE_SIZE};
+        BOOST_CHECK(db.getAssetMinedBlock(block_hash));
+        BOOST_CHECK(db.GetLastAssetPruneHeight(prune_height));
+        BOOST_CHECK_EQUAL(prune_height, 43U);
+        // A replayed block sees that its additional mints are already counted
+        BOOST_CHECK(db.HaveAssetMintBlock(block_hash));
+        BOOST_CHECK(!db.HaveAssetMintBlock(uint256::ONE));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dbwrapper_asset_cache)
+{
+    const fs::path path{m_args.GetDataDirBase() / "dbwrapper_asset_cache"};
+    CoordinateAsset first;
+    first.nID = CreateAssetId(10, 1);
+    first.strTicker = "FIRST";
+    first.nSupply = 100;
+    CoordinateAsset second = first;
+    second.nID = CreateAssetId(10, 2);
+
+    // room for a single asset
+    CoordinateAssetDB db{{.path = path, .cache_bytes = 1_MiB, .memory_only = true}, /*max_pending_bytes=*/1_MiB, /*max_cache_bytes=*/1};
+    BOOST_CHECK(db.WriteCoordinateAssets({first, second}));
+    BOOST_CHECK_EQUAL(db.GetCacheStats().entries, 0U);
+
+    CoordinateAssetDB cached_db{{.path = path / "cached", .cache_bytes = 1_MiB, .memory_only = true}, /*max_pending_bytes=*/1_MiB, /*max_cache_bytes=*/1_MiB};
+    BOOST_CHECK(cached_db.WriteCoordinateAssets({first}));
+    BOOST_CHECK(cached_db.Flush());
+
+    CoordinateAsset asset;
+    BOOST_CHECK(cached_db.GetAsset(getAssetHash(first.nID), asset));
+    BOOST_CHECK_EQUAL(asset.strTicker, "FIRST");
+    BOOST_CHECK(!cached_db.GetAsset(getAssetHash(second.nID), asset));
+
+    // writes replace the cached copy
+    first.nSupply = 200;
+    BOOST_CHECK(cached_db.WriteCoordinateAssets({first}));
+    BOOST_CHECK(cached_db.GetAsset(getAssetHash(first.nID), asset));
+    BOOST_CHECK_EQUAL(asset.nSupply, 200U);
+
+    const CoordinateAssetDB::CacheStats stats{cached_db.GetCacheStats()};
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_EQUAL(stats.hits, 2U);
+    BOOST_CHECK_EQUAL(stats.misses, 1U);
+    BOOST_CHECK_GT(stats.usage, 0U);
+}
+
 BOOST_AUTO_TEST_CASE(dbwrapper_iterator)
 {
     // Perform tests both obfuscated and non-obfuscated.
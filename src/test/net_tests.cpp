@@ -6,6 +6,9 @@
 #include <clientversion.h>
 #include <common/args.h>
 #include <compat/compat.h>
+#include <coordinate/anduro_deposit.h>
+#include <coordinate/coordinate_preconf.h>
+#include <coordinate/federation_witness.h>
 #include <cstdint>
 #include <net.h>
 #include <net_processing.h>
@@ -13,9 +16,11 @@
 #include <netbase.h>
 #include <netmessagemaker.h>
 #include <node/protocol_version.h>
+#include <protocol.h>
 #include <serialize.h>
 #include <span.h>
 #include <streams.h>
+#include <test/util/net.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
@@ -889,6 +894,161 @@ BOOST_AUTO_TEST_CASE(initial_advertise_from_version_message)
 }
 
 
+BOOST_AUTO_TEST_CASE(preconf_signatures_announced_once)
+{
+    m_node.args->ForceSetArg("-capturemessages", "1");
+
+    CNode peer{/*id=*/0,
+               /*sock=*/nullptr,
+               /*addrIn=*/CAddress{CService{LookupNumeric("1.2.3.4", 8333)}, NODE_NETWORK},
+               /*nKeyedNetGroupIn=*/0,
+               /*nLocalHostNonceIn=*/0,
+               /*addrBindIn=*/CService{},
+               /*addrNameIn=*/std::string{},
+               /*conn_type_in=*/ConnectionType::OUTBOUND_FULL_RELAY,
+               /*inbound_onion=*/false};
+
+    m_node.peerman->InitializeNode(peer, NODE_NETWORK);
+    m_node.peerman->SetBestBlock(0, std::chrono::seconds{0});
+
+    std::atomic<bool> interrupt_dummy{false};
+    std::chrono::microseconds time_received_dummy{0};
+    const uint64_t services{NODE_NETWORK | NODE_WITNESS};
+    const auto msg_version{NetMsg::Make(NetMsgType::VERSION, PROTOCOL_VERSION, services, int64_t{0}, services, CAddress::V1_NETWORK(CService{}))};
+    DataStream msg_version_stream{msg_version.data};
+    m_node.peerman->ProcessMessage(peer, NetMsgType::VERSION, msg_version_stream, time_received_dummy, interrupt_dummy);
+    const auto msg_verack{NetMsg::Make(NetMsgType::VERACK)};
+    DataStream msg_verack_stream{msg_verack.data};
+    m_node.peerman->ProcessMessage(peer, NetMsgType::VERACK, msg_verack_stream, time_received_dummy, interrupt_dummy);
+
+    // Witnesses of the signatures in each preconf signature push to the peer
+    std::vector<std::vector<std::string>> pushed;
+    const auto CaptureMessageOrig = CaptureMessage;
+    CaptureMessage = [&pushed](const CAddress& addr,
+                               const std::string& msg_type,
+                               std::span<const unsigned char> data,
+                               bool is_incoming) -> void {
+        if (!is_incoming && msg_type == NetMsgType::PRECONFSIGNATUREPUSH) {
+            DataStream s{data};
+            std::vector<CoordinatePreConfSig> sigs;
+            s >> FEDERATION_WITNESS_BINARY(sigs);
+            auto& witnesses{pushed.emplace_back()};
+            for (const auto& sig : sigs) witnesses.push_back(sig.witness);
+        }
+    };
+
+    auto vote = [](const std::string& witness) {
+        CoordinatePreConfSig sig;
+        sig.blockHeight = 5;
+        sig.minedBlockHeight = 1;
+        sig.witness = witness;
+        return sig;
+    };
+
+    // Nothing to announce yet
+    m_node.peerman->SendMessages(&peer);
+    BOOST_CHECK(pushed.empty());
+
+    WITH_LOCK(cs_main, insertPreConfSig(vote("aa")));
+    m_node.peerman->SendMessages(&peer);
+    BOOST_REQUIRE_EQUAL(pushed.size(), 1U);
+    BOOST_CHECK(pushed[0] == std::vector<std::string>{"aa"});
+
+    // A signature is sent to the peer only once
+    m_node.peerman->SendMessages(&peer);
+    BOOST_CHECK_EQUAL(pushed.size(), 1U);
+
+    // A new signature is announced on its own
+    WITH_LOCK(cs_main, insertPreConfSig(vote("bb")));
+    m_node.peerman->SendMessages(&peer);
+    BOOST_REQUIRE_EQUAL(pushed.size(), 2U);
+    BOOST_CHECK(pushed[1] == std::vector<std::string>{"bb"});
+
+    CaptureMessage = CaptureMessageOrig;
+    WITH_LOCK(cs_main, removePreConfWitness());
+    m_node.peerman->FinalizeNode(peer);
+    m_node.args->ForceSetArg("-capturemessages", "0");
+}
+
+BOOST_AUTO_TEST_CASE(preconf_messages_keep_peer_order)
+{
+    ConnmanTestMsg connman{0x1337, 0x1337, *m_node.addrman, *m_node.netgroupman, Params()};
+    CNode peer{/*id=*/0,
+               /*sock=*/nullptr,
+               /*addrIn=*/CAddress{CService{LookupNumeric("1.2.3.4", 8333)}, NODE_NETWORK},
+               /*nKeyedNetGroupIn=*/0,
+               /*nLocalHostNonceIn=*/0,
+               /*addrBindIn=*/CService{},
+               /*addrNameIn=*/std::string{},
+               /*conn_type_in=*/ConnectionType::OUTBOUND_FULL_RELAY,
+               /*inbound_onion=*/false};
+
+    (void)connman.ReceiveMsgFrom(peer, NetMsg::Make(NetMsgType::PING, uint64_t{1}));
+    (void)connman.ReceiveMsgFrom(peer, NetMsg::Make(NetMsgType::PRECONFSIGNATUREPUSH, FEDERATION_WITNESS_BINARY(std::vector<CoordinatePreConfSig>{})));
+    (void)connman.ReceiveMsgFrom(peer, NetMsg::Make(NetMsgType::PING, uint64_t{2}));
+
+    // the preconf thread waits for the messages received before its own
+    BOOST_CHECK(!peer.PollPreconfMessage());
+    auto msg{peer.PollMessage()};
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->first.m_type, NetMsgType::PING);
+    BOOST_CHECK(!msg->second);
+    // and until they are processed, not just polled
+    BOOST_CHECK(!peer.PollPreconfMessage());
+    BOOST_CHECK(peer.MarkMessageProcessed());
+
+    // the message handler waits for the preconf message in turn
+    BOOST_CHECK(!peer.PollMessage());
+    msg = peer.PollPreconfMessage();
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->first.m_type, NetMsgType::PRECONFSIGNATUREPUSH);
+    BOOST_CHECK(!msg->second);
+    BOOST_CHECK(!peer.PollMessage());
+    BOOST_CHECK(!peer.MarkMessageProcessed());
+
+    msg = peer.PollMessage();
+    BOOST_REQUIRE(msg);
+    BOOST_CHECK_EQUAL(msg->first.m_type, NetMsgType::PING);
+    BOOST_CHECK(!peer.MarkMessageProcessed());
+    BOOST_CHECK(!peer.PollMessage());
+    BOOST_CHECK(!peer.PollPreconfMessage());
+}
+
+BOOST_AUTO_TEST_CASE(federation_witness_encoding)
+{
+    CoordinatePreConfSig sig;
+    sig.blockHeight = 5;
+    sig.minedBlockHeight = 1;
+    sig.witness = std::string(128, 'a') + "0f";
+    AnduroPreCommitment commitment{sig.witness, 7, 1, "keys", "deposit", "burn"};
+
+    DataStream hex, binary;
+    hex << FEDERATION_WITNESS_HEX(sig) << FEDERATION_WITNESS_HEX(commitment);
+    binary << FEDERATION_WITNESS_BINARY(sig) << FEDERATION_WITNESS_BINARY(commitment);
+    // each witness shrinks to half its hex length
+    BOOST_CHECK_EQUAL(hex.size() - binary.size(), 2 * 65U);
+
+    for (DataStream* s : {&hex, &binary}) {
+        const auto& params{s == &hex ? FEDERATION_WITNESS_HEX : FEDERATION_WITNESS_BINARY};
+        CoordinatePreConfSig sig_read;
+        AnduroPreCommitment commitment_read;
+        *s >> params(sig_read) >> params(commitment_read);
+        BOOST_CHECK_EQUAL(sig_read.witness, sig.witness);
+        BOOST_CHECK_EQUAL(sig_read.blockHeight, sig.blockHeight);
+        BOOST_CHECK_EQUAL(commitment_read.witness, commitment.witness);
+        BOOST_CHECK_EQUAL(commitment_read.block_height, commitment.block_height);
+        BOOST_CHECK(s->empty());
+    }
+
+    // a witness that is not valid hex has no binary form
+    sig.witness = "zz";
+    DataStream invalid;
+    invalid << FEDERATION_WITNESS_BINARY(sig);
+    CoordinatePreConfSig sig_read;
+    invalid >> FEDERATION_WITNESS_BINARY(sig_read);
+    BOOST_CHECK(sig_read.witness.empty());
+}
+
 BOOST_AUTO_TEST_CASE(advertise_local_address)
 {
     auto CreatePeer = [](const CAddress& addr) {
@@ -9,9 +9,14 @@
 #include <txmempool.h>
 #include <policy/policy.h>
 #include <node/miner.h>
+#include <coordinate/anduro_deposit.h>
 #include <coordinate/anduro_validator.h>
+#include <coordinate/coordinate_preconf.h>
+#include <coordinate/signed_block.h>
 #include <consensus/merkle.h>
 #include <pow.h>
+#include <key.h>
+#include <util/strencodings.h>
 #include <test/util/txmempool.h>
 #include <txmempool.h>
 #include <validation.h>
@@ -186,4 +191,223 @@ BOOST_FIXTURE_TEST_CASE(submit_normal_tx_preconf, TestChain100Setup) {
     BOOST_CHECK(result.m_result_type != MempoolAcceptResult::ResultType::VALID);
 }
 
+BOOST_FIXTURE_TEST_CASE(commitment_pool_reorg, RegTestingSetup) {
+    ChainstateManager& chainman = *m_node.chainman;
+    const uint256 genesis_hash = WITH_LOCK(cs_main, return chainman.ActiveChain().Genesis()->GetBlockHash());
+
+    std::vector<AnduroPreCommitment> commitments;
+    for (int32_t height = 1; height <= 3; height++) {
+        commitments.emplace_back("", height, 0, "", "", "");
+    }
+    BOOST_CHECK(includePreCommitmentSignature(commitments, chainman));
+    // already known signatures are accepted without being added again
+    BOOST_CHECK(includePreCommitmentSignature(commitments, chainman));
+    BOOST_CHECK_EQUAL(listPendingCommitment(-1).size(), 3U);
+    BOOST_CHECK_EQUAL(listPendingCommitment(2).size(), 1U);
+
+    // connecting blocks expires their commitments
+    resetCommitment(1);
+    BOOST_CHECK(!hasPendingCommitment(1));
+    BOOST_CHECK(hasPendingCommitment(2));
+
+    // disconnecting the block restores them
+    reinsertCommitment(1, uint256::ONE);
+    BOOST_CHECK(hasPendingCommitment(1));
+
+    // the commitment for height 3 is signed over genesis and goes away with it
+    reinsertCommitment(0, genesis_hash);
+    BOOST_CHECK(!hasPendingCommitment(3));
+    BOOST_CHECK_EQUAL(listPendingCommitment(-1).size(), 2U);
+
+    resetCommitment(3);
+    BOOST_CHECK(listPendingCommitment(-1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(connect_signed_block_parallel_scripts) {
+    Chainstate& chainstate = m_node.chainman->ActiveChainstate();
+    BOOST_REQUIRE(m_node.chainman->GetCheckQueue().HasThreads());
+
+    CKey key = GenerateRandomKey();
+    const CScript scriptPubKey = GetScriptForDestination(PKHash(key.GetPubKey()));
+
+    // coins to spend, more of them than there are script check threads
+    CMutableTransaction funding;
+    funding.version = 2;
+    funding.vin.resize(1);
+    funding.vin[0].prevout = COutPoint(Txid::FromUint256(m_rng.rand256()), 0);
+    for (int i = 0; i < 8; i++) {
+        funding.vout.emplace_back(1 * COIN, scriptPubKey);
+    }
+    const CTransactionRef fundingTx = MakeTransactionRef(funding);
+
+    auto make_block = [&](bool corrupt) {
+        SignedBlock block;
+        block.nHeight = 1;
+        CMutableTransaction coinbase;
+        coinbase.version = TRANSACTION_PRECONF_VERSION;
+        coinbase.vin.resize(1);
+        coinbase.vin[0].prevout.SetNull();
+        coinbase.vout.emplace_back(0, CScript() << OP_RETURN);
+        block.vtx.push_back(MakeTransactionRef(coinbase));
+        for (uint32_t i = 0; i < fundingTx->vout.size(); i++) {
+            CMutableTransaction tx;
+            tx.version = 2;
+            tx.vin.emplace_back(fundingTx->GetHash(), i);
+            tx.vout.emplace_back(1 * COIN - 1000, scriptPubKey);
+            BOOST_REQUIRE(SignTransaction(tx, key, fundingTx));
+            if (corrupt && i == fundingTx->vout.size() - 1) {
+                // flip a bit of the signature of the last input
+                std::vector<unsigned char> script(tx.vin[0].scriptSig.begin(), tx.vin[0].scriptSig.end());
+                script[10] ^= 1;
+                tx.vin[0].scriptSig = CScript(script.begin(), script.end());
+            }
+            block.vtx.push_back(MakeTransactionRef(tx));
+        }
+        return block;
+    };
+
+    LOCK(cs_main);
+    for (uint32_t i = 0; i < fundingTx->vout.size(); i++) {
+        chainstate.CoinsTip().AddCoin(COutPoint(fundingTx->GetHash(), i), Coin(fundingTx->vout[i], 0, false), false);
+    }
+
+    // a bad signature found by a script check thread fails the signed block
+    BOOST_CHECK(!chainstate.ConnectSignedBlock(make_block(/*corrupt=*/true)));
+    BOOST_CHECK(chainstate.ConnectSignedBlock(make_block(/*corrupt=*/false)));
+}
+
+BOOST_AUTO_TEST_CASE(preconf_pool_evicts_lowest_fee_rate) {
+    CTxMemPool::Options opts{MemPoolOptionsForTest(m_node)};
+    opts.is_preconf = true;
+    bilingual_str error;
+    CTxMemPool preconf_pool{opts, error};
+    BOOST_REQUIRE(error.empty());
+
+    TestMemPoolEntryHelper entry;
+    std::vector<CTransactionRef> txs;
+    for (CAmount bid : {3 * COIN, 1 * COIN, 2 * COIN}) {
+        CMutableTransaction mtx;
+        mtx.vin.resize(1);
+        mtx.vin[0].prevout = COutPoint(Txid::FromUint256(m_rng.rand256()), 0);
+        mtx.vin[0].scriptSig = CScript() << OP_11;
+        mtx.vout.resize(1);
+        mtx.vout[0].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+        mtx.vout[0].nValue = bid;
+        txs.push_back(MakeTransactionRef(mtx));
+    }
+
+    LOCK2(cs_main, preconf_pool.cs);
+    for (const auto& tx : txs) {
+        AddToMempool(preconf_pool, entry.FromTx(tx));
+    }
+    const int32_t vsize = GetVirtualTransactionSize(*txs[0]);
+
+    // below the size limit every bid is accepted
+    BOOST_CHECK(preconf_pool.IsPreConfFeeRateAccepted(0, vsize));
+
+    // candidates for the next signed block are listed highest bid first
+    const auto entries{preconf_pool.entryAll()};
+    BOOST_REQUIRE_EQUAL(entries.size(), 3U);
+    BOOST_CHECK(entries[0].get().GetTx().GetHash() == txs[0]->GetHash());
+    BOOST_CHECK(entries[1].get().GetTx().GetHash() == txs[2]->GetHash());
+    BOOST_CHECK(entries[2].get().GetTx().GetHash() == txs[1]->GetHash());
+
+    // trimming drops the lowest bid first, regardless of the transaction fee
+    preconf_pool.TrimPreConfToSize(preconf_pool.DynamicMemoryUsage() - 1);
+    BOOST_CHECK_EQUAL(preconf_pool.size(), 2U);
+    BOOST_CHECK(!preconf_pool.exists(txs[1]->GetHash()));
+    BOOST_CHECK(preconf_pool.exists(txs[0]->GetHash()));
+    BOOST_CHECK(preconf_pool.exists(txs[2]->GetHash()));
+}
+
+BOOST_AUTO_TEST_CASE(preconf_fee_history_reorg) {
+    LOCK(cs_main);
+    recordSignedBlockFee(10, 1 * COIN);
+    recordSignedBlockFee(11, 2 * COIN);
+    recordSignedBlockFee(11, 3 * COIN);
+    recordSignedBlockFee(12, 4 * COIN);
+    BOOST_CHECK(getRecentSignedBlockFees(2) == (std::vector<CAmount>{4 * COIN, 3 * COIN}));
+
+    // disconnecting block 11 drops the signed blocks connected on top of it
+    rollbackSignedBlockFees(12);
+    rollbackSignedBlockFees(11);
+    BOOST_CHECK(getRecentSignedBlockFees(PRECONF_FEE_HISTORY) == (std::vector<CAmount>{1 * COIN}));
+
+    rollbackSignedBlockFees(0);
+    BOOST_CHECK(getRecentSignedBlockFees(PRECONF_FEE_HISTORY).empty());
+}
+
+BOOST_AUTO_TEST_CASE(signed_block_ref_hash) {
+    SignedBlock block;
+    block.nHeight = 7;
+    block.currentFee = 1000;
+    const uint256 hash = block.GetHash();
+
+    const SignedBlockRef ref = MakeSignedBlockRef(block);
+    BOOST_CHECK_EQUAL(ref->GetHash(), hash);
+
+    // copies are mutable again and do not keep the frozen hash
+    SignedBlock copy = *ref;
+    copy.nHeight = 8;
+    BOOST_CHECK(copy.GetHash() != hash);
+    BOOST_CHECK_EQUAL(ref->GetHash(), hash);
+}
+
+BOOST_AUTO_TEST_CASE(compact_federation_witness) {
+    std::vector<CKey> federation;
+    std::vector<unsigned char> keySet{0x01, 3};
+    for (int i = 0; i < 3; i++) {
+        federation.push_back(GenerateRandomKey());
+        const XOnlyPubKey key{federation.back().GetPubKey()};
+        keySet.insert(keySet.end(), key.begin(), key.end());
+    }
+    const std::string keysHex = HexStr(keySet);
+    const uint256 message = preparePreconfMessageHash({uint256::ZERO, m_rng.rand256()}, 5, 2);
+
+    // signers 0 and 2 out of 3
+    std::vector<unsigned char> witness{0x01, 0b101};
+    for (int i : {0, 2}) {
+        unsigned char sig[64];
+        BOOST_REQUIRE(federation[i].SignSchnorr(message, sig, nullptr, uint256::ZERO));
+        witness.insert(witness.end(), std::begin(sig), std::end(sig));
+    }
+    const std::string witnessHex = HexStr(witness);
+    const auto noLegacy = [] { return std::string{}; };
+
+    BOOST_CHECK(isCompactFederationEncoding(witnessHex));
+    BOOST_CHECK(validateFederationWitness(witnessHex, noLegacy, message, keysHex, /*majority=*/true, /*allowCompact=*/true));
+    // not accepted before the deployment is active
+    BOOST_CHECK(!validateFederationWitness(witnessHex, noLegacy, message, keysHex, /*majority=*/true, /*allowCompact=*/false));
+    // signatures over another message
+    BOOST_CHECK(!validateFederationWitness(witnessHex, noLegacy, prepareCommitmentMessageHash(message), keysHex, /*majority=*/true, /*allowCompact=*/true));
+
+    // a single signer is enough for unfinalized preconf lists but not for a majority
+    std::vector<unsigned char> single(witness.begin(), witness.begin() + 2 + 64);
+    single[1] = 0b001;
+    BOOST_CHECK(validateFederationWitness(HexStr(single), noLegacy, message, keysHex, /*majority=*/false, /*allowCompact=*/true));
+    BOOST_CHECK(!validateFederationWitness(HexStr(single), noLegacy, message, keysHex, /*majority=*/true, /*allowCompact=*/true));
+
+    // bits past the last key or trailing data are rejected
+    std::vector<unsigned char> malleated = witness;
+    malleated[1] |= 0b1000;
+    BOOST_CHECK(!validateFederationWitness(HexStr(malleated), noLegacy, message, keysHex, /*majority=*/true, /*allowCompact=*/true));
+    malleated = witness;
+    malleated.push_back(0);
+    BOOST_CHECK(!validateFederationWitness(HexStr(malleated), noLegacy, message, keysHex, /*majority=*/true, /*allowCompact=*/true));
+
+    // the producer side builds the same encodings
+    std::vector<XOnlyPubKey> keys;
+    BOOST_REQUIRE(parseFederationKeys(keysHex, /*allowCompact=*/true, keys));
+    std::string encodedKeys;
+    BOOST_REQUIRE(encodeCompactFederationKeys(keys, encodedKeys));
+    BOOST_CHECK_EQUAL(encodedKeys, keysHex);
+    std::string signedWitness;
+    BOOST_REQUIRE(signCompactAnduroWitness(keys, {federation[2], federation[0]}, message, signedWitness));
+    BOOST_CHECK_EQUAL(signedWitness, witnessHex);
+    BOOST_CHECK(!signCompactAnduroWitness(keys, {federation[0], GenerateRandomKey()}, message, signedWitness));
+    BOOST_CHECK(!signCompactAnduroWitness(keys, {}, message, signedWitness));
+    std::map<XOnlyPubKey, std::vector<unsigned char>> shortSignature{{keys[1], std::vector<unsigned char>(63)}};
+    BOOST_CHECK(!encodeCompactAnduroWitness(keys, shortSignature, signedWitness));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
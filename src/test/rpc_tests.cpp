@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <coordinate/coordinate_preconf.h>
 #include <core_io.h>
 #include <interfaces/chain.h>
 #include <node/context.h>
@@ -12,6 +13,7 @@
 #include <test/util/setup_common.h>
 #include <univalue.h>
 #include <util/time.h>
+#include <validation.h>
 
 #include <any>
 
@@ -639,4 +641,58 @@ BOOST_AUTO_TEST_CASE(rpc_arg_helper)
     CheckRpc(params, UniValue{JSON(R"([5, "hello", 4, "test", true, 1.23, "world"])")}, check_positional);
 }
 
+BOOST_AUTO_TEST_CASE(rpc_getpreconflist_cursor)
+{
+    // Votes are told apart by their mined block height, their transactions are not in the preconf pool
+    const auto vote = [](int64_t height, int64_t mined_height, size_t txs) {
+        CoordinatePreConfSig sig;
+        sig.blockHeight = height;
+        sig.minedBlockHeight = mined_height;
+        sig.txids.assign(txs, uint256::ONE);
+        return sig;
+    };
+    const auto mined_heights = [](const UniValue& result) {
+        std::vector<int64_t> heights;
+        for (const UniValue& item : result["block"].getValues()) {
+            heights.push_back(item["mined_block_height"].getInt<int64_t>());
+        }
+        return heights;
+    };
+    {
+        LOCK(cs_main);
+        insertPreConfSig(vote(5, 1, 2));
+        insertPreConfSig(vote(5, 2, 1));
+        insertPreConfSig(vote(6, 3, 1));
+    }
+
+    // Everything is returned unless a count is given
+    UniValue result = CallRPC("getpreconflist 0");
+    BOOST_CHECK_EQUAL(result["total"].getInt<int>(), 4);
+    BOOST_CHECK((mined_heights(result) == std::vector<int64_t>{1, 1, 2, 3}));
+    BOOST_CHECK(result.find_value("next_cursor").isNull());
+    result = CallRPC("getpreconflist 5");
+    BOOST_CHECK_EQUAL(result["total"].getInt<int>(), 3);
+    BOOST_CHECK((mined_heights(result) == std::vector<int64_t>{1, 1, 2}));
+
+    // Pages continue after the cursor even when votes are added in between
+    result = CallRPC("getpreconflist 0 true 0:0 2");
+    BOOST_CHECK((mined_heights(result) == std::vector<int64_t>{1, 1}));
+    const std::string cursor{result["next_cursor"].get_str()};
+    WITH_LOCK(cs_main, insertPreConfSig(vote(6, 4, 1)));
+    result = CallRPC("getpreconflist 0 true " + cursor + " 2");
+    BOOST_CHECK((mined_heights(result) == std::vector<int64_t>{2, 3}));
+    BOOST_CHECK_EQUAL(result["total"].getInt<int>(), 5);
+    result = CallRPC("getpreconflist 0 true " + result["next_cursor"].get_str() + " 2");
+    BOOST_CHECK((mined_heights(result) == std::vector<int64_t>{4}));
+    BOOST_CHECK(result.find_value("next_cursor").isNull());
+
+    BOOST_CHECK_EXCEPTION(CallRPC("getpreconflist 0 true abc"), std::runtime_error, HasReason("Invalid cursor"));
+    BOOST_CHECK_EXCEPTION(CallRPC("getpreconflist 0 true 1:18446744073709551616"), std::runtime_error, HasReason("Invalid cursor"));
+    BOOST_CHECK_EXCEPTION(CallRPC("getpreconflist 0 true 0:0 0"), std::runtime_error, HasReason("Count must be positive"));
+    BOOST_CHECK_EXCEPTION(CallRPC("getfinalizedsignedblocks 0 0 0"), std::runtime_error, HasReason("Count must be positive"));
+    BOOST_CHECK(CallRPC("getfinalizedsignedblocks 0 9223372036854775807 9223372036854775807").isArray());
+
+    WITH_LOCK(cs_main, removePreConfWitness());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
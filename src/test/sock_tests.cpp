@@ -169,6 +169,42 @@ BOOST_AUTO_TEST_CASE(recv_until_terminator_limit)
     receiver.join();
 }
 
+BOOST_AUTO_TEST_CASE(wait_set)
+{
+    auto wait_set{SockWaitSet::Make()};
+#ifdef USE_EPOLL
+    BOOST_REQUIRE(wait_set);
+#endif
+    if (!wait_set) return;
+
+    int s[2];
+    CreateSocketPair(s);
+    auto sock0{std::make_shared<Sock>(s[0])};
+    Sock sock1(s[1]);
+
+    Sock::EventsPerSock events_per_sock{{sock0, Sock::Events{Sock::RECV}}};
+    BOOST_REQUIRE(wait_set->Update(events_per_sock));
+    BOOST_REQUIRE(wait_set->Wait(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, 0);
+
+    BOOST_REQUIRE_EQUAL(sock1.Send("a", 1, 0), 1);
+    BOOST_REQUIRE(wait_set->Update(events_per_sock));
+    BOOST_REQUIRE(wait_set->Wait(1min, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::RECV);
+
+    // Registered events change without registering again, and unread data is reported
+    // by every wait.
+    events_per_sock.at(sock0) = Sock::Events{Sock::RECV | Sock::SEND};
+    BOOST_REQUIRE(wait_set->Update(events_per_sock));
+    BOOST_REQUIRE(wait_set->Wait(1min, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::RECV | Sock::SEND);
+
+    // A socket that is not waited on anymore is released.
+    events_per_sock.clear();
+    BOOST_REQUIRE(wait_set->Update(events_per_sock));
+    BOOST_CHECK_EQUAL(sock0.use_count(), 1);
+}
+
 #endif /* WIN32 */
 
 BOOST_AUTO_TEST_SUITE_END()
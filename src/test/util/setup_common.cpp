@@ -5,15 +5,19 @@
 #include <test/util/setup_common.h>
 
 #include <addrman.h>
+#include <arith_uint256.h>
 #include <banman.h>
 #include <chainparams.h>
 #include <common/system.h>
 #include <consensus/consensus.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
+#include <coordinate/anduro_deposit.h>
+#include <coordinate/coordinate_pegin.h>
 #include <crypto/sha256.h>
 #include <init.h>
 #include <init/common.h>
+#include <key_io.h>
 #include <interfaces/chain.h>
 #include <kernel/mempool_entry.h>
 #include <logging.h>
@@ -29,6 +33,8 @@
 #include <node/warnings.h>
 #include <noui.h>
 #include <policy/fees.h>
+#include <policy/policy.h>
+#include <primitives/bitcoin/merkleblock.h>
 #include <pow.h>
 #include <random.h>
 #include <rpc/blockchain.h>
@@ -278,6 +284,7 @@ ChainTestingSetup::ChainTestingSetup(const ChainType chainType, TestOpts opts)
                 .memory_only = opts.block_tree_db_in_memory,
                 .wipe_data = m_args.GetBoolArg("-reindex", false),
             },
+            .auxpow_cache_bytes = m_kernel_cache_sizes.auxpow,
         };
         m_node.chainman = std::make_unique<ChainstateManager>(*Assert(m_node.shutdown_signal), chainman_opts, blockman_opts);
     };
@@ -378,7 +385,7 @@ TestChain100Setup::TestChain100Setup(
         LOCK(::cs_main);
         assert(
             m_node.chainman->ActiveChain().Tip()->GetBlockHash().ToString() ==
-            "84bf44bb187dae3c21d14039a0e134944d1dfa35a7347a8e67d5816d58e9e807");
+            "2d39de147319a5ec1b2ba83d30d58ec70c13ef0ebc424671d2b9fc119f11f183");
     }
 }
 
@@ -396,8 +403,14 @@ void TestChain100Setup::mineBlocks(int num_blocks)
 CBlock TestChain100Setup::CreateBlock(
     const std::vector<CMutableTransaction>& txns,
     const CScript& scriptPubKey,
-    Chainstate& chainstate)
+    Chainstate& chainstate,
+    const std::vector<CTransactionRef>& pegins)
 {
+    // Above height 2 the miner only builds on a pending federation precommitment,
+    // which regtest accepts without a witness
+    const int32_t height{WITH_LOCK(::cs_main, return chainstate.m_chain.Height()) + 1};
+    Assert(includePreCommitmentSignature({AnduroPreCommitment{"", height, 0, "", "", ""}}, *Assert(m_node.chainman)));
+
     BlockAssembler::Options options;
     options.coinbase_output_script = scriptPubKey;
     CBlock block = BlockAssembler{chainstate, nullptr, options}.CreateNewBlock()->block;
@@ -406,6 +419,7 @@ CBlock TestChain100Setup::CreateBlock(
     for (const CMutableTransaction& tx : txns) {
         block.vtx.push_back(MakeTransactionRef(tx));
     }
+    block.pegins.insert(block.pegins.end(), pegins.begin(), pegins.end());
     RegenerateCommitments(block, *Assert(m_node.chainman));
 
     while (!CheckProofOfWork(miningHeader.GetHash(), block.nBits, m_node.chainman->GetConsensus())) ++miningHeader.nNonce;
@@ -429,6 +443,47 @@ CBlock TestChain100Setup::CreateAndProcessBlock(
     return block;
 }
 
+CTransactionRef TestChain100Setup::MinePegin(const CScript& script, CAmount value)
+{
+    Chainstate& chainstate{Assert(m_node.chainman)->ActiveChainstate()};
+    const int height{WITH_LOCK(::cs_main, return chainstate.m_chain.Height())};
+
+    // The deposit to the federation, alone in a parent chain block. Its lock time
+    // keeps the deposits of different blocks apart.
+    const CTxDestination federation{WitnessV0KeyHash{coinbaseKey.GetPubKey()}};
+    Sidechain::Bitcoin::CMutableTransaction deposit;
+    deposit.vin.resize(1);
+    deposit.vout.emplace_back(value, GetScriptForDestination(federation));
+    deposit.nLockTime = static_cast<uint32_t>(height);
+    const uint256 deposit_hash{deposit.GetHash().ToUint256()};
+    Sidechain::Bitcoin::CMerkleBlock parent;
+    parent.header.hashMerkleRoot = deposit_hash;
+    parent.header.nBits = UintToArith256(m_node.chainman->GetParams().ParentPowList()).GetCompact();
+    while (!CheckParentProofOfWork(parent.header.GetHash(), parent.header.nBits)) ++parent.header.nNonce;
+    parent.txn = Sidechain::Bitcoin::CPartialMerkleTree{{deposit_hash}, {true}};
+
+    std::vector<unsigned char> deposit_data;
+    VectorWriter{deposit_data, 0, Sidechain::Bitcoin::TX_WITH_WITNESS(deposit)};
+    std::vector<unsigned char> proof;
+    VectorWriter{proof, 0, parent};
+
+    CMutableTransaction pegin;
+    pegin.version = TRANSACTION_PEGIN_VERSION;
+    pegin.vin.push_back(buildPeginTxInput(deposit_data, proof, ParentEncodeDestination(federation), CTxOut{value, script}));
+    pegin.vout.emplace_back(value, script);
+    pegin.vout.emplace_back(0, script);
+    const CAmount fee{GetVirtualTransactionSize(CTransaction{pegin}) * PEGIN_FEE};
+    pegin.vout[0].nValue -= fee;
+    pegin.vout[1].nValue = fee;
+    const CTransactionRef pegin_ref{MakeTransactionRef(std::move(pegin))};
+
+    const CScript coinbase_script{CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    const auto block{std::make_shared<const CBlock>(CreateBlock({}, coinbase_script, chainstate, {pegin_ref}))};
+    Assert(m_node.chainman->ProcessNewBlock(block, true, true, nullptr));
+    Assert(WITH_LOCK(::cs_main, return chainstate.m_chain.Tip()->GetBlockHash()) == block->GetHash());
+    return pegin_ref;
+}
+
 std::pair<CMutableTransaction, CAmount> TestChain100Setup::CreateValidTransaction(const std::vector<CTransactionRef>& input_transactions,
                                                                                   const std::vector<COutPoint>& inputs,
                                                                                   int input_height,
@@ -158,17 +158,26 @@ struct TestChain100Setup : public TestingSetup {
                                  Chainstate* chainstate = nullptr);
 
     /**
-     * Create a new block with just given transactions, coinbase paying to
-     * scriptPubKey.
+     * Create a new block with just given transactions and peg-ins, coinbase
+     * paying to scriptPubKey.
      */
     CBlock CreateBlock(
         const std::vector<CMutableTransaction>& txns,
         const CScript& scriptPubKey,
-        Chainstate& chainstate);
+        Chainstate& chainstate,
+        const std::vector<CTransactionRef>& pegins = {});
 
     //! Mine a series of new blocks on the active chain.
     void mineBlocks(int num_blocks);
 
+    /**
+     * Mine a block on the active chain with a peg-in paying value to script,
+     * claimed from a made up parent chain deposit. Blocks carry no subsidy, so
+     * this is how tests get coins to spend. The peg-in pays its fee from its
+     * second output, the first one holds the rest of value.
+     */
+    CTransactionRef MinePegin(const CScript& script, CAmount value);
+
     /**
     * Create a transaction, optionally setting the fee based on the feerate.
     * Note: The feerate may not be met exactly depending on whether the signatures can have different sizes.
@@ -8,6 +8,7 @@
 #include <coins.h>
 #include <dbwrapper.h>
 #include <logging.h>
+#include <memusage.h>
 #include <primitives/transaction.h>
 #include <random.h>
 #include <serialize.h>
@@ -17,6 +18,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <iterator>
+#include <map>
 #include <utility>
 
 static constexpr uint8_t DB_COIN{'C'};
@@ -28,6 +30,7 @@ static constexpr uint8_t DB_COINS{'c'};
 static constexpr uint8_t DB_ASSET{'A'};
 static constexpr uint8_t DB_MINED_ASSET{'D'};
 static constexpr uint8_t DB_ASSET_LAST_PRUNE_HEIGHT{'E'};
+static constexpr uint8_t DB_ASSET_MINT_BLOCK{'F'};
 
 static constexpr uint8_t DB_SIGNED_BLOCK_HASH{'V'};
 static constexpr uint8_t DB_SIGNED_BLOCK_LAST_ID{'S'};
@@ -35,6 +38,8 @@ static constexpr uint8_t DB_SIGNED_BLOCK_LAST_HASH{'U'};
 static constexpr uint8_t DB_BLOCK_INVALID_TX{'Q'};
 static constexpr uint8_t DB_SIGNED_BLOCK_TX{'P'};
 static constexpr uint8_t DB_DEPOSIT_ADDRESS{'R'};
+static constexpr uint8_t DB_SIGNED_BLOCK_HEIGHT{'W'};
+static constexpr uint8_t DB_SIGNED_BLOCK_HEIGHT_COMPLETE{'X'};
 
 bool CCoinsViewDB::NeedsUpgrade()
 {
@@ -244,18 +249,114 @@ void CCoinsViewDBCursor::Next()
 }
 
 
-CoordinateAssetDB::CoordinateAssetDB(DBParams db_params)
-    : CDBWrapper(db_params) { }
+CDBWriteBackWrapper::CDBWriteBackWrapper(const DBParams& db_params, size_t max_pending_bytes)
+    : CDBWrapper(db_params), m_max_pending_bytes(max_pending_bytes) { }
 
-bool CoordinateAssetDB::WriteCoordinateAssets(const std::vector<CoordinateAsset>& vAsset)
+void CDBWriteBackWrapper::SetPending(std::vector<std::byte>&& key, std::optional<std::vector<std::byte>>&& value)
+{
+    LOCK(m_pending_mutex);
+    const size_t value_size{value ? value->size() : 0};
+    auto [it, inserted] = m_pending.try_emplace(std::move(key));
+    if (inserted) {
+        m_pending_bytes += it->first.size();
+    } else if (it->second) {
+        m_pending_bytes -= it->second->size();
+    }
+    it->second = std::move(value);
+    m_pending_bytes += value_size;
+}
+
+std::optional<std::optional<std::vector<std::byte>>> CDBWriteBackWrapper::GetPending(const std::vector<std::byte>& key) const
+{
+    LOCK(m_pending_mutex);
+    auto it = m_pending.find(key);
+    if (it == m_pending.end()) return std::nullopt;
+    return it->second;
+}
+
+std::vector<std::pair<std::vector<std::byte>, std::optional<std::vector<std::byte>>>> CDBWriteBackWrapper::GetPendingWithPrefix(uint8_t prefix) const
+{
+    LOCK(m_pending_mutex);
+    std::vector<std::pair<std::vector<std::byte>, std::optional<std::vector<std::byte>>>> result;
+    for (auto it = m_pending.lower_bound(std::vector<std::byte>{std::byte{prefix}});
+         it != m_pending.end() && !it->first.empty() && it->first[0] == std::byte{prefix}; ++it) {
+        result.emplace_back(*it);
+    }
+    return result;
+}
+
+bool CDBWriteBackWrapper::Flush()
 {
+    LOCK(m_pending_mutex);
+    if (m_pending.empty()) return true;
+
     CDBBatch batch(*this);
+    for (const auto& [key, value] : m_pending) {
+        if (value) {
+            batch.Write(std::span{key}, std::span{*value});
+        } else {
+            batch.Erase(std::span{key});
+        }
+    }
+    if (!WriteBatch(batch, /*fSync=*/true)) return false;
+    m_pending.clear();
+    m_pending_bytes = 0;
+    return true;
+}
+
+size_t CDBWriteBackWrapper::PendingBytes() const
+{
+    LOCK(m_pending_mutex);
+    return m_pending_bytes;
+}
+
+CoordinateAssetDB::CoordinateAssetDB(DBParams db_params, size_t max_pending_bytes, size_t max_cache_bytes)
+    : CDBWriteBackWrapper(db_params, max_pending_bytes), m_max_cache_bytes{max_cache_bytes} { }
+
+/** Memory held by one cache entry: the list node, its index entry and the asset's heap data */
+static size_t AssetCacheUsage(const CoordinateAsset& asset)
+{
+    const auto string_usage = [](const std::string& str) {
+        return str.capacity() > 15 ? memusage::MallocUsage(str.capacity() + 1) : 0;
+    };
+    return memusage::MallocUsage(sizeof(std::pair<uint256, CoordinateAsset>) + 2 * sizeof(void*)) +
+           memusage::MallocUsage(sizeof(uint256) + 2 * sizeof(void*)) +
+           memusage::DynamicUsage(asset.nID) +
+           string_usage(asset.strTicker) + string_usage(asset.strHeadline) +
+           string_usage(asset.strController) + string_usage(asset.strOwner);
+}
+
+void CoordinateAssetDB::CacheAsset(const uint256& assetHash, const CoordinateAsset& asset)
+{
+    AssertLockHeld(m_cache_mutex);
+    if (auto it = m_cache_index.find(assetHash); it != m_cache_index.end()) {
+        m_cache_bytes -= AssetCacheUsage(it->second->second);
+        m_cache.erase(it->second);
+        m_cache_index.erase(it);
+    }
+    const size_t usage = AssetCacheUsage(asset);
+    if (usage > m_max_cache_bytes) return;
+    while (m_cache_bytes + usage > m_max_cache_bytes) {
+        m_cache_bytes -= AssetCacheUsage(m_cache.back().second);
+        m_cache_index.erase(m_cache.back().first);
+        m_cache.pop_back();
+    }
+    m_cache.emplace_front(assetHash, asset);
+    m_cache_index.emplace(assetHash, m_cache.begin());
+    m_cache_bytes += usage;
+}
+
+bool CoordinateAssetDB::WriteCoordinateAssets(const std::vector<CoordinateAsset>& vAsset)
+{
+    LOCK(m_cache_mutex);
+    ++m_cache_generation;
     for (const CoordinateAsset& asset : vAsset) {
         uint256 assetHash = getAssetHash(asset.nID);
         std::pair<uint8_t, uint256> key = std::make_pair(DB_ASSET, assetHash);
-        batch.Write(key, asset);
+        WriteBuffered(key, asset);
+        CacheAsset(assetHash, asset);
     }
-    return WriteBatch(batch, true);
+    return true;
 }
 
 std::vector<CoordinateAsset> CoordinateAssetDB::GetAssets()
@@ -263,24 +364,43 @@ std::vector<CoordinateAsset> CoordinateAssetDB::GetAssets()
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->Seek(std::make_pair(DB_ASSET, uint256()));
 
-    std::vector<CoordinateAsset> vAsset;
+    std::map<uint256, CoordinateAsset> mapAsset;
 
     while (pcursor->Valid()) {
         std::pair<uint8_t, uint256> key;
         CoordinateAsset asset;
         if (pcursor->GetKey(key) && key.first == DB_ASSET) {
             if (pcursor->GetValue(asset))
-                vAsset.push_back(asset);
+                mapAsset.emplace(key.second, asset);
         }
 
         pcursor->Next();
     }
+
+    // Assets written since the last flush replace the ones on disk
+    for (const auto& [keyData, valueData] : GetPendingWithPrefix(DB_ASSET)) {
+        std::pair<uint8_t, uint256> key;
+        DataStream ssKey{std::span{keyData}};
+        ssKey >> key;
+        if (!valueData) {
+            mapAsset.erase(key.second);
+            continue;
+        }
+        DataStream ssValue{std::span{*valueData}};
+        ssValue >> mapAsset[key.second];
+    }
+
+    std::vector<CoordinateAsset> vAsset;
+    vAsset.reserve(mapAsset.size());
+    for (auto& [assetHash, asset] : mapAsset) {
+        vAsset.push_back(std::move(asset));
+    }
     return vAsset;
 }
 
 bool CoordinateAssetDB::GetLastAssetPruneHeight(uint32_t& nID)
 {
-    if (!Read(DB_ASSET_LAST_PRUNE_HEIGHT, nID))
+    if (!ReadBuffered(DB_ASSET_LAST_PRUNE_HEIGHT, nID))
         return false;
 
     return true;
@@ -288,31 +408,69 @@ bool CoordinateAssetDB::GetLastAssetPruneHeight(uint32_t& nID)
 
 bool CoordinateAssetDB::WriteLastAssetPruneHeight(const uint32_t nID)
 {
-    return Write(DB_ASSET_LAST_PRUNE_HEIGHT, nID);
+    WriteBuffered(DB_ASSET_LAST_PRUNE_HEIGHT, nID);
+    return true;
 }
 
 bool CoordinateAssetDB::GetAsset(uint256 nID, CoordinateAsset& asset)
 {
-    return Read(std::make_pair(DB_ASSET, nID), asset);
+    uint64_t generation;
+    {
+        LOCK(m_cache_mutex);
+        if (auto it = m_cache_index.find(nID); it != m_cache_index.end()) {
+            m_cache.splice(m_cache.begin(), m_cache, it->second);
+            asset = it->second->second;
+            ++m_cache_hits;
+            return true;
+        }
+        ++m_cache_misses;
+        generation = m_cache_generation;
+    }
+
+    if (!ReadBuffered(std::make_pair(DB_ASSET, nID), asset)) {
+        return false;
+    }
+
+    LOCK(m_cache_mutex);
+    if (generation == m_cache_generation) {
+        CacheAsset(nID, asset);
+    }
+    return true;
+}
+
+CoordinateAssetDB::CacheStats CoordinateAssetDB::GetCacheStats() const
+{
+    LOCK(m_cache_mutex);
+    return {m_cache.size(), m_cache_bytes, m_max_cache_bytes, m_cache_hits, m_cache_misses};
 }
 
 bool CoordinateAssetDB::WriteAssetMinedBlock(uint256 blockHash) {
-    CDBBatch batch(*this);
     std::pair<uint8_t, uint256> key = std::make_pair(DB_MINED_ASSET, blockHash);
-    batch.Write(key, blockHash);
-    return WriteBatch(batch, true);
+    WriteBuffered(key, blockHash);
+    return true;
+}
+
+void CoordinateAssetDB::WriteAssetMintBlock(const uint256& blockHash)
+{
+    WriteBuffered(std::make_pair(DB_ASSET_MINT_BLOCK, blockHash), uint8_t{1});
+}
+
+bool CoordinateAssetDB::HaveAssetMintBlock(const uint256& blockHash) const
+{
+    uint8_t value;
+    return ReadBuffered(std::make_pair(DB_ASSET_MINT_BLOCK, blockHash), value);
 }
 
 bool CoordinateAssetDB::getAssetMinedBlock(uint256 blockHash) {
     uint256 hash;
-    if(Read(std::make_pair(DB_MINED_ASSET, blockHash), hash)) {
+    if(ReadBuffered(std::make_pair(DB_MINED_ASSET, blockHash), hash)) {
         return true;
     }
     return false;
 }
 
-SignedBlocksDB::SignedBlocksDB(DBParams db_params)
-    : CDBWrapper(db_params) { }
+SignedBlocksDB::SignedBlocksDB(DBParams db_params, size_t max_pending_bytes)
+    : CDBWriteBackWrapper(db_params, max_pending_bytes) { }
 
 bool SignedBlocksDB::WriteLastSignedBlockID(const uint64_t nHeight)
 {
@@ -340,50 +498,79 @@ bool SignedBlocksDB::GetLastSignedBlockHash(uint256& blockHash)
     return true;
 }
 
-bool SignedBlocksDB::WriteSignedBlockHash(const std::vector<uint256>& signedBlockHashes, uint256 blockHash)
+bool SignedBlocksDB::WriteSignedBlockHash(const std::vector<std::pair<uint64_t, uint256>>& signedBlockHashes, uint256 blockHash)
 {
-    CDBBatch batch(*this);
-    for (const uint256& signedBlockHash : signedBlockHashes) {
+    for (const auto& [signedBlockHeight, signedBlockHash] : signedBlockHashes) {
         std::pair<uint8_t, uint256> key = std::make_pair(DB_SIGNED_BLOCK_HASH, signedBlockHash);
-        batch.Write(key, blockHash);
+        WriteBuffered(key, blockHash);
+        WriteBuffered(std::make_pair(DB_SIGNED_BLOCK_HEIGHT, signedBlockHeight), signedBlockHash);
     }
-    return WriteBatch(batch, true);
+    return true;
 }
 
 bool SignedBlocksDB::GetSignedBlockHash(const uint256 signedBlockHashes, uint256& blockHash)
 {
-    return Read(std::make_pair(DB_SIGNED_BLOCK_HASH, signedBlockHashes), blockHash);
+    return ReadBuffered(std::make_pair(DB_SIGNED_BLOCK_HASH, signedBlockHashes), blockHash);
+}
+
+bool SignedBlocksDB::GetSignedBlockHashByHeight(const uint64_t nHeight, uint256& signedBlockHash)
+{
+    return ReadBuffered(std::make_pair(DB_SIGNED_BLOCK_HEIGHT, nHeight), signedBlockHash);
+}
+
+bool SignedBlocksDB::IsHeightIndexComplete()
+{
+    return Exists(DB_SIGNED_BLOCK_HEIGHT_COMPLETE);
+}
+
+bool SignedBlocksDB::WriteHeightIndexComplete()
+{
+    return Flush() && Write(DB_SIGNED_BLOCK_HEIGHT_COMPLETE, uint8_t{1}, /*fSync=*/true);
+}
+
+std::set<uint256> SignedBlocksDB::GetSignedBlockMinedBlocks()
+{
+    std::set<uint256> minedBlocks;
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(std::make_pair(DB_SIGNED_BLOCK_HASH, uint256()));
+    while (pcursor->Valid()) {
+        std::pair<uint8_t, uint256> key;
+        uint256 blockHash;
+        if (!pcursor->GetKey(key) || key.first != DB_SIGNED_BLOCK_HASH || !pcursor->GetValue(blockHash)) break;
+        minedBlocks.insert(blockHash);
+        pcursor->Next();
+    }
+    return minedBlocks;
 }
 
 bool SignedBlocksDB::WriteInvalidTx(const std::vector<InvalidTx>& invalidTxs){
-    CDBBatch batch(*this);
     for (const InvalidTx& invalidTx : invalidTxs) {
         std::pair<uint8_t, uint64_t> key = std::make_pair(DB_BLOCK_INVALID_TX, invalidTx.nHeight);
-        batch.Write(key, invalidTx);
+        WriteBuffered(key, invalidTx);
     }
-    return WriteBatch(batch, true);
+    return true;
 }
 
 bool SignedBlocksDB::DeleteInvalidTx(const uint64_t nHeight){
     std::pair<uint8_t, uint64_t> key = std::make_pair(DB_BLOCK_INVALID_TX, nHeight);
-    return Erase(key);
+    EraseBuffered(key);
+    return true;
 }
 
 bool SignedBlocksDB::GetInvalidTx(const uint64_t nHeight, InvalidTx& invalidTx)
 {
-    return Read(std::make_pair(DB_BLOCK_INVALID_TX, nHeight), invalidTx);
+    return ReadBuffered(std::make_pair(DB_BLOCK_INVALID_TX, nHeight), invalidTx);
 }
 
 bool SignedBlocksDB::WriteTxPosition(const SignedTxindex& signedTx, uint256 txHash){
-    CDBBatch batch(*this);
     std::pair<uint8_t, uint256> key = std::make_pair(DB_SIGNED_BLOCK_TX, txHash);
-    batch.Write(key, signedTx);
-    return WriteBatch(batch, true);
+    WriteBuffered(key, signedTx);
+    return true;
 }
 
 bool SignedBlocksDB::getTxPosition(const uint256 txHash, SignedTxindex& txIndex)
 {
-    return Read(std::make_pair(DB_SIGNED_BLOCK_TX, txHash), txIndex);
+    return ReadBuffered(std::make_pair(DB_SIGNED_BLOCK_TX, txHash), txIndex);
 }
 
 bool SignedBlocksDB::WriteDepositAddress(const CoordinateAddress& coordinateAddressObj, std::string address){
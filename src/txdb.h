@@ -11,11 +11,16 @@
 #include <kernel/cs_main.h>
 #include <sync.h>
 #include <util/fs.h>
+#include <util/hasher.h>
 
 #include <cstddef>
 #include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
 #include <optional>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <coordinate/coordinate_assets.h>
@@ -66,30 +71,139 @@ public:
     std::optional<fs::path> StoragePath() { return m_db->StoragePath(); }
 };
 
-/** Access to the CoordinateAsset database (blocks/CoordinateAssets/) */
-class CoordinateAssetDB : public CDBWrapper
+/**
+ * CDBWrapper which keeps block related writes in memory until Flush(), so
+ * they are committed in one batch together with the coins database instead
+ * of syncing on every write. Buffered reads see the pending writes.
+ */
+class CDBWriteBackWrapper : public CDBWrapper
+{
+private:
+    mutable Mutex m_pending_mutex;
+    //! Serialized key to serialized value, or nullopt for a pending erase
+    std::map<std::vector<std::byte>, std::optional<std::vector<std::byte>>> m_pending GUARDED_BY(m_pending_mutex);
+    size_t m_pending_bytes GUARDED_BY(m_pending_mutex){0};
+    //! Pending size above which the chainstate should be flushed, see Chainstate::GetCoinsCacheSizeState
+    const size_t m_max_pending_bytes;
+
+    void SetPending(std::vector<std::byte>&& key, std::optional<std::vector<std::byte>>&& value) EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    //! nullopt if the key has no pending change, otherwise the pending value (nullopt for an erase)
+    std::optional<std::optional<std::vector<std::byte>>> GetPending(const std::vector<std::byte>& key) const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+
+    template <typename T>
+    static std::vector<std::byte> SerializeToBytes(const T& obj)
+    {
+        DataStream ss{};
+        ss << obj;
+        return {ss.begin(), ss.end()};
+    }
+
+protected:
+    template <typename K, typename V>
+    void WriteBuffered(const K& key, const V& value) EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex)
+    {
+        SetPending(SerializeToBytes(key), SerializeToBytes(value));
+    }
+
+    template <typename K>
+    void EraseBuffered(const K& key) EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex)
+    {
+        SetPending(SerializeToBytes(key), std::nullopt);
+    }
+
+    template <typename K, typename V>
+    bool ReadBuffered(const K& key, V& value) const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex)
+    {
+        const auto pending{GetPending(SerializeToBytes(key))};
+        if (!pending) return Read(key, value);
+        if (!*pending) return false;
+        try {
+            DataStream ss{std::span{**pending}};
+            ss >> value;
+        } catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    //! Pending values of all keys starting with prefix, nullopt for pending erases
+    std::vector<std::pair<std::vector<std::byte>, std::optional<std::vector<std::byte>>>> GetPendingWithPrefix(uint8_t prefix) const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+
+public:
+    CDBWriteBackWrapper(const DBParams& db_params, size_t max_pending_bytes);
+
+    //! Write all pending changes to disk in a single synced batch.
+    bool Flush() EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    //! Approximate memory used by the pending changes.
+    size_t PendingBytes() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+    //! Whether the pending changes outgrew their budget.
+    bool ShouldFlush() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex) { return PendingBytes() > m_max_pending_bytes; }
+};
+
+/** Access to the CoordinateAsset database (blocks/CoordinateAssets/)
+ *
+ * Deserialized assets are kept in a least recently used cache of at most
+ * max_cache_bytes in front of the database. Writes go through the cache so it
+ * never holds an older version than the database.
+ */
+class CoordinateAssetDB : public CDBWriteBackWrapper
 {
 public:
-    CoordinateAssetDB(DBParams db_params);
+    struct CacheStats {
+        size_t entries;
+        size_t usage;
+        size_t max_usage;
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    CoordinateAssetDB(DBParams db_params, size_t max_pending_bytes, size_t max_cache_bytes);
     bool WriteCoordinateAssets(const std::vector<CoordinateAsset>& vAsset);
     std::vector<CoordinateAsset> GetAssets();
     bool GetAsset(uint256 nID, CoordinateAsset& asset);
     bool WriteAssetMinedBlock(uint256 blockHash);
     bool getAssetMinedBlock(uint256 blockHash);
+    //! Record that the additional mints of a block are included in the stored asset supplies.
+    //! Buffered with the asset writes of the block, so both reach the disk together.
+    void WriteAssetMintBlock(const uint256& blockHash);
+    bool HaveAssetMintBlock(const uint256& blockHash) const;
     bool GetLastAssetPruneHeight(uint32_t& nID);
     bool WriteLastAssetPruneHeight(const uint32_t nID);
+    CacheStats GetCacheStats() const EXCLUSIVE_LOCKS_REQUIRED(!m_cache_mutex);
+
+private:
+    using CacheList = std::list<std::pair<uint256, CoordinateAsset>>;
+
+    void CacheAsset(const uint256& assetHash, const CoordinateAsset& asset) EXCLUSIVE_LOCKS_REQUIRED(m_cache_mutex);
+
+    const size_t m_max_cache_bytes;
+    mutable Mutex m_cache_mutex;
+    //! Most recently used first
+    CacheList m_cache GUARDED_BY(m_cache_mutex);
+    std::unordered_map<uint256, CacheList::iterator, BlockHasher> m_cache_index GUARDED_BY(m_cache_mutex);
+    size_t m_cache_bytes GUARDED_BY(m_cache_mutex){0};
+    //! Bumped by every write, so a lookup racing a write does not cache what it read before it
+    uint64_t m_cache_generation GUARDED_BY(m_cache_mutex){0};
+    uint64_t m_cache_hits GUARDED_BY(m_cache_mutex){0};
+    uint64_t m_cache_misses GUARDED_BY(m_cache_mutex){0};
 };
 
 /** Access to the signed blocks database (blocks/signedblocks/) */
-class SignedBlocksDB : public CDBWrapper {
+class SignedBlocksDB : public CDBWriteBackWrapper {
 public:
-    SignedBlocksDB(DBParams db_params);
+    SignedBlocksDB(DBParams db_params, size_t max_pending_bytes);
     bool GetLastSignedBlockID(uint64_t& nHeight);
     bool WriteLastSignedBlockID(const uint64_t nHeight);
     bool GetLastSignedBlockHash(uint256& blockHash);
     bool WriteLastSignedBlockHash(const uint256 blockHash);
-    bool WriteSignedBlockHash(const std::vector<uint256>& signedBlockHashes, uint256 blockHash);
+    bool WriteSignedBlockHash(const std::vector<std::pair<uint64_t, uint256>>& signedBlockHashes, uint256 blockHash);
     bool GetSignedBlockHash(const uint256 signedBlockHashes, uint256& blockHash);
+    bool GetSignedBlockHashByHeight(const uint64_t nHeight, uint256& signedBlockHash);
+    //! Whether every signed block hash entry has its height entry, which older versions did not write
+    bool IsHeightIndexComplete();
+    bool WriteHeightIndexComplete();
+    //! Hashes of the mined blocks that included the signed blocks on disk
+    std::set<uint256> GetSignedBlockMinedBlocks();
     bool WriteInvalidTx(const std::vector<InvalidTx>& invalidTxs);
     bool GetInvalidTx(const uint64_t nHeight, InvalidTx& invalidTx);
     bool DeleteInvalidTx(const uint64_t nHeight);
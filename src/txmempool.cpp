@@ -512,6 +512,10 @@ void CTxMemPool::addNewTransaction(CTxMemPool::txiter newit, CTxMemPool::setEntr
     txns_randomized.emplace_back(newit->GetSharedTx());
     newit->idx_randomized = txns_randomized.size() - 1;
 
+    if (is_preconf) {
+        m_preconf_by_fee_rate.insert(newit);
+    }
+
     TRACEPOINT(mempool, added,
         entry.GetTx().GetHash().data(),
         entry.GetTxSize(),
@@ -560,6 +564,9 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     m_total_fee -= it->GetFee();
     cachedInnerUsage -= it->DynamicMemoryUsage();
     cachedInnerUsage -= memusage::DynamicUsage(it->GetMemPoolParentsConst()) + memusage::DynamicUsage(it->GetMemPoolChildrenConst());
+    if (is_preconf) {
+        m_preconf_by_fee_rate.erase(it);
+    }
     mapTx.erase(it);
     nTransactionsUpdated++;
 }
@@ -829,6 +836,7 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
     assert(totalTxSize == checkTotal);
     assert(m_total_fee == check_total_fee);
     assert(innerUsage == cachedInnerUsage);
+    assert(m_preconf_by_fee_rate.size() == (is_preconf ? mapTx.size() : 0));
 }
 
 bool CTxMemPool::CompareDepthAndScore(const Wtxid& hasha, const Wtxid& hashb) const
@@ -887,6 +895,13 @@ std::vector<CTxMemPoolEntryRef> CTxMemPool::entryAll() const
 
     std::vector<CTxMemPoolEntryRef> ret;
     ret.reserve(mapTx.size());
+    if (is_preconf) {
+        // Preconf transactions are picked for signed blocks by the preconf fee they bid, highest first
+        for (auto it = m_preconf_by_fee_rate.rbegin(); it != m_preconf_by_fee_rate.rend(); ++it) {
+            ret.emplace_back(**it);
+        }
+        return ret;
+    }
     for (const auto& it : GetSortedDepthAndScore()) {
         ret.emplace_back(*it);
     }
@@ -896,11 +911,15 @@ std::vector<CTxMemPoolEntryRef> CTxMemPool::entryAll() const
 std::vector<TxMempoolInfo> CTxMemPool::infoAll() const
 {
     LOCK(cs);
-    auto iters = GetSortedDepthAndScore();
-
     std::vector<TxMempoolInfo> ret;
     ret.reserve(mapTx.size());
-    for (auto it : iters) {
+    if (is_preconf) {
+        for (auto it = m_preconf_by_fee_rate.rbegin(); it != m_preconf_by_fee_rate.rend(); ++it) {
+            ret.push_back(GetInfo(*it));
+        }
+        return ret;
+    }
+    for (auto it : GetSortedDepthAndScore()) {
         ret.push_back(GetInfo(it));
     }
 
@@ -1083,7 +1102,7 @@ void CCoinsViewMemPool::Reset()
 size_t CTxMemPool::DynamicMemoryUsage() const {
     LOCK(cs);
     // Estimate the overhead of mapTx to be 15 pointers + an allocation, as no exact formula for boost::multi_index_contained is implemented.
-    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 15 * sizeof(void*)) * mapTx.size() + memusage::DynamicUsage(mapNextTx) + memusage::DynamicUsage(mapDeltas) + memusage::DynamicUsage(txns_randomized) + cachedInnerUsage;
+    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 15 * sizeof(void*)) * mapTx.size() + memusage::DynamicUsage(mapNextTx) + memusage::DynamicUsage(mapDeltas) + memusage::DynamicUsage(txns_randomized) + memusage::DynamicUsage(m_preconf_by_fee_rate) + cachedInnerUsage;
 }
 
 void CTxMemPool::RemoveUnbroadcastTx(const uint256& txid, const bool unchecked) {
@@ -1139,6 +1158,49 @@ int CTxMemPool::PreconfExpire(uint64_t expireHeight)
 }
 
 
+void CTxMemPool::TrimPreConfToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpendsRemaining)
+{
+    AssertLockHeld(cs);
+    Assume(!m_have_changeset);
+
+    unsigned nTxnRemoved = 0;
+    while (!m_preconf_by_fee_rate.empty() && DynamicMemoryUsage() > sizelimit) {
+        setEntries stage;
+        CalculateDescendants(*m_preconf_by_fee_rate.begin(), stage);
+        nTxnRemoved += stage.size();
+
+        std::vector<CTransaction> txn;
+        if (pvNoSpendsRemaining) {
+            txn.reserve(stage.size());
+            for (txiter iter : stage)
+                txn.push_back(iter->GetTx());
+        }
+        RemoveStaged(stage, false, MemPoolRemovalReason::SIZELIMIT);
+        if (pvNoSpendsRemaining) {
+            for (const CTransaction& tx : txn) {
+                for (const CTxIn& txin : tx.vin) {
+                    if (exists(txin.prevout.hash)) continue;
+                    pvNoSpendsRemaining->push_back(txin.prevout);
+                }
+            }
+        }
+    }
+
+    if (nTxnRemoved > 0) {
+        LogDebug(BCLog::MEMPOOL, "Removed %u preconf txn with the lowest preconf fee rate\n", nTxnRemoved);
+    }
+}
+
+bool CTxMemPool::IsPreConfFeeRateAccepted(CAmount preconf_fee, int32_t vsize) const
+{
+    AssertLockHeld(cs);
+    if (m_preconf_by_fee_rate.empty() || DynamicMemoryUsage() < (size_t)m_opts.max_size_bytes) {
+        return true;
+    }
+    const CTxMemPoolEntry& lowest = **m_preconf_by_fee_rate.begin();
+    return (double)preconf_fee * lowest.GetTxSize() > (double)lowest.GetPreConfFee() * vsize;
+}
+
 void CTxMemPool::UpdateChild(txiter entry, txiter child, bool add)
 {
     AssertLockHeld(cs);
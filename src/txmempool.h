@@ -145,6 +145,30 @@ public:
     }
 };
 
+/** Sort by the preconf fee bid per virtual byte, lowest first */
+class CompareTxMemPoolEntryByPreConfFeeRate
+{
+public:
+    bool operator()(const CTxMemPoolEntry& a, const CTxMemPoolEntry& b) const
+    {
+        double f1 = (double)a.GetPreConfFee() * b.GetTxSize();
+        double f2 = (double)b.GetPreConfFee() * a.GetTxSize();
+        if (f1 == f2) {
+            return a.GetTx().GetHash() < b.GetTx().GetHash();
+        }
+        return f1 < f2;
+    }
+};
+
+/** Sort mempool iterators by the preconf fee bid per virtual byte, lowest first */
+struct CompareIteratorByPreConfFeeRate {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const
+    {
+        return CompareTxMemPoolEntryByPreConfFeeRate()(*a, *b);
+    }
+};
+
 class CompareTxMemPoolEntryByEntryTime
 {
 public:
@@ -388,6 +412,9 @@ public:
 
     typedef std::set<txiter, CompareIteratorByHash> setEntries;
 
+    //! Preconf pool entries by preconf fee rate, lowest first. Only kept for the preconf pool.
+    std::set<txiter, CompareIteratorByPreConfFeeRate> m_preconf_by_fee_rate GUARDED_BY(cs);
+
     using Limits = kernel::MemPoolLimits;
 
     uint64_t CalculateDescendantMaximum(txiter entry) const EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -607,6 +634,16 @@ public:
 
      /** Expire all preconf transaction (and their dependencies) in the mempool older than time. Return the number of removed transactions. */
     int PreconfExpire(uint64_t height) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    /** Remove preconf transactions with the lowest preconf fee rate (and their descendants) until the pool is below sizelimit.
+     *  pvNoSpendsRemaining, if set, will be populated with the list of outpoints
+     *  which are not in mempool which no longer have any spends in this mempool.
+     */
+    void TrimPreConfToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpendsRemaining = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    /** Whether a preconf transaction bidding preconf_fee for vsize virtual bytes can enter the pool: always while it
+     *  is below its size limit, otherwise only if it outbids the lowest preconf fee rate in the pool. */
+    bool IsPreConfFeeRateAccepted(CAmount preconf_fee, int32_t vsize) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     
 
     /**
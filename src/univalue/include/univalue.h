@@ -9,6 +9,7 @@
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <stdexcept>
 #include <string>
@@ -109,9 +110,12 @@ private:
 
     void checkType(const VType& expected) const;
     bool findKey(const std::string& key, size_t& retIdx) const;
+    void write(unsigned int prettyIndent, unsigned int indentLevel, std::string& s) const;
     void writeArray(unsigned int prettyIndent, unsigned int indentLevel, std::string& s) const;
     void writeObject(unsigned int prettyIndent, unsigned int indentLevel, std::string& s) const;
 
+    friend class UniValueWriter;
+
 public:
     // Strict type-specific getters, these throw std::runtime_error if the
     // value is of unexpected type
@@ -149,6 +153,45 @@ Int UniValue::getInt() const
     return result;
 }
 
+/** Incremental compact JSON writer.
+ *
+ * Output is collected in a buffer that is passed to the sink whenever it
+ * reaches flushSize bytes, and once more on flush(), so a large document is
+ * never held as a single string. Documents can be written from UniValue
+ * trees, from begin/end calls and keys, or a mix of both.
+ */
+class UniValueWriter {
+public:
+    using Sink = std::function<void(std::string_view)>;
+
+    static constexpr size_t DEFAULT_FLUSH_SIZE{64 << 10};
+
+    explicit UniValueWriter(Sink sink, size_t flushSize = DEFAULT_FLUSH_SIZE)
+        : m_sink{std::move(sink)}, m_flush_size{flushSize} {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view key);
+    void value(const UniValue& val);
+
+    /** Pass any buffered output to the sink. */
+    void flush();
+
+private:
+    Sink m_sink;
+    const size_t m_flush_size;
+    std::string m_buffer;
+    /** Whether the innermost open array or object has no elements yet. */
+    std::vector<bool> m_first;
+    bool m_after_key{false};
+
+    void separator();
+    void maybeFlush();
+    void writeValue(const UniValue& val);
+};
+
 enum jtokentype {
     JTOK_ERR        = -1,
     JTOK_NONE       = 0,                           // eof
@@ -5,17 +5,13 @@
 #include <univalue.h>
 #include <univalue_escapes.h>
 
-#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
-static std::string json_escape(const std::string& inS)
+static void json_escape(std::string_view inS, std::string& outS)
 {
-    std::string outS;
-    outS.reserve(inS.size() * 2);
-
-    for (unsigned int i = 0; i < inS.size(); i++) {
-        unsigned char ch = static_cast<unsigned char>(inS[i]);
+    for (unsigned char ch : inS) {
         const char *escStr = escapes[ch];
 
         if (escStr)
@@ -23,17 +19,28 @@ static std::string json_escape(const std::string& inS)
         else
             outS += static_cast<char>(ch);
     }
+}
 
-    return outS;
+static void writeString(std::string_view str, std::string& s)
+{
+    s += '"';
+    json_escape(str, s);
+    s += '"';
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
 std::string UniValue::write(unsigned int prettyIndent,
                             unsigned int indentLevel) const
 {
     std::string s;
     s.reserve(1024);
+    write(prettyIndent, indentLevel, s);
+    return s;
+}
 
+// NOLINTNEXTLINE(misc-no-recursion)
+void UniValue::write(unsigned int prettyIndent,
+                     unsigned int indentLevel, std::string& s) const
+{
     unsigned int modIndent = indentLevel;
     if (modIndent == 0)
         modIndent = 1;
@@ -49,7 +56,7 @@ std::string UniValue::write(unsigned int prettyIndent,
         writeArray(prettyIndent, modIndent, s);
         break;
     case VSTR:
-        s += "\"" + json_escape(val) + "\"";
+        writeString(val, s);
         break;
     case VNUM:
         s += val;
@@ -58,8 +65,6 @@ std::string UniValue::write(unsigned int prettyIndent,
         s += (val == "1" ? "true" : "false");
         break;
     }
-
-    return s;
 }
 
 static void indentStr(unsigned int prettyIndent, unsigned int indentLevel, std::string& s)
@@ -77,7 +82,7 @@ void UniValue::writeArray(unsigned int prettyIndent, unsigned int indentLevel, s
     for (unsigned int i = 0; i < values.size(); i++) {
         if (prettyIndent)
             indentStr(prettyIndent, indentLevel, s);
-        s += values[i].write(prettyIndent, indentLevel + 1);
+        values[i].write(prettyIndent, indentLevel + 1, s);
         if (i != (values.size() - 1)) {
             s += ",";
         }
@@ -100,10 +105,11 @@ void UniValue::writeObject(unsigned int prettyIndent, unsigned int indentLevel,
     for (unsigned int i = 0; i < keys.size(); i++) {
         if (prettyIndent)
             indentStr(prettyIndent, indentLevel, s);
-        s += "\"" + json_escape(keys[i]) + "\":";
+        writeString(keys[i], s);
+        s += ":";
         if (prettyIndent)
             s += " ";
-        s += values.at(i).write(prettyIndent, indentLevel + 1);
+        values.at(i).write(prettyIndent, indentLevel + 1, s);
         if (i != (values.size() - 1))
             s += ",";
         if (prettyIndent)
@@ -115,3 +121,102 @@ void UniValue::writeObject(unsigned int prettyIndent, unsigned int indentLevel,
     s += "}";
 }
 
+void UniValueWriter::separator()
+{
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (m_first.empty()) return;
+    if (!m_first.back())
+        m_buffer += ",";
+    m_first.back() = false;
+}
+
+void UniValueWriter::maybeFlush()
+{
+    if (m_buffer.size() >= m_flush_size)
+        flush();
+}
+
+void UniValueWriter::flush()
+{
+    if (m_buffer.empty()) return;
+    m_sink(m_buffer);
+    m_buffer.clear();
+}
+
+void UniValueWriter::beginObject()
+{
+    separator();
+    m_buffer += "{";
+    m_first.push_back(true);
+}
+
+void UniValueWriter::endObject()
+{
+    m_buffer += "}";
+    m_first.pop_back();
+    maybeFlush();
+}
+
+void UniValueWriter::beginArray()
+{
+    separator();
+    m_buffer += "[";
+    m_first.push_back(true);
+}
+
+void UniValueWriter::endArray()
+{
+    m_buffer += "]";
+    m_first.pop_back();
+    maybeFlush();
+}
+
+void UniValueWriter::key(std::string_view key)
+{
+    separator();
+    writeString(key, m_buffer);
+    m_buffer += ":";
+    m_after_key = true;
+}
+
+void UniValueWriter::value(const UniValue& val)
+{
+    separator();
+    writeValue(val);
+    maybeFlush();
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void UniValueWriter::writeValue(const UniValue& val)
+{
+    switch (val.typ) {
+    case UniValue::VOBJ:
+        m_buffer += "{";
+        for (size_t i = 0; i < val.keys.size(); i++) {
+            if (i != 0)
+                m_buffer += ",";
+            writeString(val.keys[i], m_buffer);
+            m_buffer += ":";
+            writeValue(val.values[i]);
+            maybeFlush();
+        }
+        m_buffer += "}";
+        break;
+    case UniValue::VARR:
+        m_buffer += "[";
+        for (size_t i = 0; i < val.values.size(); i++) {
+            if (i != 0)
+                m_buffer += ",";
+            writeValue(val.values[i]);
+            maybeFlush();
+        }
+        m_buffer += "]";
+        break;
+    default:
+        val.write(0, 0, m_buffer);
+        break;
+    }
+}
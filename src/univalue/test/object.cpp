@@ -455,6 +455,43 @@ void univalue_readwrite()
     BOOST_CHECK(!v.read("{} 42"));
 }
 
+void univalue_writer()
+{
+    UniValue v;
+    BOOST_CHECK(v.read(json1));
+
+    // Any flush size, including flushing after every element, produces the
+    // same document as write().
+    for (size_t flush_size : {size_t{1}, size_t{16}, UniValueWriter::DEFAULT_FLUSH_SIZE}) {
+        std::string out;
+        size_t chunks{0};
+        UniValueWriter writer{[&](std::string_view chunk) { out += chunk; ++chunks; }, flush_size};
+        writer.value(v);
+        writer.flush();
+        BOOST_CHECK_EQUAL(out, v.write());
+        BOOST_CHECK(flush_size > out.size() ? chunks == 1 : chunks > 1);
+    }
+
+    // Mixing begin/end calls and keys with values
+    std::string out;
+    UniValueWriter writer{[&](std::string_view chunk) { out += chunk; }};
+    writer.beginObject();
+    writer.key("result");
+    writer.beginArray();
+    writer.value(v[0]);
+    writer.value(v[1]);
+    writer.beginObject();
+    writer.endObject();
+    writer.endArray();
+    writer.key("error");
+    writer.value(NullUniValue);
+    writer.key("id\"");
+    writer.value(1);
+    writer.endObject();
+    writer.flush();
+    BOOST_CHECK_EQUAL(out, "{\"result\":[1.10000000,{\"key1\":\"str\\u0000\",\"key2\":800,\"key3\":{\"name\":\"martian http://test.com\"}},{}],\"error\":null,\"id\\\"\":1}");
+}
+
 int main(int argc, char* argv[])
 {
     univalue_constructor();
@@ -464,5 +501,6 @@ int main(int argc, char* argv[])
     univalue_array();
     univalue_object();
     univalue_readwrite();
+    univalue_writer();
     return 0;
 }
@@ -19,6 +19,10 @@
 #include <poll.h>
 #endif
 
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 static inline bool IOErrorIsPermanent(int err)
 {
     return err != WSAEAGAIN && err != WSAEINTR && err != WSAEWOULDBLOCK && err != WSAEINPROGRESS;
@@ -242,6 +246,107 @@ bool Sock::WaitMany(std::chrono::milliseconds timeout, EventsPerSock& events_per
 #endif /* USE_POLL */
 }
 
+std::unique_ptr<SockWaitSet> SockWaitSet::Make()
+{
+#ifdef USE_EPOLL
+    const int fd{epoll_create1(EPOLL_CLOEXEC)};
+    if (fd == -1) {
+        LogPrintf("Could not create epoll instance: %s\n", NetworkErrorString(errno));
+        return nullptr;
+    }
+    return std::unique_ptr<SockWaitSet>{new SockWaitSet{fd}};
+#else
+    return nullptr;
+#endif /* USE_EPOLL */
+}
+
+SockWaitSet::~SockWaitSet()
+{
+#ifdef USE_EPOLL
+    close(m_fd);
+#endif
+}
+
+bool SockWaitSet::Update(const Sock::EventsPerSock& events_per_sock)
+{
+#ifdef USE_EPOLL
+    // Level-triggered on purpose: the caller may leave data unread or unsent until a
+    // later wait (paused receiving, flow control), which edge-triggered would not report.
+    const auto to_epoll = [](Sock::Event requested) {
+        uint32_t events{0};
+        if (requested & Sock::RECV) events |= EPOLLIN;
+        if (requested & Sock::SEND) events |= EPOLLOUT;
+        return events;
+    };
+
+    ++m_update;
+    for (const auto& [sock, events] : events_per_sock) {
+        const auto [it, inserted] = m_registered.try_emplace(sock->m_socket, Registration{sock, events.requested, m_update});
+        if (!inserted) {
+            it->second.update = m_update;
+            if (it->second.requested == events.requested) continue;
+            it->second.requested = events.requested;
+        }
+        epoll_event event{};
+        event.events = to_epoll(events.requested);
+        event.data.fd = sock->m_socket;
+        if (epoll_ctl(m_fd, inserted ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, sock->m_socket, &event) == -1) {
+            LogPrintf("Could not register socket with epoll: %s\n", NetworkErrorString(errno));
+            m_registered.erase(it);
+            return false;
+        }
+    }
+
+    // Unregister the sockets the caller does not wait on anymore, releasing them.
+    if (m_registered.size() > events_per_sock.size()) {
+        for (auto it = m_registered.begin(); it != m_registered.end();) {
+            if (it->second.update == m_update) {
+                ++it;
+                continue;
+            }
+            epoll_ctl(m_fd, EPOLL_CTL_DEL, it->first, nullptr);
+            it = m_registered.erase(it);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif /* USE_EPOLL */
+}
+
+bool SockWaitSet::Wait(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock)
+{
+#ifdef USE_EPOLL
+    // Sockets that are still ready beyond this many are reported by the next wait, the
+    // kernel rotates the ready list so that every one of them is served in turn.
+    static constexpr size_t MAX_READY{1024};
+    std::vector<epoll_event> ready(std::clamp<size_t>(m_registered.size(), 1, MAX_READY));
+    const int num_ready{epoll_wait(m_fd, ready.data(), ready.size(), count_milliseconds(timeout))};
+    if (num_ready == -1) {
+        return false;
+    }
+
+    for (int i = 0; i < num_ready; ++i) {
+        const auto registered = m_registered.find(ready[i].data.fd);
+        if (registered == m_registered.end()) continue;
+        const auto it = events_per_sock.find(registered->second.sock);
+        if (it == events_per_sock.end()) continue;
+        if (ready[i].events & EPOLLIN) {
+            it->second.occurred |= Sock::RECV;
+        }
+        if (ready[i].events & EPOLLOUT) {
+            it->second.occurred |= Sock::SEND;
+        }
+        if (ready[i].events & (EPOLLERR | EPOLLHUP)) {
+            it->second.occurred |= Sock::ERR;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif /* USE_EPOLL */
+}
+
 void Sock::SendComplete(std::span<const unsigned char> data,
                         std::chrono::milliseconds timeout,
                         CThreadInterrupt& interrupt) const
@@ -10,6 +10,7 @@
 #include <util/time.h>
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -275,12 +276,67 @@ protected:
     SOCKET m_socket;
 
 private:
+    friend class SockWaitSet;
+
     /**
      * Close `m_socket` if it is not `INVALID_SOCKET`.
      */
     void Close();
 };
 
+/**
+ * Sockets that stay registered with the kernel between waits, for a caller that waits
+ * on mostly the same large set of sockets over and over. Unlike `Sock::WaitMany()`, a
+ * wait does not hand the whole set to the kernel again, and it costs time in the number
+ * of ready sockets rather than of registered ones. Only works with sockets that are
+ * backed by a real file descriptor, and only where epoll(7) is available.
+ */
+class SockWaitSet
+{
+public:
+    /**
+     * Create an empty set.
+     * @return nullptr if it is not supported on this platform or could not be created.
+     */
+    static std::unique_ptr<SockWaitSet> Make();
+
+    ~SockWaitSet();
+
+    SockWaitSet(const SockWaitSet&) = delete;
+    SockWaitSet& operator=(const SockWaitSet&) = delete;
+
+    /**
+     * Make the registered sockets and their requested events those of `events_per_sock`.
+     * Only sockets that are new, changed or gone take a system call. The set holds a
+     * `shared_ptr` to each registered socket, so it stays open until it is unregistered.
+     * @return false if a socket could not be registered, the set should not be used then.
+     */
+    [[nodiscard]] bool Update(const Sock::EventsPerSock& events_per_sock);
+
+    /**
+     * Same as `Sock::WaitMany()` on the sockets passed to the last `Update()`, which
+     * must be `events_per_sock`. Only the `occurred` events of ready sockets are set, the
+     * others are left as they were.
+     */
+    [[nodiscard]] bool Wait(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock);
+
+private:
+    explicit SockWaitSet(int fd) : m_fd{fd} {}
+
+    struct Registration {
+        std::shared_ptr<const Sock> sock;
+        Sock::Event requested;
+        uint64_t update;
+    };
+
+    /** The epoll(7) instance. */
+    const int m_fd;
+
+    /** Registered sockets by descriptor, with the `Update()` that last saw them. */
+    std::unordered_map<SOCKET, Registration> m_registered;
+    uint64_t m_update{0};
+};
+
 /** Return readable error string for a network error code */
 std::string NetworkErrorString(int err);
 
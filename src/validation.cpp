@@ -55,11 +55,13 @@
 #include <util/fs_helpers.h>
 #include <util/hasher.h>
 #include <util/moneystr.h>
+#include <util/overloaded.h>
 #include <util/rbf.h>
 #include <util/result.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/string.h>
+#include <util/thread.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <util/translation.h>
@@ -68,13 +70,17 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <functional>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 
 #include <coordinate/anduro_deposit.h>
@@ -286,7 +292,12 @@ static void LimitMempoolSize(CTxMemPool& pool, CCoinsViewCache& coins_cache)
     }
 
     std::vector<COutPoint> vNoSpendsRemaining;
-    pool.TrimToSize(pool.m_opts.max_size_bytes, &vNoSpendsRemaining);
+    if (pool.is_preconf) {
+        // Preconf transactions compete on the preconf fee they bid, not on the transaction fee
+        pool.TrimPreConfToSize(pool.m_opts.max_size_bytes, &vNoSpendsRemaining);
+    } else {
+        pool.TrimToSize(pool.m_opts.max_size_bytes, &vNoSpendsRemaining);
+    }
     for (const COutPoint& removed : vNoSpendsRemaining)
         coins_cache.Uncache(removed);
 }
@@ -401,6 +412,15 @@ void Chainstate::MaybeUpdateMempoolForReorg(
     LimitMempoolSize(*m_mempool, this->CoinsTip());
 }
 
+/** Script execution cache key for tx's input scripts verified with flags. */
+static uint256 ScriptExecutionCacheEntry(const ValidationCache& validation_cache, const CTransaction& tx, unsigned int flags)
+{
+    uint256 hashCacheEntry;
+    CSHA256 hasher = validation_cache.ScriptExecutionCacheHasher();
+    hasher.Write(UCharCast(tx.GetWitnessHash().begin()), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+    return hashCacheEntry;
+}
+
 /**
 * Checks to avoid mempool polluting consensus critical paths since cached
 * signature and script validity results will be reused if we validate this
@@ -881,6 +901,13 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
         return state.Invalid(TxValidationResult::TX_CONFLICT, "txn-same-nonwitness-data-in-mempool");
     }
 
+    // A full preconf mempool only takes transactions outbidding its lowest preconf fee rate. Check this
+    // before anything is removed from the main mempool on behalf of the transaction.
+    if (m_pool.is_preconf && !args.m_bypass_limits &&
+        !m_pool.IsPreConfFeeRateAccepted(tx.vout[0].nValue, GetVirtualTransactionSize(tx))) {
+        return state.Invalid(TxValidationResult::TX_MEMPOOL_POLICY, "preconf mempool full");
+    }
+
         // Remove transaction from mempool if same inputs spent in preconf transaction
     if(m_pool.is_preconf) {
         CTxMemPool& pool{*m_active_chainstate.GetMempool()};
@@ -1393,6 +1420,13 @@ bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs& args, Workspace& ws)
         return Assume(false);
     }
 
+    // Until the signed block script flags deployment activates, signed blocks verify their scripts without
+    // flags. Passing with the block script flags implies passing without any, so record that too and let
+    // ConnectSignedBlock find the transaction in the cache.
+    if (m_pool.is_preconf && !DeploymentActiveAfter(m_active_chainstate.m_chain.Tip(), m_active_chainstate.m_chainman, Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS)) {
+        GetValidationCache().m_script_execution_cache.insert(ScriptExecutionCacheEntry(GetValidationCache(), tx, /*flags=*/0));
+    }
+
     return true;
 }
 
@@ -1517,7 +1551,13 @@ bool MemPoolAccept::SubmitPackage(const ATMPArgs& args, std::vector<Workspace>&
                                                        args.m_bypass_limits, args.m_package_submission,
                                                        IsCurrentForFeeEstimation(m_active_chainstate),
                                                        m_pool.HasNoInputsOf(tx));
-        m_pool.m_opts.signals->TransactionAddedToMempool(tx_info, m_pool.GetAndIncrementSequence());
+        // The sequence topic follows the main mempool, so the preconf pool's counter is only
+        // carried on its own notification.
+        const uint64_t mempool_sequence{m_pool.GetAndIncrementSequence()};
+        m_pool.m_opts.signals->TransactionAddedToMempool(tx_info, m_pool.is_preconf ? 0 : mempool_sequence);
+        if (m_pool.is_preconf) {
+            m_pool.m_opts.signals->TransactionAddedToPreConfMempool(tx_info, mempool_sequence);
+        }
         if (ws.m_ptx->version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION) {
             includeMempoolAsset(*ws.m_ptx, m_active_chainstate);
         }
@@ -1603,7 +1643,11 @@ MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef
                                                        args.m_bypass_limits, args.m_package_submission,
                                                        IsCurrentForFeeEstimation(m_active_chainstate),
                                                        m_pool.HasNoInputsOf(tx));
-        m_pool.m_opts.signals->TransactionAddedToMempool(tx_info, m_pool.is_preconf ? 0 : m_pool.GetAndIncrementSequence());
+        const uint64_t mempool_sequence{m_pool.GetAndIncrementSequence()};
+        m_pool.m_opts.signals->TransactionAddedToMempool(tx_info, m_pool.is_preconf ? 0 : mempool_sequence);
+        if (m_pool.is_preconf) {
+            m_pool.m_opts.signals->TransactionAddedToPreConfMempool(tx_info, mempool_sequence);
+        }
         // adding asset coin info to back track child transaction in checkTransaction Function
         if (tx_info.info.m_tx->version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION) {
             LogPrintf("new asset utxo cache added in custom struct \n");
@@ -2199,29 +2243,32 @@ void Chainstate::InitCoinsCache(size_t cache_size_bytes)
     m_coins_views->InitCache();
 }
 
-void Chainstate::InitAssetCache()
+void Chainstate::InitAssetCache(size_t cache_size_bytes)
 {
     AssertLockHeld(::cs_main);
     passettree = std::make_unique<CoordinateAssetDB>(DBParams{
             .path = m_chainman.m_options.datadir / "blocks" / "assets",
-            .cache_bytes = 1 << 21,
+            .cache_bytes = cache_size_bytes / 4,
             .memory_only = false,
             .wipe_data = false,
             .obfuscate = true,
-            .options = m_chainman.m_options.coins_db}
+            .options = m_chainman.m_options.coins_db},
+        /*max_pending_bytes=*/cache_size_bytes / 2,
+        /*max_cache_bytes=*/cache_size_bytes / 4
     );
 }
 
-void Chainstate::InitSignedBlockCache()
+void Chainstate::InitSignedBlockCache(size_t cache_size_bytes)
 {
     AssertLockHeld(::cs_main);
     psignedblocktree = std::make_unique<SignedBlocksDB>(DBParams{
             .path = m_chainman.m_options.datadir / "blocks" / "signedblocks",
-            .cache_bytes = 1 << 21,
+            .cache_bytes = cache_size_bytes / 2,
             .memory_only = false,
             .wipe_data = false,
             .obfuscate = true,
-            .options = m_chainman.m_options.coins_db}
+            .options = m_chainman.m_options.coins_db},
+        /*max_pending_bytes=*/cache_size_bytes / 2
     );
 }
 
@@ -2365,6 +2412,59 @@ std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
     }
 }
 
+std::optional<std::string> CAssetCheck::operator()() {
+    std::string reason;
+    if (CheckCoordinateAssetRules(*ptxTo, m_spent_coins, reason)) {
+        return std::nullopt;
+    }
+    return strprintf("%s in %s", reason, ptxTo->GetHash().ToString());
+}
+
+std::optional<BlockCheckFailure> CBlockCheck::operator()()
+{
+    return std::visit(util::Overloaded{
+        [](CScriptCheck& check) -> std::optional<BlockCheckFailure> {
+            auto result = check();
+            if (!result) return std::nullopt;
+            return BlockCheckFailure{BlockValidationResult::BLOCK_CONSENSUS, strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(result->first)), std::move(result->second)};
+        },
+        [](CAssetCheck& check) -> std::optional<BlockCheckFailure> {
+            auto reason = check();
+            if (!reason) return std::nullopt;
+            return BlockCheckFailure{BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid transaction standard", std::move(*reason)};
+        },
+    }, m_check);
+}
+
+/**
+ * Check the asset rules of a transaction being connected. The coins it spends are
+ * copied out of the view, so with a check queue the rules are verified on its workers.
+ */
+static bool CheckAssetRules(const CTransaction& tx, CCoinsViewCache& view, std::optional<CCheckQueueControl<CBlockCheck>>& control, BlockValidationState& state)
+{
+    std::vector<Coin> spent_coins(tx.vin.size());
+    if (tx.version != TRANSACTION_PEGIN_VERSION) {
+        for (size_t i = 0; i < tx.vin.size(); i++) {
+            bool fBitAsset = false;
+            bool fBitAssetControl = false;
+            std::vector<unsigned char> nAssetID;
+            if (!view.getAssetCoin(tx.vin[i].prevout, fBitAsset, fBitAssetControl, nAssetID, &spent_coins[i])) {
+                return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid transaction standard", "inputs missing");
+            }
+        }
+    }
+
+    CBlockCheck check{CAssetCheck(tx, std::move(spent_coins))};
+    if (control) {
+        std::vector<CBlockCheck> vChecks;
+        vChecks.emplace_back(std::move(check));
+        control->Add(std::move(vChecks));
+    } else if (auto failure = check()) {
+        return state.Invalid(failure->result, failure->reject_reason, failure->debug_message);
+    }
+    return true;
+}
+
 ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, const size_t signature_cache_bytes)
     : m_signature_cache{signature_cache_bytes}
 {
@@ -2417,9 +2517,7 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     // correct (ie that the transaction hash which is in tx's prevouts
     // properly commits to the scriptPubKey in the inputs view of that
     // transaction).
-    uint256 hashCacheEntry;
-    CSHA256 hasher = validation_cache.ScriptExecutionCacheHasher();
-    hasher.Write(UCharCast(tx.GetWitnessHash().begin()), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+    const uint256 hashCacheEntry{ScriptExecutionCacheEntry(validation_cache, tx, flags)};
     AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
     if (validation_cache.m_script_execution_cache.contains(hashCacheEntry, !cacheFullScriptStore)) {
         return true;
@@ -2540,8 +2638,12 @@ DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIn
     AssertLockHeld(::cs_main);
     bool fClean = true;
 
+    // The undo data may still be in memory from computing miner fees; it will
+    // not be needed there once the block is disconnected
     CBlockUndo blockUndo;
-    if (!m_blockman.ReadBlockUndo(blockUndo, *pindex)) {
+    if (const auto cached_undo{m_blockman.UncacheBlockUndo(pindex->GetBlockHash())}) {
+        blockUndo = *cached_undo;
+    } else if (!m_blockman.ReadBlockUndo(blockUndo, *pindex)) {
         LogError("DisconnectBlock(): failure reading undo data\n");
         return DISCONNECT_FAILED;
     }
@@ -2852,8 +2954,8 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     // in multiple threads). Preallocate the vector size so a new allocation
     // doesn't invalidate pointers into the vector, and keep txsdata in scope
     // for as long as `control`.
-    std::optional<CCheckQueueControl<CScriptCheck>> control;
-    if (auto& queue = m_chainman.GetCheckQueue(); queue.HasThreads() && fScriptChecks) control.emplace(queue);
+    std::optional<CCheckQueueControl<CBlockCheck>> control;
+    if (auto& queue = m_chainman.GetCheckQueue(); queue.HasThreads()) control.emplace(queue);
 
     bool verifyPreCommitmentCheck = verifyPreCommitment(m_chainman,block, pindex->nHeight);
     if (!verifyPreCommitmentCheck) {
@@ -2892,16 +2994,16 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
     
     if(includedSignedBlock.size() > 0) {
-        for (SignedBlock& finalizedSignedBlock : getFinalizedSignedBlocks()) {
-            if(std::find(includedSignedBlock.begin(), includedSignedBlock.end(), finalizedSignedBlock.GetHash()) == includedSignedBlock.end()){
-                for (unsigned int i = 0; i < finalizedSignedBlock.vtx.size(); i++) {
-                    CTransactionRef ptx = finalizedSignedBlock.vtx[i];
+        for (const SignedBlockRef& finalizedSignedBlock : getFinalizedSignedBlocks()) {
+            if(std::find(includedSignedBlock.begin(), includedSignedBlock.end(), finalizedSignedBlock->GetHash()) == includedSignedBlock.end()){
+                for (unsigned int i = 0; i < finalizedSignedBlock->vtx.size(); i++) {
+                    CTransactionRef ptx = finalizedSignedBlock->vtx[i];
                     const CTransaction &tx = *ptx;
                     CTxUndo undoDummy;
                     CAmount amountAssetIn = CAmount(0);
                     int nControlN = -1;
                     std::vector<unsigned char> nAssetID;
-                    CAmount refund = getRefundForPreconfTx(tx, finalizedSignedBlock.currentFee, view);
+                    CAmount refund = getRefundForPreconfTx(tx, finalizedSignedBlock->currentFee, view);
                     UpdateCoins(tx, view, undoDummy, pindex->nHeight, amountAssetIn, nControlN, nAssetID, std::vector<unsigned char>{}, refund);
                 }
             }
@@ -2954,6 +3056,8 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
 
     int16_t assetIncr = 0;
+    bool fAssetMint{false};
+    bool fAssetMintsWritten{false};
     for (unsigned int i = 0; i < block.vtx.size(); i++) {
         if (!state.IsValid()) break;
         const CTransaction &tx = *(block.vtx[i]);
@@ -2972,9 +3076,9 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
                 return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): block only accept 256 new asset per block");
             }
 
-            if (!AreCoordinateTransactionStandard(tx, view)) {
+            if (!CheckAssetRules(tx, view, control, state)) {
                 LogPrintf("Invalid transaction standard \n");
-                return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid transaction standard");
+                return false;
             }
             CAmount txfee = 0;
             CAmount utxoFee = 0;
@@ -3035,7 +3139,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             if (control) {
                 std::vector<CScriptCheck> vChecks;
                 tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache, &vChecks);
-                if (tx_ok) control->Add(std::move(vChecks));
+                if (tx_ok) control->Add(std::vector<CBlockCheck>(std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end())));
             } else {
                 tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache);
             }
@@ -3058,8 +3162,8 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             if (!tx.HasValidOutputCount()) {
                 return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid CoordinateAsset creation - vout too small");
             }
-            std::vector<unsigned char> nIDLast = CreateAssetId(pindex->nHeight, assetIncr);
             std::vector<unsigned char> nAssetID;
+            bool fBitAssetControl = false;
             CoordinateAsset asset;
 
             // validate asset precision
@@ -3073,15 +3177,14 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
                     return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid CoordinateAsset creation - no input spciefied");
                 }
                 bool fBitAsset = false;
-                bool fBitAssetControl = false;
                 Coin coin;
                 // check first input is asset controller
 
                 view.getAssetCoin(tx.vin[0].prevout, fBitAsset, fBitAssetControl, nAssetID, &coin);
-                if (fBitAssetControl) {
-                    nIDLast = nAssetID;
-                    passettree->GetAsset(getAssetHash(nIDLast), asset);
-                }
+            }
+            const std::vector<unsigned char> nIDLast = GetCreatedAssetId(tx, pindex->nHeight, assetIncr, nAssetID, fBitAssetControl);
+            if (fBitAssetControl) {
+                passettree->GetAsset(getAssetHash(nIDLast), asset);
             }
 
             // additional mint not available for current minting
@@ -3111,7 +3214,16 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
                     return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid CoordinateAsset creation - controller destination invalid");
                 }
             } else {
-                asset.nSupply =  asset.nSupply + tx.vout[1].nValue;
+                // The asset database is written just before the coins database and keeps
+                // the records of disconnected blocks, so a block connected again after a
+                // crash or a reorg must not add its additional mints a second time.
+                if (!fAssetMint && passettree->HaveAssetMintBlock(block_hash)) {
+                    fAssetMintsWritten = true;
+                }
+                fAssetMint = true;
+                if (!fAssetMintsWritten) {
+                    asset.nSupply =  asset.nSupply + tx.vout[1].nValue;
+                }
             }
 
             vAsset.push_back(asset);
@@ -3167,7 +3279,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     if (control) {
         auto parallel_result = control->Complete();
         if (parallel_result.has_value() && state.IsValid()) {
-            state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(parallel_result->first)), parallel_result->second);
+            state.Invalid(parallel_result->result, parallel_result->reject_reason, parallel_result->debug_message);
         }
     }
     if (!state.IsValid()) {
@@ -3226,6 +3338,9 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     if (vAsset.size()) {
         if (!passettree->WriteCoordinateAssets(vAsset))
             return state.Error("Failed to write CoordinateAsset index!");
+        if (fAssetMint) {
+            passettree->WriteAssetMintBlock(block_hash);
+        }
     }
 
     if(invaidTx.size() > 0) {
@@ -3238,11 +3353,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
 
     if(block.preconfBlock.size() > 0) {
-        std::vector<uint256> signedBlockHashes;
+        std::vector<std::pair<uint64_t, uint256>> signedBlockHashes;
         uint64_t presignedHeight = 0;
         for (const SignedBlock& finalizedSignedBlock : block.preconfBlock) {
             presignedHeight = finalizedSignedBlock.nHeight;
-            signedBlockHashes.push_back(finalizedSignedBlock.GetHash());
+            signedBlockHashes.emplace_back(finalizedSignedBlock.nHeight, finalizedSignedBlock.GetHash());
 
         }
         psignedblocktree->WriteSignedBlockHash(signedBlockHashes,block.GetHash());
@@ -3250,10 +3365,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
 
     for (const SignedBlock& preconfBlockItem : block.preconfBlock) {
+        const uint256 signedBlockHash = preconfBlockItem.GetHash();
         for (unsigned int i = 0; i < preconfBlockItem.vtx.size(); i++) {
             CTransactionRef ptx = preconfBlockItem.vtx[i];
             SignedTxindex signTxIndex;
-            signTxIndex.signedBlockHash = preconfBlockItem.GetHash();
+            signTxIndex.signedBlockHash = signedBlockHash;
             signTxIndex.blockIndex = pindex->nHeight;
             signTxIndex.pos = i;
             psignedblocktree->WriteTxPosition(signTxIndex,ptx->GetHash());
@@ -3268,26 +3384,25 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         psignedblocktree->WriteTxPosition(signTxIndex,ptx->GetHash());
     }
 
-    resetCommitment(pindex->nHeight, m_chainman);
+    resetCommitment(pindex->nHeight);
 
     if(pindex->nHeight > 5) {
         psignedblocktree->DeleteInvalidTx(pindex->nHeight - 5);
     }
 
-
     return true;
 }
 
 CCoinsViewCache& Chainstate::UpdatedCoinsTip(CCoinsViewCache& view, int blockHeight) {
-    for (SignedBlock& finalizedSignedBlock : getFinalizedSignedBlocks()) {
-        for (unsigned int i = 0; i < finalizedSignedBlock.vtx.size(); i++) {
-            CTransactionRef ptx = finalizedSignedBlock.vtx[i];
+    for (const SignedBlockRef& finalizedSignedBlock : getFinalizedSignedBlocks()) {
+        for (unsigned int i = 0; i < finalizedSignedBlock->vtx.size(); i++) {
+            CTransactionRef ptx = finalizedSignedBlock->vtx[i];
             const CTransaction &tx = *ptx;
             CTxUndo undoDummy;
             CAmount amountAssetIn = CAmount(0);
             int nControlN = -1;
             std::vector<unsigned char> nAssetID;
-            CAmount refund = getRefundForPreconfTx(tx, finalizedSignedBlock.currentFee, view);
+            CAmount refund = getRefundForPreconfTx(tx, finalizedSignedBlock->currentFee, view);
             UpdateCoins(tx, view, undoDummy, blockHeight, amountAssetIn, nControlN, nAssetID, std::vector<unsigned char>{}, refund);
         }
     }
@@ -3307,7 +3422,18 @@ bool Chainstate::ConnectSignedBlock(const SignedBlock& block) {
     CBlockUndo blockundo;
     blockundo.vtxundo.reserve(block.vtx.size()-1);
 
+    // Signed block scripts are verified without script flags until the deployment activates. From then on
+    // they use the same flags the preconf mempool used on acceptance. The preconf mempool caches its
+    // script checks under whichever flags apply here, so transactions it accepted skip script execution.
+    const unsigned int flags{DeploymentActiveAfter(m_chain.Tip(), m_chainman, Consensus::DEPLOYMENT_SIGNED_BLOCK_SCRIPT_FLAGS) ?
+                             GetBlockScriptFlags(*m_chain.Tip(), m_chainman) : 0};
+
+    // Precomputed transaction data pointers must not be invalidated until `control`
+    // has run the script checks, keep txsdata preallocated and in scope for as long as it.
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
+    std::optional<CCheckQueueControl<CBlockCheck>> control;
+    if (auto& queue = m_chainman.GetCheckQueue(); queue.HasThreads()) control.emplace(queue);
+
     for (unsigned int i = 0; i < block.vtx.size(); i++) {
         CTransactionRef ptx = block.vtx[i];
         const CTransaction& tx = *ptx;
@@ -3316,9 +3442,9 @@ bool Chainstate::ConnectSignedBlock(const SignedBlock& block) {
                     return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid preconf creation - vout too small");
             }
 
-            if (!AreCoordinateTransactionStandard(tx, view)) {
+            if (!CheckAssetRules(tx, view, control, state)) {
                 LogPrintf("Invalid transaction standard \n");
-                return state.Invalid(BlockValidationResult::BLOCK_CACHED_INVALID, "ConnectBlock(): Invalid transaction standard");
+                return false;
             }
 
             // valiate has coins
@@ -3350,7 +3476,17 @@ bool Chainstate::ConnectSignedBlock(const SignedBlock& block) {
                 return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-txns-accumulated-fee-outofrange");
             }
 
-            if (!CheckInputScripts(tx, tx_state, view, 0, true, false, txsdata[i], m_chainman.m_validation_cache)) {
+            // With a check queue the script checks run on its workers while the remaining
+            // transactions are connected, otherwise CheckInputScripts runs them before returning.
+            bool tx_ok;
+            if (control) {
+                std::vector<CScriptCheck> vChecks;
+                tx_ok = CheckInputScripts(tx, tx_state, view, flags, true, false, txsdata[i], m_chainman.m_validation_cache, &vChecks);
+                if (tx_ok) control->Add(std::vector<CBlockCheck>(std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end())));
+            } else {
+                tx_ok = CheckInputScripts(tx, tx_state, view, flags, true, false, txsdata[i], m_chainman.m_validation_cache);
+            }
+            if (!tx_ok) {
                 // Any transaction validation failure in ConnectBlock is a block consensus failure
                 state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
                                 tx_state.GetRejectReason(), tx_state.GetDebugMessage());
@@ -3372,8 +3508,17 @@ bool Chainstate::ConnectSignedBlock(const SignedBlock& block) {
         UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), m_chainman.ActiveHeight(), amountAssetIn, nControlN, nAssetID, std::vector<unsigned char>{}, refund);
     }
 
+    if (control) {
+        auto parallel_result = control->Complete();
+        if (parallel_result.has_value()) {
+            state.Invalid(parallel_result->result, parallel_result->reject_reason, parallel_result->debug_message);
+            return state.Error(strprintf("ConnectSignedBlock(): script verification failed with %s", state.ToString()));
+        }
+    }
+
     psignedblocktree->WriteLastSignedBlockID(block.nHeight);
     psignedblocktree->WriteLastSignedBlockHash(block.GetHash());
+    recordSignedBlockFee(m_chain.Height(), block.currentFee);
     removePreConfWitness();
     if(m_preconf_mempool) {
        LOCK(m_preconf_mempool->cs);
@@ -3390,6 +3535,11 @@ bool Chainstate::ConnectSignedBlock(const SignedBlock& block) {
 CoinsCacheSizeState Chainstate::GetCoinsCacheSizeState()
 {
     AssertLockHeld(::cs_main);
+    // The buffered coordinate database writes are only committed together with
+    // the coins, so a full buffer needs a flush just like a full coins cache.
+    if ((passettree && passettree->ShouldFlush()) || (psignedblocktree && psignedblocktree->ShouldFlush())) {
+        return CoinsCacheSizeState::CRITICAL;
+    }
     return this->GetCoinsCacheSizeState(
         m_coinstip_cache_size_bytes,
         m_mempool ? m_mempool->m_opts.max_size_bytes : 0);
@@ -3539,6 +3689,14 @@ bool Chainstate::FlushStateToDisk(
                 if (!CheckDiskSpace(m_chainman.m_options.datadir, 48 * 2 * 2 * CoinsTip().GetCacheSize())) {
                     return FatalError(m_chainman.GetNotifications(), state, _("Disk space is too low!"));
                 }
+                // Flush the coordinate databases before the coins database, so
+                // they are never behind the best block recorded with the coins.
+                if (passettree && !passettree->Flush()) {
+                    return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to asset database."));
+                }
+                if (psignedblocktree && !psignedblocktree->Flush()) {
+                    return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to signed block database."));
+                }
                 // Flush the chainstate (which may refer to block index entries).
                 const auto empty_cache{(mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical};
                 if (empty_cache ? !CoinsTip().Flush() : !CoinsTip().Sync()) {
@@ -3646,6 +3804,27 @@ void Chainstate::UpdateTip(const CBlockIndex* pindexNew)
                  util::Join(warning_messages, Untranslated(", ")).original);
 }
 
+std::vector<CoordinateAsset> Chainstate::GetBlockAssets(const CBlock& block, const CCoinsViewCache& view) const
+{
+    std::vector<CoordinateAsset> assets;
+    if (!passettree) return assets;
+    for (const CTransactionRef& tx : block.vtx) {
+        if (tx->version != TRANSACTION_COORDINATE_ASSET_CREATE_VERSION) continue;
+        // The controller output carries the asset ID, unless it is an OP_RETURN
+        // and was never added to the UTXO set. Then the genesis output does.
+        for (uint32_t n = 0; n < 2 && n < tx->vout.size(); ++n) {
+            const Coin& coin{view.AccessCoin(COutPoint{tx->GetHash(), n})};
+            if (coin.IsSpent() || coin.nAssetID.empty()) continue;
+            CoordinateAsset asset;
+            if (passettree->GetAsset(getAssetHash(coin.nAssetID), asset)) {
+                assets.push_back(std::move(asset));
+            }
+            break;
+        }
+    }
+    return assets;
+}
+
 /** Disconnect m_chain's tip.
   * After calling, the mempool will be in an inconsistent state, with
   * transactions from disconnected blocks being added to disconnectpool.  You
@@ -3671,6 +3850,8 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
         LogError("DisconnectTip(): Failed to read block\n");
         return false;
     }
+    // The block's asset outputs are spent by DisconnectBlock, look them up first.
+    const std::vector<CoordinateAsset> assets_disconnected{m_chainman.m_options.signals ? GetBlockAssets(block, CoinsTip()) : std::vector<CoordinateAsset>{}};
     // Apply the block atomically to the chain state.
     const auto time_start{SteadyClock::now()};
     {
@@ -3711,12 +3892,18 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     }
 
     m_chain.SetTip(*pindexDelete->pprev);
+    reinsertCommitment(pindexDelete->nHeight, pindexDelete->GetBlockHash());
+    removeFeeForBlock(pindexDelete->GetBlockHash());
+    rollbackSignedBlockFees(pindexDelete->nHeight);
 
     UpdateTip(pindexDelete->pprev);
     // Let wallets know transactions went from 1-confirmed to
     // 0-confirmed or conflicted:
     if (m_chainman.m_options.signals) {
         m_chainman.m_options.signals->BlockDisconnected(pblock, pindexDelete);
+        for (const CoordinateAsset& asset : assets_disconnected) {
+            m_chainman.m_options.signals->AssetDisconnected(asset, pindexDelete);
+        }
     }
     return true;
 }
@@ -3724,6 +3911,7 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
 struct PerBlockConnectTrace {
     CBlockIndex* pindex = nullptr;
     std::shared_ptr<const CBlock> pblock;
+    std::vector<CoordinateAsset> assets;
     PerBlockConnectTrace() = default;
 };
 /**
@@ -3740,12 +3928,13 @@ private:
 public:
     explicit ConnectTrace() : blocksConnected(1) {}
 
-    void BlockConnected(CBlockIndex* pindex, std::shared_ptr<const CBlock> pblock) {
+    void BlockConnected(CBlockIndex* pindex, std::shared_ptr<const CBlock> pblock, std::vector<CoordinateAsset> assets) {
         assert(!blocksConnected.back().pindex);
         assert(pindex);
         assert(pblock);
         blocksConnected.back().pindex = pindex;
         blocksConnected.back().pblock = std::move(pblock);
+        blocksConnected.back().assets = std::move(assets);
         blocksConnected.emplace_back();
     }
 
@@ -3794,6 +3983,7 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
     // num_blocks_total may be zero until the ConnectBlock() call below.
     LogDebug(BCLog::BENCH, "  - Load block from disk: %.2fms\n",
              Ticks<MillisecondsDouble>(time_2 - time_1));
+    std::vector<CoordinateAsset> assets_connected;
     {
         CCoinsViewCache view(&CoinsTip());
         bool rv = ConnectBlock(blockConnecting, state, pindexNew, view);
@@ -3813,6 +4003,7 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
                  Ticks<MillisecondsDouble>(time_3 - time_2),
                  Ticks<SecondsDouble>(m_chainman.time_connect_total),
                  Ticks<MillisecondsDouble>(m_chainman.time_connect_total) / m_chainman.num_blocks_total);
+        if (m_chainman.m_options.signals) assets_connected = GetBlockAssets(blockConnecting, view);
         bool flushed = view.Flush();
         assert(flushed);
     }
@@ -3861,7 +4052,7 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
         m_chainman.MaybeCompleteSnapshotValidation();
     }
 
-    connectTrace.BlockConnected(pindexNew, std::move(pthisBlock));
+    connectTrace.BlockConnected(pindexNew, std::move(pthisBlock), std::move(assets_connected));
     return true;
 }
 
@@ -4148,6 +4339,9 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
                     assert(trace.pblock && trace.pindex);
                     if (m_chainman.m_options.signals) {
                         m_chainman.m_options.signals->BlockConnected(chainstate_role, trace.pblock, trace.pindex);
+                        for (const CoordinateAsset& asset : trace.assets) {
+                            m_chainman.m_options.signals->AssetCreated(asset, trace.pindex);
+                        }
                     }
                 }
 
@@ -5752,6 +5946,246 @@ bool Chainstate::LoadGenesisBlock()
     return true;
 }
 
+namespace {
+//! Upper bound on the blocks read ahead of the import loop.
+constexpr size_t MAX_IMPORT_BLOCKS_IN_FLIGHT{64};
+//! Upper bound on the serialized size of the blocks read ahead of the import
+//! loop, so memory stays bounded however large the blocks are. A single block
+//! is always let through, even if it is larger than this on its own.
+constexpr size_t MAX_IMPORT_BYTES_IN_FLIGHT{32 << 20};
+
+/** A block located in an external block file, in file order. */
+struct ImportBlock {
+    //! Offset of the block data (after the magic bytes and size) in the file
+    uint64_t nBlockPos{0};
+    //! Serialized size of the block, counted against MAX_IMPORT_BYTES_IN_FLIGHT
+    //! until the block is returned by Next()
+    size_t nSize{0};
+    uint256 hash;
+    uint256 hashPrevBlock;
+    //! Serialized block; released once the block has been decoded
+    std::vector<std::byte> data;
+    //! Decoded block; null until decoded, or if decoding failed
+    std::shared_ptr<CBlock> block;
+    //! Why decoding failed, if it did
+    std::string error;
+};
+
+/**
+ * Deserialize a block read from an external block file and run the
+ * context-free checks on it (proof of work including auxpow, the merkle root
+ * over vtx, pegins and preconfBlock, and transaction sanity). A passing result
+ * is cached in CBlock::fChecked so AcceptBlock does not repeat it; a failing
+ * one is rediscovered there and reported as usual.
+ */
+void DecodeImportBlock(ImportBlock& item, const Consensus::Params& consensus)
+{
+    try {
+        auto block{std::make_shared<CBlock>()};
+        SpanReader{item.data} >> TX_WITH_WITNESS(*block);
+        BlockValidationState state;
+        CheckBlock(*block, state, consensus);
+        item.block = std::move(block);
+    } catch (const std::exception& e) {
+        item.error = e.what();
+    }
+    item.data = {};
+}
+
+/**
+ * Read-ahead for ChainstateManager::LoadExternalBlockFile.
+ *
+ * A reader thread scans the file for blocks and hands them out in file order
+ * through Next(). Blocks the import loop will want to accept are decoded and
+ * checked by worker threads in the meantime, so deserialization of large
+ * pegin and preconfBlock payloads and the merkle root computation overlap
+ * with AcceptBlock and with disk reads. Blocks that will only be skipped
+ * (known already, or parent not known) are never decoded.
+ */
+class BlockImportPipeline
+{
+public:
+    /** Whether the block is likely to be accepted, given whether its parent appeared earlier in the file. */
+    using WantBlockFn = std::function<bool(const uint256& hash, const uint256& prev_hash, bool parent_in_file)>;
+
+    BlockImportPipeline(AutoFile& file, const CChainParams& params, int worker_threads, WantBlockFn want_block)
+        : m_file{file}, m_params{params}, m_want_block{std::move(want_block)}
+    {
+        m_reader = std::thread(&util::TraceThread, "blkread", [this] { ReadLoop(); });
+        for (int n = 0; n < worker_threads; ++n) {
+            m_workers.emplace_back(&util::TraceThread, strprintf("blkdecode.%i", n), [this] { WorkerLoop(); });
+        }
+    }
+
+    ~BlockImportPipeline()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cond.notify_all();
+        m_reader.join();
+        for (auto& worker : m_workers) worker.join();
+    }
+
+    /** Return the next block in file order, or nullptr once the file is exhausted. */
+    std::shared_ptr<ImportBlock> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            if (!m_ordered.empty() && !m_pending.contains(m_ordered.front().get())) {
+                auto item{std::move(m_ordered.front())};
+                m_ordered.pop_front();
+                m_bytes_in_flight -= item->nSize;
+                m_cond.notify_all();
+                return item;
+            }
+            if (m_ordered.empty() && m_reader_done) return nullptr;
+            if (!m_work.empty()) {
+                // Decode on this thread rather than wait, which also keeps
+                // the import going when there are no worker threads.
+                DecodeOne(lock);
+                continue;
+            }
+            m_cond.wait(lock);
+        }
+    }
+
+    /** Error that stopped the reader before the end of the file, if any. */
+    std::optional<std::string> ReadError() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        return WITH_LOCK(m_mutex, return m_read_error);
+    }
+
+private:
+    void DecodeOne(UniqueLock<Mutex>& lock) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        auto item{std::move(m_work.front())};
+        m_work.pop_front();
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            DecodeImportBlock(*item, m_params.GetConsensus());
+        }
+        m_pending.erase(item.get());
+        m_cond.notify_all();
+    }
+
+    void WorkerLoop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (!m_stop) {
+            if (m_work.empty()) {
+                m_cond.wait(lock);
+                continue;
+            }
+            DecodeOne(lock);
+        }
+    }
+
+    void Push(std::shared_ptr<ImportBlock> item, bool decode) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (!m_stop && !m_ordered.empty() &&
+               (m_ordered.size() >= MAX_IMPORT_BLOCKS_IN_FLIGHT || m_bytes_in_flight + item->nSize > MAX_IMPORT_BYTES_IN_FLIGHT)) {
+            m_cond.wait(lock);
+        }
+        if (m_stop) return;
+        m_bytes_in_flight += item->nSize;
+        if (decode) {
+            m_pending.insert(item.get());
+            m_work.push_back(item);
+        }
+        m_ordered.push_back(std::move(item));
+        m_cond.notify_all();
+    }
+
+    void ReadLoop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        try {
+            BufferedFile blkdat{m_file, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
+            // Hashes of the blocks found so far, to tell whether a block's
+            // parent precedes it in this file and will be accepted first.
+            std::unordered_set<uint256, BlockHasher> seen;
+            // nRewind indicates where to resume scanning in case something goes wrong,
+            // such as a block fails to deserialize.
+            uint64_t nRewind = blkdat.GetPos();
+            while (!blkdat.eof()) {
+                if (WITH_LOCK(m_mutex, return m_stop)) break;
+
+                blkdat.SetPos(nRewind);
+                nRewind++; // start one byte further next time, in case of failure
+                blkdat.SetLimit(); // remove former limit
+                unsigned int nSize = 0;
+                try {
+                    // locate a header
+                    MessageStartChars buf;
+                    blkdat.FindByte(std::byte(m_params.MessageStart()[0]));
+                    nRewind = blkdat.GetPos() + 1;
+                    blkdat >> buf;
+                    if (buf != m_params.MessageStart()) {
+                        continue;
+                    }
+                    // read size
+                    blkdat >> nSize;
+                    if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
+                        continue;
+                } catch (const std::exception&) {
+                    // no valid block header found; don't complain
+                    // (this happens at the end of every blk.dat file)
+                    break;
+                }
+                try {
+                    // read block header, then rewind and take the whole block
+                    // (the header is still buffered, so this does not hit the disk again)
+                    const uint64_t nBlockPos{blkdat.GetPos()};
+                    blkdat.SetLimit(nBlockPos + nSize);
+                    CBlockHeader header;
+                    blkdat >> header;
+                    auto item{std::make_shared<ImportBlock>()};
+                    item->nBlockPos = nBlockPos;
+                    item->nSize = nSize;
+                    item->hash = header.GetHash();
+                    item->hashPrevBlock = header.hashPrevBlock;
+                    nRewind = nBlockPos + nSize;
+                    blkdat.SetPos(nBlockPos);
+                    item->data.resize(nSize);
+                    blkdat.read(item->data);
+
+                    const bool decode{m_want_block(item->hash, item->hashPrevBlock, seen.contains(item->hashPrevBlock))};
+                    seen.insert(item->hash);
+                    Push(std::move(item), decode);
+                } catch (const std::exception& e) {
+                    // see the comment in LoadExternalBlockFile on why unexpected data is not fatal
+                    LogDebug(BCLog::REINDEX, "LoadExternalBlockFile: unexpected data at file offset 0x%x - %s. continuing\n", (nRewind - 1), e.what());
+                }
+            }
+        } catch (const std::runtime_error& e) {
+            WITH_LOCK(m_mutex, m_read_error = e.what());
+        }
+        WITH_LOCK(m_mutex, m_reader_done = true);
+        m_cond.notify_all();
+    }
+
+    AutoFile& m_file;
+    const CChainParams& m_params;
+    const WantBlockFn m_want_block;
+
+    mutable Mutex m_mutex;
+    std::condition_variable m_cond;
+    //! Blocks read and not yet returned by Next(), in file order
+    std::deque<std::shared_ptr<ImportBlock>> m_ordered GUARDED_BY(m_mutex);
+    //! Blocks waiting for a thread to decode them
+    std::deque<std::shared_ptr<ImportBlock>> m_work GUARDED_BY(m_mutex);
+    //! Blocks queued for or being decoded; Next() waits for these
+    std::unordered_set<const ImportBlock*> m_pending GUARDED_BY(m_mutex);
+    //! Serialized size of the blocks in m_ordered
+    size_t m_bytes_in_flight GUARDED_BY(m_mutex){0};
+    bool m_reader_done GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::optional<std::string> m_read_error GUARDED_BY(m_mutex);
+
+    std::thread m_reader;
+    std::vector<std::thread> m_workers;
+};
+} // namespace
+
 void ChainstateManager::LoadExternalBlockFile(
     AutoFile& file_in,
     FlatFilePos* dbp,
@@ -5765,59 +6199,38 @@ void ChainstateManager::LoadExternalBlockFile(
 
     int nLoaded = 0;
     try {
-        BufferedFile blkdat{file_in, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
-        // nRewind indicates where to resume scanning in case something goes wrong,
-        // such as a block fails to deserialize.
-        uint64_t nRewind = blkdat.GetPos();
-        while (!blkdat.eof()) {
+        // Blocks are located and read by a separate thread and, where they are
+        // going to be accepted, decoded ahead of the loop below by a set of
+        // decode threads owned by the pipeline. These are started for the
+        // duration of this call only, as many as there are -par script check
+        // threads (which sit idle while importing).
+        BlockImportPipeline pipeline{file_in, params, std::max(0, m_options.worker_threads_num),
+            [&](const uint256& hash, const uint256& prev_hash, bool parent_in_file) {
+                LOCK(cs_main);
+                if (hash != params.GetConsensus().hashGenesisBlock && !parent_in_file && !m_blockman.LookupBlockIndex(prev_hash)) {
+                    return false;
+                }
+                const CBlockIndex* pindex{m_blockman.LookupBlockIndex(hash)};
+                return !pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0;
+            }};
+        while (const auto item{pipeline.Next()}) {
             if (m_interrupt) return;
 
-            blkdat.SetPos(nRewind);
-            nRewind++; // start one byte further next time, in case of failure
-            blkdat.SetLimit(); // remove former limit
-            unsigned int nSize = 0;
-            try {
-                // locate a header
-                MessageStartChars buf;
-                blkdat.FindByte(std::byte(params.MessageStart()[0]));
-                nRewind = blkdat.GetPos() + 1;
-                blkdat >> buf;
-                if (buf != params.MessageStart()) {
-                    continue;
-                }
-                // read size
-                blkdat >> nSize;
-                if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
-                    continue;
-            } catch (const std::exception&) {
-                // no valid block header found; don't complain
-                // (this happens at the end of every blk.dat file)
-                break;
-            }
             try {
-                // read block header
-                const uint64_t nBlockPos{blkdat.GetPos()};
+                const uint256& hash{item->hash};
                 if (dbp)
-                    dbp->nPos = nBlockPos;
-                blkdat.SetLimit(nBlockPos + nSize);
-                CBlockHeader header;
-                blkdat >> header;
-                const uint256 hash{header.GetHash()};
-                // Skip the rest of this block (this may read from disk into memory); position to the marker before the
-                // next block, but it's still possible to rewind to the start of the current block (without a disk read).
-                nRewind = nBlockPos + nSize;
-                blkdat.SkipTo(nRewind);
+                    dbp->nPos = item->nBlockPos;
 
                 std::shared_ptr<CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
 
                 {
                     LOCK(cs_main);
                     // detect out of order blocks, and store them for later
-                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(header.hashPrevBlock)) {
+                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(item->hashPrevBlock)) {
                         LogDebug(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                                 header.hashPrevBlock.ToString());
+                                 item->hashPrevBlock.ToString());
                         if (dbp && blocks_with_unknown_parent) {
-                            blocks_with_unknown_parent->emplace(header.hashPrevBlock, *dbp);
+                            blocks_with_unknown_parent->emplace(item->hashPrevBlock, *dbp);
                         }
                         continue;
                     }
@@ -5825,11 +6238,15 @@ void ChainstateManager::LoadExternalBlockFile(
                     // process in case the block isn't known yet
                     const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
                     if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
-                        // This block can be processed immediately; rewind to its start, read and deserialize it.
-                        blkdat.SetPos(nBlockPos);
-                        pblock = std::make_shared<CBlock>();
-                        blkdat >> TX_WITH_WITNESS(*pblock);
-                        nRewind = blkdat.GetPos();
+                        // This block can be processed immediately. It has normally been
+                        // decoded ahead of time; if not, decode it now.
+                        if (!item->block && item->error.empty()) {
+                            DecodeImportBlock(*item, params.GetConsensus());
+                        }
+                        if (!item->block) {
+                            throw std::runtime_error(item->error);
+                        }
+                        pblock = item->block;
 
                         BlockValidationState state;
                         if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
@@ -5842,7 +6259,6 @@ void ChainstateManager::LoadExternalBlockFile(
                         LogDebug(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), pindex->nHeight);
                     }
                 }
-
                 // Activate the genesis block so normal node progress can continue
                 // During first -reindex, this will only connect Genesis since
                 // ActivateBestChain only connects blocks which are in the block tree db,
@@ -5920,9 +6336,12 @@ void ChainstateManager::LoadExternalBlockFile(
                 // the reindex process is not the place to attempt to clean and/or compact the block files. if so desired, a studious node operator
                 // may use knowledge of the fact that the block files are not entirely pristine in order to prepare a set of pristine, and
                 // perhaps ordered, block files for later reindexing.
-                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, (nRewind - 1), e.what());
+                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, item->nBlockPos, e.what());
             }
         }
+        if (const auto error{pipeline.ReadError()}) {
+            GetNotifications().fatalError(strprintf(_("System error while loading external block file: %s"), *error));
+        }
     } catch (const std::runtime_error& e) {
         GetNotifications().fatalError(strprintf(_("System error while loading external block file: %s"), e.what()));
     }
@@ -11,6 +11,7 @@
 #include <chain.h>
 #include <checkqueue.h>
 #include <consensus/amount.h>
+#include <consensus/validation.h>
 #include <cuckoocache.h>
 #include <deploymentstatus.h>
 #include <kernel/chain.h>
@@ -45,6 +46,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 class Chainstate;
@@ -358,6 +360,53 @@ static_assert(std::is_nothrow_move_assignable_v<CScriptCheck>);
 static_assert(std::is_nothrow_move_constructible_v<CScriptCheck>);
 static_assert(std::is_nothrow_destructible_v<CScriptCheck>);
 
+/**
+ * Closure representing the asset rules of one transaction. It holds a copy of the
+ * coins the transaction spends, so it does not need the coins view or cs_main.
+ */
+class CAssetCheck
+{
+private:
+    const CTransaction *ptxTo;
+    std::vector<Coin> m_spent_coins;
+
+public:
+    CAssetCheck(const CTransaction& txToIn, std::vector<Coin>&& spent_coins) :
+        ptxTo(&txToIn), m_spent_coins(std::move(spent_coins)) { }
+
+    CAssetCheck(const CAssetCheck&) = delete;
+    CAssetCheck& operator=(const CAssetCheck&) = delete;
+    CAssetCheck(CAssetCheck&&) = default;
+    CAssetCheck& operator=(CAssetCheck&&) = default;
+
+    /** The broken asset rule and the transaction, if the rules are not met */
+    std::optional<std::string> operator()();
+};
+
+/** How a failed check is reported in the BlockValidationState of the block being connected */
+struct BlockCheckFailure {
+    BlockValidationResult result;
+    std::string reject_reason;
+    std::string debug_message;
+};
+
+/** A check run by the script check queue workers while a block is connected. */
+class CBlockCheck
+{
+private:
+    std::variant<CScriptCheck, CAssetCheck> m_check;
+
+public:
+    CBlockCheck(CScriptCheck&& check) noexcept : m_check(std::move(check)) { }
+    CBlockCheck(CAssetCheck&& check) noexcept : m_check(std::move(check)) { }
+
+    std::optional<BlockCheckFailure> operator()();
+};
+
+static_assert(std::is_nothrow_move_assignable_v<CBlockCheck>);
+static_assert(std::is_nothrow_move_constructible_v<CBlockCheck>);
+static_assert(std::is_nothrow_destructible_v<CBlockCheck>);
+
 /**
  * Convenience class for initializing and passing the script execution cache
  * and signature cache.
@@ -612,13 +661,13 @@ public:
     //! is verified).
     void InitCoinsCache(size_t cache_size_bytes) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
-    //! Initialize the in-memory coins cache (to be done after the health of the on-disk database
-    //! is verified).
-    void InitAssetCache() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Open the asset database. Half of cache_size_bytes is used as leveldb cache, the other
+    //! half bounds the writes buffered until the next chainstate flush.
+    void InitAssetCache(size_t cache_size_bytes) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
-    //! Initialize the in-memory coins cache (to be done after the health of the on-disk database
-    //! is verified).
-    void InitSignedBlockCache() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Open the signed blocks database. Half of cache_size_bytes is used as leveldb cache, the
+    //! other half bounds the writes buffered until the next chainstate flush.
+    void InitSignedBlockCache(size_t cache_size_bytes) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     //! @returns whether or not the CoinsViews object has been fully initialized and we can
     //!          safely flush this object to disk.
@@ -813,7 +862,8 @@ public:
 
     //! Dictates whether we need to flush the cache to disk or not.
     //!
-    //! @return the state of the size of the coins cache.
+    //! @return the state of the size of the coins cache, CRITICAL when the buffered
+    //!         coordinate database writes outgrew their budget.
     CoinsCacheSizeState GetCoinsCacheSizeState() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     CoinsCacheSizeState GetCoinsCacheSizeState(
@@ -831,6 +881,8 @@ public:
 protected:
     bool ActivateBestChainStep(BlockValidationState& state, CBlockIndex* pindexMostWork, const std::shared_ptr<const CBlock>& pblock, bool& fInvalidFound, ConnectTrace& connectTrace) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
     bool ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions& disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    //! Assets created or additionally minted by a block whose outputs are in view, as stored in the asset database
+    std::vector<CoordinateAsset> GetBlockAssets(const CBlock& block, const CCoinsViewCache& view) const EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     void InvalidBlockFound(CBlockIndex* pindex, const BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     CBlockIndex* FindMostWorkChain() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -1002,8 +1054,8 @@ private:
         return cs && !cs->m_disabled;
     }
 
-    //! A queue for script verifications that have to be performed by worker threads.
-    CCheckQueue<CScriptCheck> m_script_check_queue;
+    //! A queue for script and asset rule verifications that have to be performed by worker threads.
+    CCheckQueue<CBlockCheck> m_script_check_queue;
 
     //! Timers and counters used for benchmarking validation in both background
     //! and active chainstates.
@@ -1108,6 +1160,12 @@ public:
     //! coins databases. This will be split somehow across chainstates.
     size_t m_total_coinsdb_cache{0};
 
+    //! The number of bytes available for the asset database cache and write buffer.
+    size_t m_total_assetdb_cache{0};
+
+    //! The number of bytes available for the signed blocks database cache and write buffer.
+    size_t m_total_signedblockdb_cache{0};
+
     //! Instantiate a new chainstate.
     //!
     //! @param[in] mempool              The mempool to pass to the chainstate
@@ -1361,7 +1419,7 @@ public:
     //! header in our block-index not known to be invalid, recalculate it.
     void RecalculateBestHeader() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
-    CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
+    CCheckQueue<CBlockCheck>& GetCheckQueue() { return m_script_check_queue; }
 
     ~ChainstateManager();
 };
@@ -7,6 +7,8 @@
 
 #include <chain.h>
 #include <consensus/validation.h>
+#include <coordinate/coordinate_assets.h>
+#include <coordinate/coordinate_preconf.h>
 #include <kernel/chain.h>
 #include <kernel/mempool_entry.h>
 #include <kernel/mempool_removal_reason.h>
@@ -236,6 +238,46 @@ void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<Rem
                           txs_removed_for_block.size());
 }
 
+void ValidationSignals::TransactionAddedToPreConfMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence)
+{
+    auto event = [tx, mempool_sequence, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.TransactionAddedToPreConfMempool(tx, mempool_sequence); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s wtxid=%s", __func__,
+                          tx.info.m_tx->GetHash().ToString(),
+                          tx.info.m_tx->GetWitnessHash().ToString());
+}
+
+void ValidationSignals::PreConfSignatureAccepted(const std::vector<CoordinatePreConfSig>& preconf)
+{
+    auto event = [preconf, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.PreConfSignatureAccepted(preconf); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: signatures=%u signed block height=%d", __func__,
+                          preconf.size(),
+                          preconf.empty() ? -1 : preconf[0].blockHeight);
+}
+
+void ValidationSignals::AssetCreated(const CoordinateAsset& asset, const CBlockIndex* pindex)
+{
+    auto event = [asset, pindex, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.AssetCreated(asset, pindex); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: asset txid=%s block height=%d", __func__,
+                          asset.txid.ToString(),
+                          pindex->nHeight);
+}
+
+void ValidationSignals::AssetDisconnected(const CoordinateAsset& asset, const CBlockIndex* pindex)
+{
+    auto event = [asset, pindex, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.AssetDisconnected(asset, pindex); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: asset txid=%s block height=%d", __func__,
+                          asset.txid.ToString(),
+                          pindex->nHeight);
+}
+
 void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
     auto event = [pblock, pindex, this] {
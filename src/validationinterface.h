@@ -26,6 +26,8 @@ class BlockValidationState;
 class CBlock;
 class CBlockIndex;
 struct CBlockLocator;
+struct CoordinateAsset;
+struct CoordinatePreConfSig;
 enum class MemPoolRemovalReason;
 struct RemovedMempoolTransactionInfo;
 struct NewMempoolTransactionInfo;
@@ -114,6 +116,37 @@ protected:
      * Called on a background thread.
      */
     virtual void MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight) {}
+    /**
+     * Notifies listeners of a transaction having been added to the preconf
+     * mempool. Fired in addition to TransactionAddedToMempool, with a
+     * sequence number taken from the preconf mempool.
+     *
+     * Called on a background thread.
+     */
+    virtual void TransactionAddedToPreConfMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence) {}
+    /**
+     * Notifies listeners of federation preconf signatures which passed
+     * witness validation and were added to the preconf signature list.
+     *
+     * Called on a background thread.
+     */
+    virtual void PreConfSignatureAccepted(const std::vector<CoordinatePreConfSig>& preconf) {}
+    /**
+     * Notifies listeners of an asset created or additionally minted by a
+     * connected block. Fired after BlockConnected, once the block is part of
+     * the active chain. The asset carries its updated supply.
+     *
+     * Called on a background thread.
+     */
+    virtual void AssetCreated(const CoordinateAsset& asset, const CBlockIndex* pindex) {}
+    /**
+     * Notifies listeners of an asset created or additionally minted by a
+     * block that was disconnected from the chain. Fired after
+     * BlockDisconnected, mirroring AssetCreated.
+     *
+     * Called on a background thread.
+     */
+    virtual void AssetDisconnected(const CoordinateAsset& asset, const CBlockIndex* pindex) {}
     /**
      * Notifies listeners of a block being connected.
      *
@@ -223,6 +256,10 @@ public:
     void TransactionAddedToMempool(const NewMempoolTransactionInfo&, uint64_t mempool_sequence);
     void TransactionRemovedFromMempool(const CTransactionRef&, MemPoolRemovalReason, uint64_t mempool_sequence);
     void MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>&, unsigned int nBlockHeight);
+    void TransactionAddedToPreConfMempool(const NewMempoolTransactionInfo&, uint64_t mempool_sequence);
+    void PreConfSignatureAccepted(const std::vector<CoordinatePreConfSig>&);
+    void AssetCreated(const CoordinateAsset&, const CBlockIndex* pindex);
+    void AssetDisconnected(const CoordinateAsset&, const CBlockIndex* pindex);
     void BlockConnected(ChainstateRole, const std::shared_ptr<const CBlock> &, const CBlockIndex *pindex);
     void SignBlockConnected(const SignedBlock &pblock);
     void BlockDisconnected(const std::shared_ptr<const CBlock> &, const CBlockIndex* pindex);
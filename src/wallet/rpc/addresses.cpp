@@ -30,15 +30,20 @@ RPCHelpMan getnewaddress()
                     {"label", RPCArg::Type::STR, RPCArg::Default{""}, "The label name for the address to be linked to. It can also be set to the empty string \"\" to represent the default label. The label does not need to exist, it will be created if there is no label by the given name."},
                     {"address_type", RPCArg::Type::STR, RPCArg::DefaultHint{"set by -addresstype"}, "The address type to use. Options are " + FormatAllOutputTypes() + ", \"p2tsh_schnorr\", \"p2tsh_slhdsa\", \"p2tsh_hybrid\"."},
                 },
-                RPCResult{
-                    RPCResult::Type::OBJ, "", "",
-                    {
-                        {RPCResult::Type::STR, "address", "The new bitcoin address"},
-                        {RPCResult::Type::STR, "signature_type", /*optional=*/true, "P2TSH signature type"},
-                        {RPCResult::Type::STR_HEX, "schnorr_pubkey", /*optional=*/true, "Schnorr public key (if applicable)"},
-                        {RPCResult::Type::STR_HEX, "slhdsa_pubkey", /*optional=*/true, "SLH-DSA public key (if applicable)"},
-                        {RPCResult::Type::STR_HEX, "merkle_root", /*optional=*/true, "P2TSH merkle root"},
-                    }
+                RPCResults{
+                    RPCResult{"for standard address types",
+                        RPCResult::Type::STR, "address", "The new bitcoin address"
+                    },
+                    RPCResult{"for P2TSH address types",
+                        RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "address", "The new bitcoin address"},
+                            {RPCResult::Type::STR, "signature_type", /*optional=*/true, "P2TSH signature type"},
+                            {RPCResult::Type::STR_HEX, "schnorr_pubkey", /*optional=*/true, "Schnorr public key (if applicable)"},
+                            {RPCResult::Type::STR_HEX, "slhdsa_pubkey", /*optional=*/true, "SLH-DSA public key (if applicable)"},
+                            {RPCResult::Type::STR_HEX, "merkle_root", /*optional=*/true, "P2TSH merkle root"},
+                        }
+                    },
                 },
                 RPCExamples{
                     HelpExampleCli("getnewaddress", "")
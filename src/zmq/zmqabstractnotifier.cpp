@@ -42,3 +42,33 @@ bool CZMQAbstractNotifier::NotifyTransactionRemoval(const CTransaction &/*transa
 {
     return true;
 }
+
+bool CZMQAbstractNotifier::NotifySignedBlock(const SignedBlock &/*block*/)
+{
+    return true;
+}
+
+bool CZMQAbstractNotifier::NotifyPreConfSignature(const CoordinatePreConfSig &/*preconf*/)
+{
+    return true;
+}
+
+bool CZMQAbstractNotifier::NotifyPreConfTransaction(const CTransaction &/*transaction*/, uint64_t mempool_sequence)
+{
+    return true;
+}
+
+bool CZMQAbstractNotifier::NotifyAssetCreate(const CoordinateAsset &/*asset*/, const CBlockIndex * /*CBlockIndex*/)
+{
+    return true;
+}
+
+bool CZMQAbstractNotifier::NotifyAssetDisconnect(const CoordinateAsset &/*asset*/, const CBlockIndex * /*CBlockIndex*/)
+{
+    return true;
+}
+
+bool CZMQAbstractNotifier::NotifyAssetTransfer(const CTransaction &/*transaction*/, uint64_t mempool_sequence)
+{
+    return true;
+}
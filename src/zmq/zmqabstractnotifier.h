@@ -13,6 +13,9 @@
 class CBlockIndex;
 class CTransaction;
 class CZMQAbstractNotifier;
+class SignedBlock;
+struct CoordinateAsset;
+struct CoordinatePreConfSig;
 
 using CZMQNotifierFactory = std::function<std::unique_ptr<CZMQAbstractNotifier>()>;
 
@@ -56,6 +59,18 @@ public:
     virtual bool NotifyTransactionRemoval(const CTransaction &transaction, uint64_t mempool_sequence);
     // Notifies of transactions added to mempool or appearing in blocks
     virtual bool NotifyTransaction(const CTransaction &transaction);
+    // Notifies of every signed block connected on top of the preconf chain
+    virtual bool NotifySignedBlock(const SignedBlock &block);
+    // Notifies of every federation preconf signature accepted
+    virtual bool NotifyPreConfSignature(const CoordinatePreConfSig &preconf);
+    // Notifies of every preconf mempool acceptance
+    virtual bool NotifyPreConfTransaction(const CTransaction &transaction, uint64_t mempool_sequence);
+    // Notifies of every asset created or minted in a connected block
+    virtual bool NotifyAssetCreate(const CoordinateAsset &asset, const CBlockIndex *pindex);
+    // Notifies of every asset created or minted in a disconnected block
+    virtual bool NotifyAssetDisconnect(const CoordinateAsset &asset, const CBlockIndex *pindex);
+    // Notifies of every asset transfer accepted to the mempool
+    virtual bool NotifyAssetTransfer(const CTransaction &transaction, uint64_t mempool_sequence);
 
 protected:
     void* psocket{nullptr};
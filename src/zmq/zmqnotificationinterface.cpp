@@ -5,6 +5,8 @@
 #include <zmq/zmqnotificationinterface.h>
 
 #include <common/args.h>
+#include <coordinate/coordinate_assets.h>
+#include <coordinate/coordinate_preconf.h>
 #include <kernel/chain.h>
 #include <kernel/mempool_entry.h>
 #include <logging.h>
@@ -50,6 +52,13 @@ std::unique_ptr<CZMQNotificationInterface> CZMQNotificationInterface::Create(std
     };
     factories["pubrawtx"] = CZMQAbstractNotifier::Create<CZMQPublishRawTransactionNotifier>;
     factories["pubsequence"] = CZMQAbstractNotifier::Create<CZMQPublishSequenceNotifier>;
+    factories["pubhashsignedblock"] = CZMQAbstractNotifier::Create<CZMQPublishHashSignedBlockNotifier>;
+    factories["pubrawsignedblock"] = CZMQAbstractNotifier::Create<CZMQPublishRawSignedBlockNotifier>;
+    factories["pubpreconfsig"] = CZMQAbstractNotifier::Create<CZMQPublishPreConfSigNotifier>;
+    factories["pubpreconftx"] = CZMQAbstractNotifier::Create<CZMQPublishPreConfTransactionNotifier>;
+    factories["pubassetcreate"] = CZMQAbstractNotifier::Create<CZMQPublishAssetCreateNotifier>;
+    factories["pubassetdisconnect"] = CZMQAbstractNotifier::Create<CZMQPublishAssetDisconnectNotifier>;
+    factories["pubassettransfer"] = CZMQAbstractNotifier::Create<CZMQPublishAssetTransferNotifier>;
 
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
     for (const auto& entry : factories)
@@ -164,6 +173,44 @@ void CZMQNotificationInterface::TransactionAddedToMempool(const NewMempoolTransa
     TryForEachAndRemoveFailed(notifiers, [&tx, mempool_sequence](CZMQAbstractNotifier* notifier) {
         return notifier->NotifyTransaction(tx) && notifier->NotifyTransactionAcceptance(tx, mempool_sequence);
     });
+
+    if (tx.version == TRANSACTION_COORDINATE_ASSET_TRANSFER_VERSION) {
+        TryForEachAndRemoveFailed(notifiers, [&tx, mempool_sequence](CZMQAbstractNotifier* notifier) {
+            return notifier->NotifyAssetTransfer(tx, mempool_sequence);
+        });
+    }
+}
+
+void CZMQNotificationInterface::TransactionAddedToPreConfMempool(const NewMempoolTransactionInfo& ptx, uint64_t mempool_sequence)
+{
+    const CTransaction& tx = *(ptx.info.m_tx);
+
+    TryForEachAndRemoveFailed(notifiers, [&tx, mempool_sequence](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyPreConfTransaction(tx, mempool_sequence);
+    });
+}
+
+void CZMQNotificationInterface::PreConfSignatureAccepted(const std::vector<CoordinatePreConfSig>& preconf)
+{
+    for (const CoordinatePreConfSig& preconfItem : preconf) {
+        TryForEachAndRemoveFailed(notifiers, [&preconfItem](CZMQAbstractNotifier* notifier) {
+            return notifier->NotifyPreConfSignature(preconfItem);
+        });
+    }
+}
+
+void CZMQNotificationInterface::AssetCreated(const CoordinateAsset& asset, const CBlockIndex* pindex)
+{
+    TryForEachAndRemoveFailed(notifiers, [&asset, pindex](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyAssetCreate(asset, pindex);
+    });
+}
+
+void CZMQNotificationInterface::AssetDisconnected(const CoordinateAsset& asset, const CBlockIndex* pindex)
+{
+    TryForEachAndRemoveFailed(notifiers, [&asset, pindex](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyAssetDisconnect(asset, pindex);
+    });
 }
 
 void CZMQNotificationInterface::TransactionRemovedFromMempool(const CTransactionRef& ptx, MemPoolRemovalReason reason, uint64_t mempool_sequence)
@@ -197,12 +244,11 @@ void CZMQNotificationInterface::BlockConnected(ChainstateRole role, const std::s
 void CZMQNotificationInterface::SignedBlockConnected(const SignedBlock& pblock)
 {
     const CTransaction& tx = *pblock.vtx[0];
-    TryForEachAndRemoveFailed(notifiers, [&tx](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyTransaction(tx);
+    TryForEachAndRemoveFailed(notifiers, [&tx, &pblock](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyTransaction(tx) && notifier->NotifySignedBlock(pblock);
     });
 }
 
-
 void CZMQNotificationInterface::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexDisconnected)
 {
     for (const CTransactionRef& ptx : pblock->vtx) {
@@ -37,6 +37,10 @@ protected:
     void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override;
     void BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected) override;
     void SignedBlockConnected(const SignedBlock& pblock) override;
+    void TransactionAddedToPreConfMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence) override;
+    void PreConfSignatureAccepted(const std::vector<CoordinatePreConfSig>& preconf) override;
+    void AssetCreated(const CoordinateAsset& asset, const CBlockIndex* pindex) override;
+    void AssetDisconnected(const CoordinateAsset& asset, const CBlockIndex* pindex) override;
     void BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexDisconnected) override;
     void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload) override;
 
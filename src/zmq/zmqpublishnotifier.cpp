@@ -6,6 +6,10 @@
 
 #include <chain.h>
 #include <chainparams.h>
+#include <coordinate/coordinate_assets.h>
+#include <coordinate/coordinate_preconf.h>
+#include <coordinate/federation_witness.h>
+#include <coordinate/signed_block.h>
 #include <crypto/common.h>
 #include <kernel/cs_main.h>
 #include <logging.h>
@@ -45,6 +49,13 @@ static const char *MSG_HASHTX    = "hashtx";
 static const char *MSG_RAWBLOCK  = "rawblock";
 static const char *MSG_RAWTX     = "rawtx";
 static const char *MSG_SEQUENCE  = "sequence";
+static const char *MSG_HASHSIGNEDBLOCK = "hashsignedblock";
+static const char *MSG_RAWSIGNEDBLOCK  = "rawsignedblock";
+static const char *MSG_PRECONFSIG      = "preconfsig";
+static const char *MSG_PRECONFTX       = "preconftx";
+static const char *MSG_ASSETCREATE     = "assetcreate";
+static const char *MSG_ASSETDISCONNECT = "assetdisconnect";
+static const char *MSG_ASSETTRANSFER   = "assettransfer";
 
 // Internal function to send multipart message
 static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
@@ -301,3 +312,79 @@ bool CZMQPublishSequenceNotifier::NotifyTransactionRemoval(const CTransaction &t
     LogDebug(BCLog::ZMQ, "Publish hashtx mempool removal %s to %s\n", hash.GetHex(), this->address);
     return SendSequenceMsg(*this, hash, /* Mempool (R)emoval */ 'R', mempool_sequence);
 }
+
+// Helper function to send a raw transaction followed by the 8-byte LE
+// sequence number of the mempool it was accepted to:
+//    <serialized transaction> | <8-byte LE sequence>
+static bool SendSequencedTransactionMsg(CZMQAbstractPublishNotifier& notifier, const char* command, const CTransaction& transaction, uint64_t mempool_sequence)
+{
+    DataStream ss;
+    ss << TX_WITH_WITNESS(transaction);
+    unsigned char seq[sizeof(uint64_t)];
+    WriteLE64(seq, mempool_sequence);
+    ss.write(MakeByteSpan(seq));
+    return notifier.SendZmqMessage(command, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishHashSignedBlockNotifier::NotifySignedBlock(const SignedBlock &block)
+{
+    uint256 hash = block.GetHash();
+    LogDebug(BCLog::ZMQ, "Publish hashsignedblock %s to %s\n", hash.GetHex(), this->address);
+    uint8_t data[32];
+    for (unsigned int i = 0; i < 32; i++) {
+        data[31 - i] = hash.begin()[i];
+    }
+    return SendZmqMessage(MSG_HASHSIGNEDBLOCK, data, 32);
+}
+
+bool CZMQPublishRawSignedBlockNotifier::NotifySignedBlock(const SignedBlock &block)
+{
+    LogDebug(BCLog::ZMQ, "Publish rawsignedblock %s to %s\n", block.GetHash().GetHex(), this->address);
+    DataStream ss;
+    ss << TX_WITH_WITNESS(block);
+    return SendZmqMessage(MSG_RAWSIGNEDBLOCK, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishPreConfSigNotifier::NotifyPreConfSignature(const CoordinatePreConfSig &preconf)
+{
+    LogDebug(BCLog::ZMQ, "Publish preconfsig for signed block height %d to %s\n", preconf.blockHeight, this->address);
+    DataStream ss;
+    ss << FEDERATION_WITNESS_HEX(preconf);
+    return SendZmqMessage(MSG_PRECONFSIG, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishPreConfTransactionNotifier::NotifyPreConfTransaction(const CTransaction &transaction, uint64_t mempool_sequence)
+{
+    LogDebug(BCLog::ZMQ, "Publish preconftx %s to %s\n", transaction.GetHash().GetHex(), this->address);
+    return SendSequencedTransactionMsg(*this, MSG_PRECONFTX, transaction, mempool_sequence);
+}
+
+// Helper function to send an asset topic message with the following structure:
+//    <serialized asset> | <4-byte LE height of the (dis)connected block>
+static bool SendAssetMsg(CZMQAbstractPublishNotifier& notifier, const char* command, const CoordinateAsset& asset, const CBlockIndex* pindex)
+{
+    DataStream ss;
+    ss << asset;
+    unsigned char height[sizeof(uint32_t)];
+    WriteLE32(height, pindex->nHeight);
+    ss.write(MakeByteSpan(height));
+    return notifier.SendZmqMessage(command, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishAssetCreateNotifier::NotifyAssetCreate(const CoordinateAsset &asset, const CBlockIndex *pindex)
+{
+    LogDebug(BCLog::ZMQ, "Publish assetcreate %s to %s\n", asset.txid.GetHex(), this->address);
+    return SendAssetMsg(*this, MSG_ASSETCREATE, asset, pindex);
+}
+
+bool CZMQPublishAssetDisconnectNotifier::NotifyAssetDisconnect(const CoordinateAsset &asset, const CBlockIndex *pindex)
+{
+    LogDebug(BCLog::ZMQ, "Publish assetdisconnect %s to %s\n", asset.txid.GetHex(), this->address);
+    return SendAssetMsg(*this, MSG_ASSETDISCONNECT, asset, pindex);
+}
+
+bool CZMQPublishAssetTransferNotifier::NotifyAssetTransfer(const CTransaction &transaction, uint64_t mempool_sequence)
+{
+    LogDebug(BCLog::ZMQ, "Publish assettransfer %s to %s\n", transaction.GetHash().GetHex(), this->address);
+    return SendSequencedTransactionMsg(*this, MSG_ASSETTRANSFER, transaction, mempool_sequence);
+}
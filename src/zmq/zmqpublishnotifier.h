@@ -72,4 +72,46 @@ public:
     bool NotifyTransactionRemoval(const CTransaction &transaction, uint64_t mempool_sequence) override;
 };
 
+class CZMQPublishHashSignedBlockNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifySignedBlock(const SignedBlock &block) override;
+};
+
+class CZMQPublishRawSignedBlockNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifySignedBlock(const SignedBlock &block) override;
+};
+
+class CZMQPublishPreConfSigNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyPreConfSignature(const CoordinatePreConfSig &preconf) override;
+};
+
+class CZMQPublishPreConfTransactionNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyPreConfTransaction(const CTransaction &transaction, uint64_t mempool_sequence) override;
+};
+
+class CZMQPublishAssetCreateNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyAssetCreate(const CoordinateAsset &asset, const CBlockIndex *pindex) override;
+};
+
+class CZMQPublishAssetDisconnectNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyAssetDisconnect(const CoordinateAsset &asset, const CBlockIndex *pindex) override;
+};
+
+class CZMQPublishAssetTransferNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyAssetTransfer(const CTransaction &transaction, uint64_t mempool_sequence) override;
+};
+
 #endif // BITCOIN_ZMQ_ZMQPUBLISHNOTIFIER_H
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# Copyright (c) 2020-2022 The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the asset index RPCs.
+
+Test that getassetbalance, listassetholders and getassetsupply follow the
+asset outputs created by a block, and that they are rolled back when the
+block is disconnected.
+"""
+
+from test_framework.blocktools import send_precommitments
+from test_framework.messages import COIN
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import (
+    assert_equal,
+    assert_raises_rpc_error,
+)
+from test_framework.wallet_util import fund_wallet_with_pegin
+
+
+class AssetIndexTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 2
+        self.extra_args = [
+            ["-assetindex"],
+            [],
+        ]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_wallet()
+
+    def run_test(self):
+        self._test_index_required()
+        self._test_asset_created()
+        self._test_reorg_index()
+
+    def _test_index_required(self):
+        self.log.info("Test that the asset RPCs require -assetindex")
+        node = self.nodes[1]
+        address = node.get_deterministic_priv_key().address
+        assert_raises_rpc_error(-1, "Asset index not enabled. Restart with -assetindex", node.getassetbalance, 1, 1, address)
+        assert_raises_rpc_error(-1, "Asset index not enabled. Restart with -assetindex", node.listassetholders, 1, 1)
+        assert_raises_rpc_error(-8, "Invalid asset id", node.listassetholders, 1, 1000)
+
+    def _test_asset_created(self):
+        self.log.info("Test that a created asset is indexed")
+        node = self.nodes[0]
+        node.createwallet(wallet_name="assets")
+        self.wallet = node.get_wallet_rpc("assets")
+        fund_wallet_with_pegin(self, node, self.wallet, 1 * COIN)
+
+        self.holder = self.wallet.getnewaddress()
+        self.wallet.createasset(self.holder, 10, {
+            "assettype": 0, "precision": 8, "ticker": "IDX", "headline": "Asset index test", "payloaddata": "assetindex",
+        })
+        send_precommitments(node, 1)
+        self.asset_block = self.generate(node, 1)[0]
+        self.asset_height = node.getblockcount()
+
+        # Output 0 is the controller, output 1 the supply, both held by the given address
+        supply = node.getassetsupply(self.asset_height, 1)
+        assert_equal(supply["height"], self.asset_height)
+        assert_equal(supply["supply"], 10 * COIN)
+        assert_equal(supply["utxos"], 2)
+        assert_equal(supply["issued"], 10 * COIN)
+
+        balance = node.getassetbalance(self.asset_height, 1, self.holder)
+        assert_equal(balance, {"balance": 10 * COIN, "utxos": 2, "controller": True})
+        other = node.getassetbalance(self.asset_height, 1, self.wallet.getnewaddress())
+        assert_equal(other, {"balance": 0, "utxos": 0, "controller": False})
+
+        holders = node.listassetholders(self.asset_height, 1)["holders"]
+        assert_equal(len(holders), 1)
+        assert_equal(holders[0]["address"], self.holder)
+        assert_equal(holders[0]["balance"], 10 * COIN)
+        assert_equal(holders[0]["controller"], True)
+
+        # No asset was created by the next index of the block
+        assert_equal(node.listassetholders(self.asset_height, 2)["holders"], [])
+
+    def _test_reorg_index(self):
+        self.log.info("Test that disconnecting the creating block removes the asset outputs")
+        node = self.nodes[0]
+        node.invalidateblock(self.asset_block)
+        # The index rewinds once a block is connected on the new chain
+        send_precommitments(node, 1)
+        replacement = self.generateblock(node, self.wallet.getnewaddress(), [], sync_fun=self.no_op)["hash"]
+        assert_equal(node.listassetholders(self.asset_height, 1)["holders"], [])
+        assert_equal(node.getassetbalance(self.asset_height, 1, self.holder), {"balance": 0, "utxos": 0, "controller": False})
+
+        self.log.info("Test that reconnecting the block indexes the asset again")
+        node.reconsiderblock(self.asset_block)
+        node.invalidateblock(replacement)
+        assert_equal(node.getbestblockhash(), self.asset_block)
+        assert_equal(node.getassetbalance(self.asset_height, 1, self.holder), {"balance": 10 * COIN, "utxos": 2, "controller": True})
+        assert_equal(node.getassetsupply(self.asset_height, 1)["supply"], 10 * COIN)
+
+
+if __name__ == '__main__':
+    AssetIndexTest(__file__).main()
@@ -456,6 +456,47 @@ class RESTTest (BitcoinTestFramework):
                 assert_equal(expected, actual)
 
 
+        self.log.info("Test the /signedblock and /signedblocks URIs")
+
+        signed_block_count = self.nodes[0].getsignedblockcount()
+        for height in range(1, signed_block_count + 1):
+            expected = self.nodes[0].getfinalizedsignedblocks(1, height, 1)[0]
+            json_obj = self.test_rest_request(f"/signedblock/{height}")
+            assert_equal(json_obj['hash'], expected['hash'])
+            assert_equal(json_obj['height'], height)
+            assert_equal(self.test_rest_request(f"/signedblock/{expected['hash']}")['hash'], expected['hash'])
+            block_bin = self.test_rest_request(f"/signedblock/{height}", req_type=ReqType.BIN, ret_type=RetType.BYTES)
+            block_hex = self.test_rest_request(f"/signedblock/{height}", req_type=ReqType.HEX, ret_type=RetType.BYTES)
+            assert_equal(bytes.fromhex(block_hex.decode()), block_bin)
+        if signed_block_count > 0:
+            json_obj = self.test_rest_request(f"/signedblocks/{signed_block_count}/1")
+            assert_equal([b['height'] for b in json_obj], list(range(1, signed_block_count + 1)))
+
+        resp = self.test_rest_request(f"/signedblock/{signed_block_count + 1}", ret_type=RetType.OBJ, status=404)
+        assert_equal(resp.read().decode('utf-8').rstrip(), f"{signed_block_count + 1} not found")
+        resp = self.test_rest_request(f"/signedblock/{INVALID_PARAM}", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), f"Invalid hash or height: {INVALID_PARAM}")
+        resp = self.test_rest_request("/signedblocks/0/1", ret_type=RetType.OBJ, status=400)
+        assert resp.read().decode('utf-8').startswith("Signed block count is out of acceptable range")
+        assert_equal(self.test_rest_request(f"/signedblocks/1/{signed_block_count + 1}"), [])
+
+        self.log.info("Test the /preconfmempool URI")
+
+        assert_equal(self.test_rest_request("/preconfmempool/contents"), self.nodes[0].getrawpreconfmempool(True))
+        assert_equal(self.test_rest_request("/preconfmempool/contents", query_params={"verbose": "false"}), self.nodes[0].getrawpreconfmempool(False))
+        resp = self.test_rest_request("/preconfmempool/info", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Invalid URI format. Expected /rest/preconfmempool/contents.<ext>")
+
+        self.log.info("Test the /assetutxos URI")
+
+        # Without -assetindex the utxo set is never scanned on behalf of a REST client
+        resp = self.test_rest_request("/assetutxos/1/0", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Asset index is not enabled (start with -assetindex)")
+        resp = self.test_rest_request(f"/assetutxos/1/{INVALID_PARAM}", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), f"Invalid asset id: 1/{INVALID_PARAM}")
+        resp = self.test_rest_request(f"/assetutxos/{INVALID_PARAM}", ret_type=RetType.OBJ, status=400)
+        assert_equal(resp.read().decode('utf-8').rstrip(), "Invalid URI format. Expected /rest/assetutxos/<blockheight>/<index>.<ext>")
+
         self.log.info("Test the /deploymentinfo URI")
 
         deployment_info = self.nodes[0].getdeploymentinfo()
@@ -92,6 +92,7 @@ class RPCInterfaceTest(BitcoinTestFramework):
     def set_test_params(self):
         self.num_nodes = 1
         self.setup_clean_chain = True
+        self.extra_args = [["-rpcbatchthreads=4"]]
         self.supports_cli = False
 
     def test_getrpcinfo(self):
@@ -177,6 +178,48 @@ class RPCInterfaceTest(BitcoinTestFramework):
             request_fields={"jsonrpc": "2.1"},
             response_fields={"result": None, "error": {"code": RPC_INVALID_REQUEST, "message": "JSON-RPC version not supported"}}))
 
+        self.log.info("Testing large batch request keeps the order of the responses...")
+        request = [{"jsonrpc": "2.0", "id": idx, "method": "getblockhash", "params": [0 if idx % 2 else 1]} for idx in range(200)]
+        rpc_response, http_status = send_json_rpc(self.nodes[0], request)
+        assert_equal(http_status, 200)
+        assert_equal([r["id"] for r in rpc_response], list(range(200)))
+        for r in rpc_response:
+            if r["id"] % 2:
+                assert_equal(r["result"], self.nodes[0].getblockhash(0))
+            else:
+                assert_equal(r["error"]["code"], RPC_INVALID_PARAMETER)
+
+    def test_streamed_results(self):
+        self.log.info("Testing results written incrementally match those in batch replies...")
+        node = self.nodes[0]
+        calls = [
+            ("getblock", [node.getblockhash(0), 2]),
+            ("getblock", [node.getblockhash(0), 3]),
+            ("getrawmempool", [False]),
+            ("getrawmempool", [True]),
+            ("getrawmempool", [False, True]),
+        ]
+        for version in [1, 2]:
+            for idx, (method, params) in enumerate(calls):
+                request = format_request(BatchOptions(version), idx, {"method": method, "params": params})
+                single, status = send_json_rpc(node, request)
+                assert_equal(status, 200)
+                batch, status = send_json_rpc(node, [request])
+                assert_equal(status, 200)
+                assert_equal(single, batch[0])
+        response, status = send_json_rpc(node, format_request(BatchOptions(2), 0, {"method": "getrawmempool", "params": [True, True]}))
+        assert_equal(status, 200)
+        assert_equal(response["error"]["code"], RPC_INVALID_PARAMETER)
+
+    def test_method_latency(self):
+        self.log.info("Testing getrpcinfo method latency histogram...")
+        latency = self.nodes[0].getrpcinfo()['method_latency']
+        assert_greater_than_or_equal(latency['getblockhash']['count'], 200)
+        for entry in latency.values():
+            assert_equal(sum(bucket['count'] for bucket in entry['histogram']), entry['count'])
+            assert_greater_than_or_equal(entry['total'], 0)
+            assert 'le' not in entry['histogram'][-1]
+
     def test_http_status_codes(self):
         self.log.info("Testing HTTP status codes for JSON-RPC 1.1 requests...")
         # OK
@@ -241,6 +284,8 @@ class RPCInterfaceTest(BitcoinTestFramework):
     def run_test(self):
         self.test_getrpcinfo()
         self.test_batch_requests()
+        self.test_streamed_results()
+        self.test_method_latency()
         self.test_http_status_codes()
         self.test_work_queue_exceeded()
 
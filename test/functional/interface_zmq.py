@@ -16,9 +16,11 @@ from test_framework.blocktools import (
     add_witness_commitment,
     create_block,
     create_coinbase,
+    send_precommitments,
 )
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.messages import (
+    COIN,
     CBlock,
     hash256,
     tx_from_hex,
@@ -32,6 +34,7 @@ from test_framework.util import (
 from test_framework.wallet import (
     MiniWallet,
 )
+from test_framework.wallet_util import fund_wallet_with_pegin
 from test_framework.netutil import test_ipv6_local, test_unix_socket
 
 
@@ -127,6 +130,7 @@ class ZMQTest (BitcoinTestFramework):
                 self.log.info("Skipping ipc test, because UNIX sockets are not supported.")
             self.test_sequence()
             self.test_mempool_sync()
+            self.test_asset()
             self.test_reorg()
             self.test_multiple_interfaces()
             self.test_ipv6()
@@ -137,7 +141,7 @@ class ZMQTest (BitcoinTestFramework):
 
     # Restart node with the specified zmq notifications enabled, subscribe to
     # all of them and return the corresponding ZMQSubscriber objects.
-    def setup_zmq_test(self, services, *, recv_timeout=60, sync_blocks=True, ipv6=False):
+    def setup_zmq_test(self, services, *, recv_timeout=60, sync_blocks=True, ipv6=False, idle_topics=()):
         subscribers = []
         for topic, address in services:
             socket = self.ctx.socket(zmq.SUB)
@@ -156,12 +160,15 @@ class ZMQTest (BitcoinTestFramework):
         #   2. Try to receive the corresponding notification on all subscribers
         #   3. If all subscribers get the message within the timeout (1 second),
         #      we are done, otherwise repeat starting from step 1
-        for sub in subscribers:
+        # Topics in idle_topics are not published for an empty block, so they
+        # are left out of the procedure.
+        sync_subscribers = [sub for sub in subscribers if sub.topic.decode() not in idle_topics]
+        for sub in sync_subscribers:
             sub.socket.set(zmq.RCVTIMEO, 1000)
         while True:
             test_block = ZMQTestSetupBlock(self, self.nodes[0])
             recv_failed = False
-            for sub in subscribers:
+            for sub in sync_subscribers:
                 try:
                     while not test_block.caused_notification(sub.receive().hex()):
                         self.log.debug("Ignoring sync-up notification for previously generated block.")
@@ -262,6 +269,47 @@ class ZMQTest (BitcoinTestFramework):
         if unix:
             os.unlink(socket_path)
 
+    def test_asset(self):
+        if not self.is_wallet_compiled():
+            self.log.info("Skipping asset test, because the wallet is not compiled.")
+            return
+        self.log.info("Testing 'assetcreate' and 'assetdisconnect' publishers")
+        address = f"tcp://127.0.0.1:{self.zmq_port_base}"
+        hashblock, assetcreate, assetdisconnect = self.setup_zmq_test(
+            [(topic, address) for topic in ["hashblock", "assetcreate", "assetdisconnect"]],
+            idle_topics=("assetcreate", "assetdisconnect"))
+
+        self.nodes[0].createwallet(wallet_name="zmq_asset")
+        wallet = self.nodes[0].get_wallet_rpc("zmq_asset")
+        # The peg-in block and the block spending it to the wallet
+        fund_wallet_with_pegin(self, self.nodes[0], wallet, 1 * COIN)
+        for _ in range(2):
+            hashblock.receive()
+
+        asset_txid = wallet.createasset(wallet.getnewaddress(), 1000, {
+            "assettype": 0, "precision": 8, "ticker": "ZMQ", "headline": "ZMQ test asset", "payloaddata": "zmq",
+        })
+        send_precommitments(self.nodes[0], 1)
+        asset_block = self.generatetoaddress(self.nodes[0], 1, ADDRESS_BCRT1_UNSPENDABLE)[0]
+        asset_height = self.nodes[0].getblockcount()
+
+        def check_asset_msg(body):
+            # <serialized asset><4-byte LE height>, the asset records its creation txid
+            assert bytes.fromhex(asset_txid)[::-1] in body[:-4]
+            assert_equal(struct.unpack("<I", body[-4:])[0], asset_height)
+
+        # The asset is only announced once its block is part of the chain
+        assert_equal(hashblock.receive().hex(), asset_block)
+        check_asset_msg(assetcreate.receive())
+
+        self.log.info("Test that a reorg announces the disconnected asset")
+        self.nodes[0].invalidateblock(asset_block)
+        check_asset_msg(assetdisconnect.receive())
+        self.nodes[0].reconsiderblock(asset_block)
+        assert_equal(hashblock.receive().hex(), asset_block)
+        check_asset_msg(assetcreate.receive())
+        self.sync_all()
+
     def test_reorg(self):
 
         address = f"tcp://127.0.0.1:{self.zmq_port_base}"
@@ -24,10 +24,13 @@ from .messages import (
     CTxInWitness,
     CTxOut,
     SEQUENCE_FINAL,
+    from_hex,
     hash256,
+    ser_compact_size,
     ser_uint256,
     tx_from_hex,
     uint256_from_compact,
+    uint256_from_str,
     WITNESS_SCALE_FACTOR,
     MAX_SEQUENCE_NONFINAL,
 )
@@ -38,6 +41,7 @@ from .script import (
     OP_0,
     OP_RETURN,
     OP_TRUE,
+    hash160,
 )
 from .script_util import (
     key_to_p2pk_script,
@@ -67,6 +71,10 @@ NORMAL_GBT_REQUEST_PARAMS = {"rules": ["segwit"]}
 VERSIONBITS_LAST_OLD_BLOCK_VERSION = 4
 MIN_BLOCKS_TO_KEEP = 288
 
+# Peg-in transactions (src/primitives/transaction.h) and their fee per virtual byte (src/coordinate/coordinate_pegin.h)
+TRANSACTION_PEGIN_VERSION = 12
+PEGIN_FEE = 10
+
 REGTEST_RETARGET_PERIOD = 150
 
 REGTEST_N_BITS = 0x207fffff  # difficulty retargeting is disabled in REGTEST chainparams"
@@ -175,6 +183,76 @@ def create_coinbase(height, pubkey=None, *, script_pubkey=None, extra_output_scr
         coinbase.vout.append(coinbaseoutput2)
     return coinbase
 
+def send_precommitments(node, nblocks):
+    """Queue placeholder precommitments so that node can mine its next nblocks blocks.
+
+    The miner only builds blocks above height 2 on top of a pending federation
+    precommitment. On regtest these are accepted without a witness check."""
+    height = node.getblockcount()
+    for block_height in range(height + 1, height + nblocks + 1):
+        node.sendprecommitment([{
+            "witness": "",
+            "block_height": block_height,
+            "deposit_address": "",
+            "burn_address": "",
+            "nextkeys": "",
+            "nextindex": 0,
+        }])
+
+
+def create_pegin(script_pubkey, amount, *, nonce=0):
+    """Return a peg-in transaction paying amount, less the peg-in fee, to script_pubkey.
+
+    It claims a deposit to a federation address, alone in a parent chain block
+    that meets the regtest parent proof of work limit. The nonce keeps the
+    deposits of different peg-ins apart."""
+    federation_script = CScript([OP_0, hash160(b"federation")])
+
+    # The deposit is serialized in the parent chain's transaction format
+    deposit = (2).to_bytes(4, "little")
+    deposit += ser_compact_size(1) + bytes(32) + (0xffffffff).to_bytes(4, "little") + ser_compact_size(0) + SEQUENCE_FINAL.to_bytes(4, "little")
+    deposit += ser_compact_size(1) + amount.to_bytes(8, "little") + ser_compact_size(len(federation_script)) + bytes(federation_script)
+    deposit += nonce.to_bytes(4, "little")
+    deposit_txid = hash256(deposit)
+
+    parent_bits = 0x207fffff
+    parent_header = (4).to_bytes(4, "little") + bytes(32) + deposit_txid + int(time.time()).to_bytes(4, "little") + parent_bits.to_bytes(4, "little")
+    parent_nonce = 0
+    while uint256_from_str(hash256(parent_header + parent_nonce.to_bytes(4, "little"))) > uint256_from_compact(parent_bits):
+        parent_nonce += 1
+    parent_header += parent_nonce.to_bytes(4, "little")
+    # A merkle block proving the only transaction in the parent block
+    proof = parent_header + (1).to_bytes(4, "little") + ser_compact_size(1) + deposit_txid + ser_compact_size(1) + b"\x01"
+
+    pegin = CTransaction()
+    pegin.version = TRANSACTION_PEGIN_VERSION
+    pegin.vin = [CTxIn(COutPoint(int.from_bytes(deposit_txid, "little"), 0))]
+    pegin.vout = [CTxOut(amount, script_pubkey), CTxOut(0, script_pubkey)]
+    pegin.wit.vtxinwit = [CTxInWitness()]
+    pegin.wit.vtxinwit[0].scriptWitness.stack = [bytes(federation_script), bytes(script_pubkey), amount.to_bytes(8, "little"), deposit, proof]
+    fee = pegin.get_vsize() * PEGIN_FEE
+    pegin.vout[0].nValue -= fee
+    pegin.vout[1].nValue = fee
+    return pegin
+
+
+def mine_pegins(test, node, address, pegins):
+    """Mine a block on node paying its coinbase to address and carrying pegins.
+
+    The miner does not include peg-ins, so they are added to its block before it
+    is submitted. Its auxpow stays valid, regtest does not check what the parent
+    block commits to. A precommitment for the block must already be pending."""
+    block = from_hex(CBlock(), test.generateblock(node, address, [], False, sync_fun=test.no_op)["hex"])
+    block.pegins.extend(pegins)
+    coinbase = block.vtx[0]
+    commitment = next(i for i, out in enumerate(coinbase.vout) if bytes(out.scriptPubKey).startswith(bytes([OP_RETURN, 0x24]) + WITNESS_COMMITMENT_HEADER))
+    coinbase.vout[commitment].scriptPubKey = get_witness_script(block.calc_witness_merkle_root(), 0)
+    block.hashMerkleRoot = block.calc_merkle_root()
+    assert_equal(node.submitblock(block.serialize().hex()), None)
+    test.sync_all()
+    return block.hash_hex
+
+
 def create_tx_with_script(prevtx, n, script_sig=b"", *, amount, output_script=None):
     """Return one-input, one-output transaction object
        spending the prevtx's n-th output with the given amount.
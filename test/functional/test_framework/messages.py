@@ -89,6 +89,9 @@ MAGIC_BYTES = {
 }
 
 VERSION_AUXPOW = (1 << 8)
+
+# Transactions of this version carry the asset fields (src/primitives/transaction.h)
+TRANSACTION_COORDINATE_ASSET_CREATE_VERSION = 10
 VERSION_CHAIN_START = (1 << 16)
 CHAIN_ID = 2222
 
@@ -638,22 +641,24 @@ class CTransaction:
 
     def deserialize(self, f):
         self.version = int.from_bytes(f.read(4), "little")
-        self.assetType = int.from_bytes(f.read(4), "little")
-        self.precision = int.from_bytes(f.read(4), "little")
+        # Only asset creations carry the asset fields
+        if self.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION:
+            self.assetType = int.from_bytes(f.read(4), "little")
+            self.precision = int.from_bytes(f.read(4), "little")
 
-        # ticker and headline as length-prefixed strings
-        ticker_len = int.from_bytes(f.read(1), "little")
-        self.ticker = f.read(ticker_len).decode("utf-8") if ticker_len > 0 else ""
+            # ticker and headline as length-prefixed strings
+            ticker_len = int.from_bytes(f.read(1), "little")
+            self.ticker = f.read(ticker_len).decode("utf-8") if ticker_len > 0 else ""
 
-        headline_len = int.from_bytes(f.read(1), "little")
-        self.headline = f.read(headline_len).decode("utf-8") if headline_len > 0 else ""
+            headline_len = int.from_bytes(f.read(1), "little")
+            self.headline = f.read(headline_len).decode("utf-8") if headline_len > 0 else ""
 
-        # payload as uint256
-        self.payload = deser_uint256(f)
+            # payload as uint256
+            self.payload = deser_uint256(f)
 
-        # payloadData as length-prefixed string
-        data_len = int.from_bytes(f.read(1), "little")
-        self.payloadData = f.read(data_len).decode("utf-8") if data_len > 0 else ""
+            # payloadData as length-prefixed string
+            data_len = int.from_bytes(f.read(1), "little")
+            self.payloadData = f.read(data_len).decode("utf-8") if data_len > 0 else ""
 
         self.vin = deser_vector(f, CTxIn)
         flags = 0
@@ -676,22 +681,23 @@ class CTransaction:
     def serialize_without_witness(self):
         r = b""
         r += self.version.to_bytes(4, "little")
-        r += self.assetType.to_bytes(4, "little")
-        r += self.precision.to_bytes(4, "little")
-
-        # serialize strings with length prefix
-        r += len(self.ticker.encode()).to_bytes(1, "little")
-        r += self.ticker.encode()
-        r += len(self.headline.encode()).to_bytes(1, "little")
-        r += self.headline.encode()
-
-        # payload
-        r += ser_uint256(self.payload)
-
-        # payloadData
-        data_bytes = self.payloadData.encode()
-        r += len(data_bytes).to_bytes(1, "little")
-        r += data_bytes
+        if self.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION:
+            r += self.assetType.to_bytes(4, "little")
+            r += self.precision.to_bytes(4, "little")
+
+            # serialize strings with length prefix
+            r += len(self.ticker.encode()).to_bytes(1, "little")
+            r += self.ticker.encode()
+            r += len(self.headline.encode()).to_bytes(1, "little")
+            r += self.headline.encode()
+
+            # payload
+            r += ser_uint256(self.payload)
+
+            # payloadData
+            data_bytes = self.payloadData.encode()
+            r += len(data_bytes).to_bytes(1, "little")
+            r += data_bytes
         r += ser_vector(self.vin)
         r += ser_vector(self.vout)
         r += self.nLockTime.to_bytes(4, "little")
@@ -704,18 +710,19 @@ class CTransaction:
             flags |= 1
         r = b""
         r += self.version.to_bytes(4, "little")
-        r += self.assetType.to_bytes(4, "little")
-        r += self.precision.to_bytes(4, "little")
-
-        r += len(self.ticker.encode()).to_bytes(1, "little")
-        r += self.ticker.encode()
-        r += len(self.headline.encode()).to_bytes(1, "little")
-        r += self.headline.encode()
-        r += ser_uint256(self.payload)
-
-        data_bytes = self.payloadData.encode()
-        r += len(data_bytes).to_bytes(1, "little")
-        r += data_bytes
+        if self.version == TRANSACTION_COORDINATE_ASSET_CREATE_VERSION:
+            r += self.assetType.to_bytes(4, "little")
+            r += self.precision.to_bytes(4, "little")
+
+            r += len(self.ticker.encode()).to_bytes(1, "little")
+            r += self.ticker.encode()
+            r += len(self.headline.encode()).to_bytes(1, "little")
+            r += self.headline.encode()
+            r += ser_uint256(self.payload)
+
+            data_bytes = self.payloadData.encode()
+            r += len(data_bytes).to_bytes(1, "little")
+            r += data_bytes
         if flags:
             dummy = []
             r += ser_vector(dummy)
@@ -777,12 +784,40 @@ class CTransaction:
         return "CTransaction(version=%i vin=%s vout=%s wit=%s nLockTime=%i)" \
             % (self.version, repr(self.vin), repr(self.vout), repr(self.wit), self.nLockTime)
 
-class CAuxPow(CTransaction):
-    __slots__ = ("hashBlock", "vMerkleBranch", "nIndex",
+def deser_parent_tx(f):
+    """Read a transaction in the parent chain's format and return its raw bytes.
+
+    Unlike in CTransaction, its outpoints carry no asset id."""
+    start = f.tell()
+    f.read(4)  # version
+    n_in = deser_compact_size(f)
+    has_witness = n_in == 0
+    if has_witness:
+        f.read(1)  # flags
+        n_in = deser_compact_size(f)
+    for _ in range(n_in):
+        f.read(36)  # prevout
+        deser_string(f)  # scriptSig
+        f.read(4)  # sequence
+    for _ in range(deser_compact_size(f)):
+        f.read(8)  # value
+        deser_string(f)  # scriptPubKey
+    if has_witness:
+        for _ in range(n_in):
+            deser_string_vector(f)
+    f.read(4)  # locktime
+    end = f.tell()
+    f.seek(start)
+    return f.read(end - start)
+
+
+class CAuxPow:
+    __slots__ = ("coinbaseTx", "hashBlock", "vMerkleBranch", "nIndex",
                  "vChainMerkleBranch", "nChainIndex", "parentBlock")
 
     def __init__(self):
-        super(CAuxPow, self).__init__()
+        # The parent chain coinbase, kept serialized
+        self.coinbaseTx = b""
         self.hashBlock = 0
         self.vMerkleBranch = []
         self.nIndex = 0
@@ -791,7 +826,7 @@ class CAuxPow(CTransaction):
         self.parentBlock = CBlockHeader()
 
     def deserialize(self, f):
-        super(CAuxPow, self).deserialize(f)
+        self.coinbaseTx = deser_parent_tx(f)
         self.hashBlock = deser_uint256(f)
         self.vMerkleBranch = deser_uint256_vector(f)
         self.nIndex = int.from_bytes(f.read(4), "little")
@@ -801,7 +836,7 @@ class CAuxPow(CTransaction):
 
     def serialize(self):
         r = b""
-        r += super(CAuxPow, self).serialize()
+        r += self.coinbaseTx
         r += ser_uint256(self.hashBlock)
         r += ser_uint256_vector(self.vMerkleBranch)
         r += self.nIndex.to_bytes(4, "little")
@@ -1052,7 +1087,8 @@ class CBlock(CBlockHeader):
         self.vtx = deser_vector(f, CTransaction)
         self.pegins = deser_vector(f, CTransaction)
         self.preconfBlock = deser_vector(f, SignedBlock)
-        self.reconciliationBlock = ReconciliationBlock().deserialize(f)
+        self.reconciliationBlock = ReconciliationBlock()
+        self.reconciliationBlock.deserialize(f)
         self.currentKeys = deser_string(f)
         self.currentIndex = struct.unpack("<i", f.read(4))[0]
 
@@ -1091,16 +1127,16 @@ class CBlock(CBlockHeader):
             preconfTxLeaves = [b"\x00" * 32] * len(sb.vtx)  # coinbase witness = 0
             for i in range(1, len(sb.vtx)):
                 preconfTxLeaves[i] = ser_uint256(sb.vtx[i].txid_int)
-            preconfBlockLeaves.append(self.get_merkle_root(preconfTxLeaves))
-        leaves[0] = self.get_merkle_root(preconfBlockLeaves) if preconfBlockLeaves else b"\x00" * 32
+            preconfBlockLeaves.append(ser_uint256(self.get_merkle_root(preconfTxLeaves)))
+        leaves[0] = ser_uint256(self.get_merkle_root(preconfBlockLeaves)) if preconfBlockLeaves else b"\x00" * 32
 
         # --- normal transactions ---
         txLeaves = [ser_uint256(tx.txid_int) for tx in self.vtx]
-        leaves[1] = self.get_merkle_root(txLeaves) if txLeaves else b"\x00" * 32
+        leaves[1] = ser_uint256(self.get_merkle_root(txLeaves)) if txLeaves else b"\x00" * 32
 
         # --- peg-in transactions ---
         peginLeaves = [ser_uint256(tx.txid_int) for tx in self.pegins]
-        leaves[2] = self.get_merkle_root(peginLeaves) if peginLeaves else b"\x00" * 32
+        leaves[2] = ser_uint256(self.get_merkle_root(peginLeaves)) if peginLeaves else b"\x00" * 32
 
         # --- invalid transactions from reconciliationBlock ---
         nTx = self.reconciliationBlock.nTx
@@ -1111,7 +1147,7 @@ class CBlock(CBlockHeader):
                 invalidTxLeaves.append(b"\x00" * 32)
             else:
                 invalidTxLeaves.append(ser_uint256(found))
-        leaves[3] = self.get_merkle_root(invalidTxLeaves) if invalidTxLeaves else b"\x00" * 32
+        leaves[3] = ser_uint256(self.get_merkle_root(invalidTxLeaves)) if invalidTxLeaves else b"\x00" * 32
 
         # final block merkle root
         return self.get_merkle_root(leaves)
@@ -1126,18 +1162,18 @@ class CBlock(CBlockHeader):
             preconfTxLeaves = [b"\x00" * 32] * len(sb.vtx)  # coinbase witness = 0
             for i in range(1, len(sb.vtx)):
                 preconfTxLeaves[i] = ser_uint256(sb.vtx[i].wtxid_int)
-            preconfBlockLeaves.append(self.get_merkle_root(preconfTxLeaves))
-        leaves[0] = self.get_merkle_root(preconfBlockLeaves) if preconfBlockLeaves else b"\x00" * 32
+            preconfBlockLeaves.append(ser_uint256(self.get_merkle_root(preconfTxLeaves)))
+        leaves[0] = ser_uint256(self.get_merkle_root(preconfBlockLeaves)) if preconfBlockLeaves else b"\x00" * 32
 
         # --- normal transactions witness merkle root ---
         txLeaves = [b"\x00" * 32] * len(self.vtx)
         for i in range(1, len(self.vtx)):
             txLeaves[i] = ser_uint256(self.vtx[i].wtxid_int)
-        leaves[1] = self.get_merkle_root(txLeaves) if txLeaves else b"\x00" * 32
+        leaves[1] = ser_uint256(self.get_merkle_root(txLeaves)) if txLeaves else b"\x00" * 32
 
         # --- peg-in transactions witness merkle root ---
         peginLeaves = [ser_uint256(tx.wtxid_int) for tx in self.pegins]
-        leaves[2] = self.get_merkle_root(peginLeaves) if peginLeaves else b"\x00" * 32
+        leaves[2] = ser_uint256(self.get_merkle_root(peginLeaves)) if peginLeaves else b"\x00" * 32
 
         # --- invalid transactions from reconciliationBlock ---
         nTx = self.reconciliationBlock.nTx
@@ -1148,7 +1184,7 @@ class CBlock(CBlockHeader):
                 invalidTxLeaves.append(b"\x00" * 32)
             else:
                 invalidTxLeaves.append(ser_uint256(found))
-        leaves[3] = self.get_merkle_root(invalidTxLeaves) if invalidTxLeaves else b"\x00" * 32
+        leaves[3] = ser_uint256(self.get_merkle_root(invalidTxLeaves)) if invalidTxLeaves else b"\x00" * 32
 
         # final block witness merkle root
         return self.get_merkle_root(leaves)
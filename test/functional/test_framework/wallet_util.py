@@ -4,9 +4,11 @@
 # file COPYING or http://www.opensource.org/licenses/mit-license.php.
 """Useful util functions for testing the wallet"""
 from collections import namedtuple
+from decimal import Decimal
 import unittest
 
 from test_framework.address import (
+    address_to_scriptpubkey,
     byte_to_base58,
     key_to_p2pkh,
     key_to_p2sh_p2wpkh,
@@ -15,8 +17,14 @@ from test_framework.address import (
     script_to_p2sh_p2wsh,
     script_to_p2wsh,
 )
+from test_framework.blocktools import (
+    create_pegin,
+    mine_pegins,
+    send_precommitments,
+)
 from test_framework.key import ECKey
 from test_framework.messages import (
+    COIN,
     CTxIn,
     CTxInWitness,
     WITNESS_SCALE_FACTOR,
@@ -102,6 +110,27 @@ def get_multisig(node):
                     p2sh_p2wsh_script=script_to_p2sh_script(witness_script).hex(),
                     p2sh_p2wsh_addr=script_to_p2sh_p2wsh(script_code))
 
+def fund_wallet_with_pegin(test, node, wallet, amount):
+    """Fund wallet on node with amount in satoshis, less fees.
+
+    Regtest coinbases carry no value, so the coins are pegged in. The wallet does
+    not track peg-ins, so their output is then spent to the wallet in a block of
+    its own. Returns that transaction's id."""
+    send_precommitments(node, 2)
+    address = wallet.getnewaddress()
+    pegin = create_pegin(address_to_scriptpubkey(address), amount)
+    mine_pegins(test, node, address, [pegin])
+
+    # Transactions need at least two outputs
+    value = Decimal(pegin.vout[0].nValue) / COIN
+    fee = Decimal("0.0001")
+    prevtx = {"txid": pegin.txid_hex, "vout": 0, "scriptPubKey": pegin.vout[0].scriptPubKey.hex(), "amount": value}
+    raw = wallet.createrawtransaction([prevtx], [{wallet.getnewaddress(): value - fee - Decimal("0.001")}, {wallet.getnewaddress(): Decimal("0.001")}])
+    txid = node.sendrawtransaction(wallet.signrawtransactionwithwallet(raw, [prevtx])["hex"])
+    test.generate(node, 1)
+    return txid
+
+
 def test_address(node, address, **kwargs):
     """Get address info for `address` and test whether the returned values are as expected."""
     addr_info = node.getaddressinfo(address)